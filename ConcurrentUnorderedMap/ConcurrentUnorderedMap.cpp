@@ -0,0 +1,524 @@
+#include "ConcurrentUnorderedMap.h"
+
+#include<thread>
+
+// ---------------------------- 内部工具 ----------------------------
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+void ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::cpu_relax()
+{
+#if defined(__SSE2__) || defined(_M_X64)
+    _mm_pause();
+#endif
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+typename ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::size_type
+ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::find_index(const Table* t, const Key& key, std::size_t hash) const
+{
+    return HashProbe::find(t->ctrl, t->capacity, hash, [&](size_type i) { return key_equal(t->nodes[i].data.first, key); });
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+bool ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::optimistic_find(const Table* t, const Key& key, std::size_t hash, void* out) const
+{
+    if(t == nullptr)
+        return false;
+
+    size_type i = HashProbe::find(t->ctrl, t->capacity, hash, [&](size_type i)
+    {
+        // 先把 key 拷出来再比较 比较的始终是一个完整的 Key 对象
+        alignas(Key) unsigned char key_copy[sizeof(Key)];
+        std::memcpy(key_copy, &t->nodes[i].data.first, sizeof(Key));
+        return key_equal(*reinterpret_cast<const Key*>(key_copy), key);
+    });
+    if(i == t->capacity)
+        return false;
+    // 与比较 key 时不是同一次读 撕裂与否都由调用者的版本号校验兜底
+    std::memcpy(out, &t->nodes[i].data.second, sizeof(Value));
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+typename ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::Table*
+ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::allocate_table(size_type capacity)
+{
+    Table* t = table_allocator.allocate(1);
+    try
+    {
+        t->nodes = allocator.allocate(capacity);
+        try
+        {
+            t->ctrl = ctrl_allocator.allocate(capacity + HashGroup::width);
+        }
+        catch(...)
+        {
+            allocator.deallocate(t->nodes, capacity);
+            throw;
+        }
+    }
+    catch(...)
+    {
+        table_allocator.deallocate(t, 1);
+        throw;
+    }
+    std::memset(t->ctrl, HashCtrl::Empty, capacity + HashGroup::width);
+    t->capacity = capacity;
+    t->next_retired = nullptr;
+    return t;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+void ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::free_table(Table* t)
+{
+    allocator.deallocate(t->nodes, t->capacity);
+    ctrl_allocator.deallocate(t->ctrl, t->capacity + HashGroup::width);
+    table_allocator.deallocate(t, 1);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+void ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::destroy_table(Table* t)
+{
+    if(!std::is_trivially_destructible<value_type>::value)
+    {
+        for(size_type i = 0;i<t->capacity;++i)
+            if(HashCtrl::is_full(t->ctrl[i]))
+                allocator.destroy(&t->nodes[i].data);
+    }
+    free_table(t);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+void ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::rebuild_in_place(Shard& shard, Table* t)
+{
+    size_type size = shard.size.load(std::memory_order_relaxed);
+    // 先把存活结点和它们的 hash 存到临时缓冲区 申请或 hash_of 抛异常时表不变
+    // 持有写锁 没有其他写者 读者只读不写 这一步不需要版本号保护
+    node_type* live = size ? allocator.allocate(size) : nullptr;
+    std::unique_ptr<std::size_t[]> hashes;
+    try
+    {
+        hashes.reset(new std::size_t[size]);
+        size_type n = 0;
+        for(size_type i = 0;i<t->capacity;++i)
+        {
+            if(!HashCtrl::is_full(t->ctrl[i]))
+                continue;
+            hashes[n] = hash_of(t->nodes[i].data.first);
+            std::memcpy(static_cast<void*>(&live[n++]), static_cast<const void*>(&t->nodes[i]), sizeof(node_type));
+        }
+    }
+    catch(...)
+    {
+        if(live)
+            allocator.deallocate(live, size);
+        throw;
+    }
+    {
+        WriteGuard guard(shard);
+        std::memset(t->ctrl, HashCtrl::Empty, t->capacity + HashGroup::width);
+        for(size_type k = 0;k<size;++k)
+        {
+            size_type j = find_first_non_full(t, hashes[k]);
+            set_ctrl(t, j, h2(hashes[k]));
+            std::memcpy(static_cast<void*>(&t->nodes[j]), static_cast<const void*>(&live[k]), sizeof(node_type));
+        }
+        shard.growth_left = max_load(t->capacity) - size;
+    }
+    if(live)
+        allocator.deallocate(live, size);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+void ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::fill_table(Table* t, Table* old, size_type size)
+{
+    if constexpr(optimistic_reads)
+    {
+        // 旧表原样保留给还在读它的读者 这里只拷贝 hash_of 抛异常时旧表不受影响
+        for(size_type i = 0;i<old->capacity;++i)
+        {
+            if(!HashCtrl::is_full(old->ctrl[i]))
+                continue;
+            std::size_t hash = hash_of(old->nodes[i].data.first);
+            size_type j = find_first_non_full(t, hash);
+            set_ctrl(t, j, h2(hash));
+            std::memcpy(static_cast<void*>(&t->nodes[j]), static_cast<const void*>(&old->nodes[i]), sizeof(node_type));
+        }
+    }
+    else
+    {
+        // 移动会改动旧表 先算好所有 hash (可能抛异常) 再搬运
+        std::unique_ptr<std::size_t[]> hashes(new std::size_t[size]);
+        size_type k = 0;
+        for(size_type i = 0;i<old->capacity;++i)
+            if(HashCtrl::is_full(old->ctrl[i]))
+                hashes[k++] = hash_of(old->nodes[i].data.first);
+
+        k = 0;
+        for(size_type i = 0;i<old->capacity;++i)
+        {
+            if(!HashCtrl::is_full(old->ctrl[i]))
+                continue;
+            std::size_t hash = hashes[k++];
+            size_type j = find_first_non_full(t, hash);
+            if constexpr(std::is_nothrow_move_constructible<std::pair<Key, Value>>::value)
+                uninitialized_relocate(allocator, &old->nodes[i].mutable_data, &old->nodes[i].mutable_data + 1, &t->nodes[j].mutable_data);
+            else
+            {
+                // 只能拷贝: 旧表元素保留到全部拷贝成功 失败时析构新表中已有的拷贝
+                try
+                {
+                    allocator.construct(&t->nodes[j].mutable_data, static_cast<const std::pair<Key, Value>&>(old->nodes[i].mutable_data));
+                }
+                catch(...)
+                {
+                    for(size_type m = 0;m<t->capacity;++m)
+                        if(HashCtrl::is_full(t->ctrl[m]))
+                            allocator.destroy(&t->nodes[m].data);
+                    throw;
+                }
+            }
+            set_ctrl(t, j, h2(hash));
+        }
+        if constexpr(!std::is_nothrow_move_constructible<std::pair<Key, Value>>::value)
+            for(size_type i = 0;i<old->capacity;++i)
+                if(HashCtrl::is_full(old->ctrl[i]))
+                    allocator.destroy(&old->nodes[i].data);
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+typename ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::Table*
+ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::grow(Shard& shard)
+{
+    Table* old = shard.table.load(std::memory_order_relaxed);
+    size_type size = shard.size.load(std::memory_order_relaxed);
+    size_type capacity = HashGroup::width;
+    if(old)
+        // 已删除槽位过多时原容量重建即可 否则翻倍
+        capacity = size < max_load(old->capacity) / 2 ? old->capacity : old->capacity * 2;
+
+    if constexpr(optimistic_reads)
+    {
+        // 原容量时就地重建 不产生退役表: 增删交替的负载下退役表不会无限累积
+        if(old && capacity == old->capacity)
+        {
+            rebuild_in_place(shard, old);
+            return old;
+        }
+    }
+
+    Table* t = allocate_table(capacity);
+    if(old)
+    {
+        try
+        {
+            fill_table(t, old, size);
+        }
+        catch(...)
+        {
+            // 新表未发布 旧表完整
+            free_table(t);
+            throw;
+        }
+    }
+    shard.growth_left = max_load(capacity) - size;
+
+    // 新表内容写完后再发布 读者拿到指针时看到的一定是完整的表
+    shard.table.store(t, std::memory_order_release);
+    if(old)
+    {
+        if constexpr(optimistic_reads)
+        {
+            old->next_retired = shard.retired;
+            shard.retired = old;
+        }
+        else
+            free_table(old);        // 结点已搬走 且没有读者 (读者持有共享锁)
+    }
+    return t;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+void ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::erase_index(Shard& shard, Table* t, size_type i)
+{
+    allocator.destroy(&t->nodes[i].data);
+    shard.size.fetch_sub(1, std::memory_order_relaxed);
+
+    // 没有探测序列越过 i 时直接置空 否则留下墓碑 (见 HashProbe::vacate)
+    if(HashProbe::vacate(t->ctrl, t->capacity, i))
+        ++shard.growth_left;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+template<typename K, typename M>
+bool ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::assign_or_insert(K&& key, M&& value)
+{
+    std::size_t hash = hash_of(key);
+    Shard& shard = shard_for(hash);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    Table* t = shard.table.load(std::memory_order_relaxed);
+    size_type i = 0;
+    if(t)
+    {
+        i = find_index(t, key, hash);
+        if(i != t->capacity)
+        {
+            WriteGuard guard(shard);
+            t->nodes[i].data.second = std::forward<M>(value);
+            return false;
+        }
+        i = find_first_non_full(t, hash);
+    }
+    // 已删除槽位可以直接复用 只有占用空槽位才消耗 growth_left
+    if(t == nullptr || (shard.growth_left == 0 && t->ctrl[i] != HashCtrl::Deleted))
+    {
+        t = grow(shard);
+        i = find_first_non_full(t, hash);
+    }
+
+    WriteGuard guard(shard);
+    // 先构造结点 成功后才设置控制字节 构造抛异常时表不变
+    allocator.construct(&t->nodes[i].data, std::forward<K>(key), std::forward<M>(value));
+    if(t->ctrl[i] == HashCtrl::Empty)
+        --shard.growth_left;
+    set_ctrl(t, i, h2(hash));
+    shard.size.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// ---------------------------- 构造/析构 ----------------------------
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+typename ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::size_type
+ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::default_shard_count()
+{
+    size_type threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 16 : threads * 4;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::ConcurrentUnorderedMap(size_type shard_hint, const Alloc& alloc)
+: shard_count(1), shard_bits(0), allocator(alloc), ctrl_allocator(alloc), table_allocator(alloc)
+{
+    while(shard_count < shard_hint)
+    {
+        shard_count *= 2;
+        ++shard_bits;
+    }
+    shards.reset(new Shard[shard_count]);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::~ConcurrentUnorderedMap()
+{
+    reclaim();
+    for(size_type s = 0;s<shard_count;++s)
+        if(Table* t = shards[s].table.load(std::memory_order_relaxed))
+            destroy_table(t);
+}
+
+// ---------------------------- 查找 ----------------------------
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+typename ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::size_type
+ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::size() const
+{
+    size_type n = 0;
+    for(size_type s = 0;s<shard_count;++s)
+        n += shards[s].size.load(std::memory_order_relaxed);
+    return n;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+std::optional<Value> ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::find(const Key& key) const
+{
+    std::size_t hash = hash_of(key);
+    const Shard& shard = shard_for(hash);
+
+    if constexpr(optimistic_reads)
+    {
+        alignas(Value) unsigned char value_copy[sizeof(Value)];
+        while(true)
+        {
+            std::uint64_t before = shard.seq.load(std::memory_order_acquire);
+            if(before & 1)
+            {
+                cpu_relax();
+                continue;
+            }
+            bool found = optimistic_find(shard.table.load(std::memory_order_acquire), key, hash, value_copy);
+            // 读完后版本号未变 说明期间没有写入 读到的是一致的数据
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(shard.seq.load(std::memory_order_relaxed) != before)
+                continue;
+            if(!found)
+                return std::nullopt;
+            return *reinterpret_cast<const Value*>(value_copy);
+        }
+    }
+    else
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        const Table* t = shard.table.load(std::memory_order_relaxed);
+        if(t == nullptr)
+            return std::nullopt;
+        size_type i = find_index(t, key, hash);
+        if(i == t->capacity)
+            return std::nullopt;
+        return t->nodes[i].data.second;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+bool ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::contains(const Key& key) const
+{
+    if constexpr(optimistic_reads)
+        return find(key).has_value();
+    else
+        return cvisit(key, [](const value_type&) {});
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+template<typename F>
+bool ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::visit(const Key& key, F f)
+{
+    std::size_t hash = hash_of(key);
+    Shard& shard = shard_for(hash);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    Table* t = shard.table.load(std::memory_order_relaxed);
+    if(t == nullptr)
+        return false;
+    size_type i = find_index(t, key, hash);
+    if(i == t->capacity)
+        return false;
+    WriteGuard guard(shard);
+    f(t->nodes[i].data);
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+template<typename F>
+bool ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::cvisit(const Key& key, F f) const
+{
+    std::size_t hash = hash_of(key);
+    const Shard& shard = shard_for(hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const Table* t = shard.table.load(std::memory_order_relaxed);
+    if(t == nullptr)
+        return false;
+    size_type i = find_index(t, key, hash);
+    if(i == t->capacity)
+        return false;
+    f(static_cast<const value_type&>(t->nodes[i].data));
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+template<typename F>
+void ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::visit_all(F f)
+{
+    for(size_type s = 0;s<shard_count;++s)
+    {
+        Shard& shard = shards[s];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        Table* t = shard.table.load(std::memory_order_relaxed);
+        if(t == nullptr)
+            continue;
+        WriteGuard guard(shard);
+        for(size_type i = 0;i<t->capacity;++i)
+            if(HashCtrl::is_full(t->ctrl[i]))
+                f(t->nodes[i].data);
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+template<typename F>
+void ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::cvisit_all(F f) const
+{
+    for(size_type s = 0;s<shard_count;++s)
+    {
+        const Shard& shard = shards[s];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        const Table* t = shard.table.load(std::memory_order_relaxed);
+        if(t == nullptr)
+            continue;
+        for(size_type i = 0;i<t->capacity;++i)
+            if(HashCtrl::is_full(t->ctrl[i]))
+                f(static_cast<const value_type&>(t->nodes[i].data));
+    }
+}
+
+// ---------------------------- 修改 ----------------------------
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+template<typename M>
+bool ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::insert_or_assign(const Key& key, M&& value)
+{
+    return assign_or_insert(key, std::forward<M>(value));
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+template<typename M>
+bool ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::insert_or_assign(Key&& key, M&& value)
+{
+    return assign_or_insert(std::move(key), std::forward<M>(value));
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+typename ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::size_type
+ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::erase(const Key& key)
+{
+    std::size_t hash = hash_of(key);
+    Shard& shard = shard_for(hash);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    Table* t = shard.table.load(std::memory_order_relaxed);
+    if(t == nullptr)
+        return 0;
+    size_type i = find_index(t, key, hash);
+    if(i == t->capacity)
+        return 0;
+    WriteGuard guard(shard);
+    erase_index(shard, t, i);
+    return 1;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+void ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::clear()
+{
+    for(size_type s = 0;s<shard_count;++s)
+    {
+        Shard& shard = shards[s];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        Table* t = shard.table.load(std::memory_order_relaxed);
+        if(t == nullptr)
+            continue;
+        WriteGuard guard(shard);
+        if(!std::is_trivially_destructible<value_type>::value)
+        {
+            for(size_type i = 0;i<t->capacity;++i)
+                if(HashCtrl::is_full(t->ctrl[i]))
+                    allocator.destroy(&t->nodes[i].data);
+        }
+        std::memset(t->ctrl, HashCtrl::Empty, t->capacity + HashGroup::width);
+        shard.size.store(0, std::memory_order_relaxed);
+        shard.growth_left = max_load(t->capacity);
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc>
+void ConcurrentUnorderedMap<Key, Value, Hash, KeyEqual, Alloc>::reclaim()
+{
+    for(size_type s = 0;s<shard_count;++s)
+    {
+        Shard& shard = shards[s];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        // 退役表的结点是拷贝出去的 (可平凡拷贝) 无需析构
+        while(Table* t = shard.retired)
+        {
+            shard.retired = t->next_retired;
+            free_table(t);
+        }
+    }
+}
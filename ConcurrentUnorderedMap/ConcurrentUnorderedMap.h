@@ -0,0 +1,213 @@
+#ifndef YXY__STL__CONCURRENT_UNORDERED_MAP_H
+#define YXY__STL__CONCURRENT_UNORDERED_MAP_H
+
+#include "../Unordered_map/Unordered_map.h"
+#include<atomic>
+#include<memory>
+#include<mutex>
+#include<shared_mutex>
+#include<optional>
+#include<type_traits>
+
+/*
+--- 分片并发哈希表: hash 高位选分片 每个分片是一张独立加锁的 Swiss table (控制字节 + 结点数组)
+--- 写操作 (insert_or_assign / erase / visit) 持有所在分片的独占锁 不同分片的写互不影响
+--- 读操作 (find / contains):
+---   Key 与 Value 都可平凡拷贝时走 seqlock 乐观读 不加锁也不写任何共享内存
+---   读之前和读之后比较分片版本号 期间有写入就重试 读吞吐随核数线性增长
+---   为此扩容后的旧表不立即释放 (可能仍有读者在读) 留到 reclaim() 或析构时释放
+---   退役表只来自翻倍扩容 (墓碑过多时在写锁和版本号保护下就地重建 不换表)
+---   各退役表容量逐次减半 加起来小于当前表 最多多占一倍内存
+---   其他类型取分片的共享锁 读读并行 与写互斥
+--- 所有分片共用 Alloc 会被多个线程同时调用 须线程安全 (Allocator / ThreadCacheAllocator)
+*/
+template<
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename KeyEqual = std::equal_to<Key>,
+    typename Alloc = Allocator<HashNode<Key, Value>>
+>
+class ConcurrentUnorderedMap
+{
+public:
+    using key_type          = Key;
+    using mapped_type       = Value;
+    using value_type        = std::pair<const Key, Value>;
+    using node_type         = HashNode<Key, Value>;
+    using size_type         = std::size_t;
+    using hasher_type       = Hash;
+    using key_equal_type    = KeyEqual;
+
+    // 读操作是否走 seqlock 乐观读
+    static constexpr bool optimistic_reads =
+        std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value;
+
+private:
+    // 一张表 发布之后 capacity / ctrl / nodes 不再改变 无锁读者可以放心读这三个字段
+    struct Table
+    {
+        size_type capacity;
+        ctrl_t* ctrl;                   // 长度 capacity + width 末尾是开头的镜像
+        node_type* nodes;
+        Table* next_retired;            // 已退役表的链表
+    };
+
+    // 每个分片独占缓存行 避免伪共享
+    struct alignas(64) Shard
+    {
+        std::atomic<std::uint64_t> seq{0};      // 奇数表示正在写
+        std::atomic<Table*> table{nullptr};
+        std::atomic<size_type> size{0};
+        size_type growth_left = 0;
+        Table* retired = nullptr;
+        mutable std::shared_mutex mutex;
+    };
+
+    // 写期间把分片版本号置为奇数 (只有乐观读模式需要)
+    class WriteGuard
+    {
+    public:
+        explicit WriteGuard(Shard& s) : shard(s)
+        {
+            if constexpr(optimistic_reads)
+            {
+                shard.seq.store(shard.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+        }
+        ~WriteGuard()
+        {
+            if constexpr(optimistic_reads)
+                shard.seq.store(shard.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+        WriteGuard(const WriteGuard&) = delete;
+        WriteGuard& operator=(const WriteGuard&) = delete;
+
+    private:
+        Shard& shard;
+    };
+
+    using ctrl_alloc_type = typename Alloc::template rebind<ctrl_t>::other;
+    using table_alloc_type = typename Alloc::template rebind<Table>::other;
+
+    std::unique_ptr<Shard[]> shards;
+    size_type shard_count;
+    unsigned shard_bits;                // shard_count = 2^shard_bits
+
+    // 辅助器
+    Alloc allocator;
+    ctrl_alloc_type ctrl_allocator;
+    table_alloc_type table_allocator;
+    KeyEqual key_equal;
+    Hash hasher;
+
+    static size_type max_load(size_type capacity)
+    { return capacity - capacity / 8; }
+
+    // 探测 / 控制字节的实现与 Unordered_map 共用 (HashProbe)
+    static ctrl_t h2(std::size_t hash)
+    { return HashProbe::h2(hash); }
+
+    static void set_ctrl(Table* t, size_type i, ctrl_t c)
+    { HashProbe::set_ctrl(t->ctrl, t->capacity, i, c); }
+
+    // 自旋等待时让出流水线
+    static void cpu_relax();
+
+    std::size_t hash_of(const Key& key) const
+    { return hash_mix(hasher(key)); }
+
+    // 最高 shard_bits 位选分片 低位留给分片内的探测起点和 h2
+    Shard& shard_for(std::size_t hash) const
+    { return shards[shard_bits == 0 ? 0 : hash >> (sizeof(std::size_t) * 8 - shard_bits)]; }
+
+    // 查找 key 所在槽位 不存在返回 t->capacity (须持有分片锁)
+    size_type find_index(const Table* t, const Key& key, std::size_t hash) const;
+    // 无锁查找: 把找到的值按字节拷到 out 读到的可能是撕裂的数据 由调用者用版本号校验
+    // 探测的 group 数有上限 即使读到正在修改的控制字节也一定会结束
+    bool optimistic_find(const Table* t, const Key& key, std::size_t hash, void* out) const;
+    static size_type find_first_non_full(const Table* t, std::size_t hash)
+    { return HashProbe::find_first_non_full(t->ctrl, t->capacity, hash); }
+
+    Table* allocate_table(size_type capacity);
+    // 只释放内存 不析构结点
+    void free_table(Table* t);
+    // 析构所有结点并释放
+    void destroy_table(Table* t);
+    // 扩容到一张新表并发布 旧表退役或释放 返回新表
+    // 已删除槽位过多时原容量重建: 乐观读模式下就地重建 返回原表
+    // 哈希函数或拷贝抛异常时分片不变
+    Table* grow(Shard& shard);
+    // 把旧表的 size 个元素放进未发布的新表 t: 乐观读模式下拷贝 否则搬运
+    // 抛异常时旧表完整 t 中已放入的元素已析构
+    void fill_table(Table* t, Table* old, size_type size);
+    // 持有版本号清掉 t 中的墓碑 存活结点经临时缓冲区重新插入 (仅乐观读模式 结点可平凡拷贝)
+    void rebuild_in_place(Shard& shard, Table* t);
+    void erase_index(Shard& shard, Table* t, size_type i);
+
+    template<typename K, typename M>
+    bool assign_or_insert(K&& key, M&& value);
+
+public:
+    // ---------------------- 构造函数 --------------------------
+    // 分片数向上取整到 2 的幂 默认为硬件线程数的 4 倍
+    explicit ConcurrentUnorderedMap(size_type shard_hint = default_shard_count(), const Alloc& alloc = Alloc());
+    // 持有锁 不可拷贝/移动
+    ConcurrentUnorderedMap(const ConcurrentUnorderedMap&) = delete;
+    ConcurrentUnorderedMap& operator=(const ConcurrentUnorderedMap&) = delete;
+
+    static size_type default_shard_count();
+
+    // ------------------------- 常用方法 ------------------------
+    // 各分片元素数之和 有并发写入时只是近似值
+    size_type size() const;
+
+    bool empty() const
+    { return size() == 0; }
+
+    size_type shards_count() const
+    { return shard_count; }
+
+    Alloc get_allocator() const
+    { return allocator; }
+
+    // --------------------------- 查找 --------------------------
+    // 返回值的拷贝 不存在返回 nullopt
+    std::optional<Value> find(const Key& key) const;
+    bool contains(const Key& key) const;
+
+    // 持有分片独占锁调用 f(value_type&) 可以原地修改 value 返回是否找到
+    template<typename F>
+    bool visit(const Key& key, F f);
+    // 持有分片共享锁调用 f(const value_type&)
+    template<typename F>
+    bool cvisit(const Key& key, F f) const;
+    // 逐个分片加锁遍历所有元素 (不是整体快照)
+    template<typename F>
+    void visit_all(F f);
+    template<typename F>
+    void cvisit_all(F f) const;
+
+    // --------------------------- 修改 --------------------------
+    // 不存在则插入 存在则赋值 返回是否新插入
+    template<typename M>
+    bool insert_or_assign(const Key& key, M&& value);
+    template<typename M>
+    bool insert_or_assign(Key&& key, M&& value);
+
+    // 返回删除的个数 (0/1)
+    size_type erase(const Key& key);
+
+    // 清空元素 保留各分片的表
+    void clear();
+
+    // 释放扩容时退役的旧表 调用者须保证此时没有并发的 find/contains
+    void reclaim();
+
+    ~ConcurrentUnorderedMap();
+};
+
+#include "ConcurrentUnorderedMap.cpp"
+
+#endif // YXY__STL__CONCURRENT_UNORDERED_MAP_H
@@ -0,0 +1,455 @@
+#include "Deque.h"
+
+template<typename T, typename Alloc>
+T* Deque<T, Alloc>::allocate_block()
+{
+    if(spare)
+    {
+        T* block = spare;
+        spare = nullptr;
+        return block;
+    }
+    return allocator.allocate(block_size);
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::deallocate_block(T* block)
+{
+    if(!spare)
+        spare = block;
+    else
+        allocator.deallocate(block, block_size);
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::initialize_map()
+{
+    size_type n = 8;
+    T** m = map_allocator.allocate(n);
+    T** node = m + n / 2;
+    try
+    {
+        *node = allocate_block();
+    }
+    catch(...)
+    {
+        map_allocator.deallocate(m, n);
+        throw;
+    }
+    map = m;
+    map_size = n;
+    start.set_node(node);
+    start.cur = start.first;
+    finish = start;
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::reserve_map_at_back(size_type n)
+{
+    if(n + 1 > map_size - static_cast<size_type>(finish.node - map))
+        reallocate_map(n, false);
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::reserve_map_at_front(size_type n)
+{
+    if(n > static_cast<size_type>(start.node - map))
+        reallocate_map(n, true);
+}
+
+// 只搬运块指针 元素不动
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::reallocate_map(size_type nodes_to_add, bool add_at_front)
+{
+    size_type old_nodes = static_cast<size_type>(finish.node - start.node) + 1;
+    size_type new_nodes = old_nodes + nodes_to_add;
+    T** new_start;
+    if(map_size > 2 * new_nodes)
+    {
+        // map 还很空 只是偏向一侧: 原地重新居中
+        new_start = map + (map_size - new_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+        if(new_start < start.node)
+            std::copy(start.node, finish.node + 1, new_start);
+        else
+            std::copy_backward(start.node, finish.node + 1, new_start + old_nodes);
+    }
+    else
+    {
+        size_type new_map_size = map_size + (map_size > nodes_to_add ? map_size : nodes_to_add) + 2;
+        T** new_map = map_allocator.allocate(new_map_size);
+        new_start = new_map + (new_map_size - new_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+        std::copy(start.node, finish.node + 1, new_start);
+        map_allocator.deallocate(map, map_size);
+        map = new_map;
+        map_size = new_map_size;
+    }
+    // cur 指向块内 块没有移动 只需更新 node
+    start.set_node(new_start);
+    finish.set_node(new_start + old_nodes - 1);
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::release()
+{
+    if(!map)
+        return;
+    for(iterator it = start;it != finish;++it)
+        allocator.destroy(it.cur);
+    for(T** node = start.node;node <= finish.node;++node)
+        allocator.deallocate(*node, block_size);
+    if(spare)
+        allocator.deallocate(spare, block_size);
+    map_allocator.deallocate(map, map_size);
+    map = nullptr;
+    map_size = 0;
+    spare = nullptr;
+    start = iterator();
+    finish = iterator();
+}
+
+// ---------------------- 构造函数 --------------------------
+template<typename T, typename Alloc>
+Deque<T, Alloc>::Deque(size_type n)
+: Deque()
+{
+    try
+    {
+        resize(n);
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+template<typename T, typename Alloc>
+Deque<T, Alloc>::Deque(size_type n, const value_type& value)
+: Deque()
+{
+    try
+    {
+        resize(n, value);
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+template<typename T, typename Alloc>
+Deque<T, Alloc>::Deque(std::initializer_list<value_type> il)
+: Deque()
+{
+    try
+    {
+        for(const value_type& v : il)
+            emplace_back(v);
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+template<typename T, typename Alloc>
+Deque<T, Alloc>::Deque(const Deque& other)
+: Deque(other.allocator)
+{
+    try
+    {
+        for(const value_type& v : other)
+            emplace_back(v);
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+template<typename T, typename Alloc>
+Deque<T, Alloc>::Deque(Deque&& other) noexcept
+: map(other.map), map_size(other.map_size), start(other.start), finish(other.finish), spare(other.spare),
+  allocator(other.allocator), map_allocator(other.map_allocator)
+{
+    other.map = nullptr;
+    other.map_size = 0;
+    other.start = iterator();
+    other.finish = iterator();
+    other.spare = nullptr;
+}
+
+template<typename T, typename Alloc>
+Deque<T, Alloc>& Deque<T, Alloc>::operator=(const Deque& rhs)
+{
+    if(this != &rhs)
+    {
+        Deque tmp(rhs);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template<typename T, typename Alloc>
+Deque<T, Alloc>& Deque<T, Alloc>::operator=(Deque&& rhs) noexcept
+{
+    if(this != &rhs)
+    {
+        release();
+        swap(rhs);
+    }
+    return *this;
+}
+
+template<typename T, typename Alloc>
+Deque<T, Alloc>::~Deque()
+{
+    release();
+}
+
+// ------------------------- 头尾操作 ------------------------
+template<typename T, typename Alloc>
+template<typename... Args>
+typename Deque<T, Alloc>::reference Deque<T, Alloc>::emplace_back(Args&&... args)
+{
+    if(map && finish.cur != finish.last - 1)
+    {
+        allocator.construct(finish.cur, std::forward<Args>(args)...);
+        ++finish.cur;
+    }
+    else
+        emplace_back_aux(std::forward<Args>(args)...);
+    return back();
+}
+
+// 尾块只剩最后一个位置: 构造到这个位置后 finish 移到新块开头
+template<typename T, typename Alloc>
+template<typename... Args>
+void Deque<T, Alloc>::emplace_back_aux(Args&&... args)
+{
+    if(!map)
+    {
+        initialize_map();
+        allocator.construct(finish.cur, std::forward<Args>(args)...);
+        ++finish.cur;
+        return;
+    }
+    reserve_map_at_back(1);
+    *(finish.node + 1) = allocate_block();
+    try
+    {
+        allocator.construct(finish.cur, std::forward<Args>(args)...);
+    }
+    catch(...)
+    {
+        deallocate_block(*(finish.node + 1));
+        throw;
+    }
+    finish.set_node(finish.node + 1);
+    finish.cur = finish.first;
+}
+
+template<typename T, typename Alloc>
+template<typename... Args>
+typename Deque<T, Alloc>::reference Deque<T, Alloc>::emplace_front(Args&&... args)
+{
+    if(map && start.cur != start.first)
+    {
+        allocator.construct(start.cur - 1, std::forward<Args>(args)...);
+        --start.cur;
+    }
+    else
+        emplace_front_aux(std::forward<Args>(args)...);
+    return front();
+}
+
+// 首块前面没有空位: 在前一个新块的末尾构造
+template<typename T, typename Alloc>
+template<typename... Args>
+void Deque<T, Alloc>::emplace_front_aux(Args&&... args)
+{
+    if(!map)
+    {
+        initialize_map();
+        // 第一个元素放在块中间 之后两个方向都有空位
+        start.cur = finish.cur = start.first + block_size / 2;
+        allocator.construct(finish.cur, std::forward<Args>(args)...);
+        ++finish.cur;
+        return;
+    }
+    reserve_map_at_front(1);
+    *(start.node - 1) = allocate_block();
+    T* slot = *(start.node - 1) + (block_size - 1);
+    try
+    {
+        allocator.construct(slot, std::forward<Args>(args)...);
+    }
+    catch(...)
+    {
+        deallocate_block(*(start.node - 1));
+        throw;
+    }
+    start.set_node(start.node - 1);
+    start.cur = slot;
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::pop_back()
+{
+    if(finish.cur != finish.first)
+    {
+        --finish.cur;
+        allocator.destroy(finish.cur);
+    }
+    else
+    {
+        // 尾块已空 释放后退到前一个块的最后一个元素
+        deallocate_block(finish.first);
+        finish.set_node(finish.node - 1);
+        finish.cur = finish.last - 1;
+        allocator.destroy(finish.cur);
+    }
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::pop_front()
+{
+    allocator.destroy(start.cur);
+    if(start.cur != start.last - 1)
+        ++start.cur;
+    else
+    {
+        // 首块已空 释放后进入下一个块
+        deallocate_block(start.first);
+        start.set_node(start.node + 1);
+        start.cur = start.first;
+    }
+}
+
+// ------------------------- 中间操作 ------------------------
+template<typename T, typename Alloc>
+template<typename... Args>
+typename Deque<T, Alloc>::iterator Deque<T, Alloc>::emplace(const_iterator pos, Args&&... args)
+{
+    difference_type index = pos - cbegin();
+    if(index == 0)
+    {
+        emplace_front(std::forward<Args>(args)...);
+        return start;
+    }
+    if(static_cast<size_type>(index) == size())
+    {
+        emplace_back(std::forward<Args>(args)...);
+        return finish - 1;
+    }
+    // 参数可能引用本容器中的元素 先构造出来
+    value_type tmp(std::forward<Args>(args)...);
+    if(static_cast<size_type>(index) < size() / 2)
+    {
+        // 前半段整体前移一位
+        emplace_front(std::move(front()));
+        iterator first = start + 1;
+        std::move(first + 1, first + index, first);
+    }
+    else
+    {
+        // 后半段整体后移一位
+        emplace_back(std::move(back()));
+        iterator last = finish - 1;
+        std::move_backward(start + index, last - 1, last);
+    }
+    iterator it = start + index;
+    *it = std::move(tmp);
+    return it;
+}
+
+template<typename T, typename Alloc>
+typename Deque<T, Alloc>::iterator Deque<T, Alloc>::erase(const_iterator pos)
+{
+    difference_type index = pos - cbegin();
+    iterator it = start + index;
+    if(static_cast<size_type>(index) < size() / 2)
+    {
+        std::move_backward(start, it, it + 1);
+        pop_front();
+    }
+    else
+    {
+        std::move(it + 1, finish, it);
+        pop_back();
+    }
+    return start + index;
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::resize(size_type n)
+{
+    while(size() > n)
+        pop_back();
+    while(size() < n)
+        emplace_back();
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::resize(size_type n, const value_type& value)
+{
+    while(size() > n)
+        pop_back();
+    while(size() < n)
+        emplace_back(value);
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::clear()
+{
+    if(!map)
+        return;
+    for(iterator it = start;it != finish;++it)
+        allocator.destroy(it.cur);
+    // 留下首块 其余块释放
+    for(T** node = start.node + 1;node <= finish.node;++node)
+        deallocate_block(*node);
+    finish = start;
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::shrink_to_fit()
+{
+    if(spare)
+    {
+        allocator.deallocate(spare, block_size);
+        spare = nullptr;
+    }
+}
+
+template<typename T, typename Alloc>
+void Deque<T, Alloc>::swap(Deque& other) noexcept
+{
+    std::swap(map, other.map);
+    std::swap(map_size, other.map_size);
+    std::swap(start, other.start);
+    std::swap(finish, other.finish);
+    std::swap(spare, other.spare);
+    std::swap(allocator, other.allocator);
+    std::swap(map_allocator, other.map_allocator);
+}
+
+// --------------------------- 访问 --------------------------
+template<typename T, typename Alloc>
+typename Deque<T, Alloc>::reference Deque<T, Alloc>::at(size_type n)
+{
+    if(n >= size())
+        throw std::out_of_range("Deque:: index out of range!");
+    return (*this)[n];
+}
+
+template<typename T, typename Alloc>
+typename Deque<T, Alloc>::const_reference Deque<T, Alloc>::at(size_type n) const
+{
+    if(n >= size())
+        throw std::out_of_range("Deque:: index out of range!");
+    return (*this)[n];
+}
@@ -0,0 +1,294 @@
+#ifndef YXY__STL__DEQUE_H
+#define YXY__STL__DEQUE_H
+
+#include "../allocator.h"
+#include<algorithm>
+#include<cstddef>
+#include<initializer_list>
+#include<iterator>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+
+/*
+--- 分段连续的双端队列: 元素存放在固定大小的块中 块指针存放在中控数组 (map) 里
+--- 头尾插入/删除均摊 O(1): 只在当前块用完时申请新块 map 满时只搬运块指针
+--- 元素本身从不因扩容移动 头尾的插入/删除不会使其他元素的引用和指针失效 (迭代器会失效)
+--- start / finish 两个迭代器标出首元素和尾后位置 finish 所在的块总是已分配
+--- 刚好在块边界上交替插入/删除时 会反复申请/释放同一个块 所以缓存一个空闲块 (spare)
+--- 块和 map 都经由 Alloc 的 rebind 申请
+*/
+
+// 每块元素个数: 小元素每块约 4 KiB 大元素每块 16 个 (至少 16 个)
+template<typename T>
+constexpr std::size_t deque_block_size()
+{ return sizeof(T) <= 256 ? 4096 / sizeof(T) : 16; }
+
+// 随机访问迭代器 cur 为当前元素 [first, last) 为当前块 node 指向 map 中当前块的指针
+template<typename T, bool IsConst>
+class DequeIterator
+{
+    template<typename, typename>
+    friend class Deque;
+    template<typename, bool>
+    friend class DequeIterator;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = typename std::conditional<IsConst, const T*, T*>::type;
+    using reference         = typename std::conditional<IsConst, const T&, T&>::type;
+
+private:
+    static constexpr difference_type block = static_cast<difference_type>(deque_block_size<T>());
+
+    T* cur;
+    T* first;
+    T* last;
+    T** node;
+
+    // 跳到另一个块 cur 由调用者设置
+    void set_node(T** n)
+    {
+        node = n;
+        first = *n;
+        last = first + block;
+    }
+
+public:
+    DequeIterator() : cur(nullptr), first(nullptr), last(nullptr), node(nullptr) {}
+
+    // 非const -> const
+    template<bool C = IsConst, typename = typename std::enable_if<C>::type>
+    DequeIterator(const DequeIterator<T, false>& other)
+    : cur(other.cur), first(other.first), last(other.last), node(other.node) {}
+
+    reference operator*() const { return *cur; }
+    pointer operator->() const { return cur; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    DequeIterator& operator++()
+    {
+        ++cur;
+        if(cur == last)
+        {
+            set_node(node + 1);
+            cur = first;
+        }
+        return *this;
+    }
+    DequeIterator operator++(int)
+    {
+        DequeIterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    DequeIterator& operator--()
+    {
+        if(cur == first)
+        {
+            set_node(node - 1);
+            cur = last;
+        }
+        --cur;
+        return *this;
+    }
+    DequeIterator operator--(int)
+    {
+        DequeIterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    DequeIterator& operator+=(difference_type n)
+    {
+        difference_type offset = n + (cur - first);
+        if(offset >= 0 && offset < block)
+            cur += n;
+        else
+        {
+            // 向下取整的块偏移
+            difference_type node_offset = offset > 0 ? offset / block : -((-offset - 1) / block) - 1;
+            set_node(node + node_offset);
+            cur = first + (offset - node_offset * block);
+        }
+        return *this;
+    }
+    DequeIterator& operator-=(difference_type n)
+    { return *this += -n; }
+
+    friend DequeIterator operator+(DequeIterator it, difference_type n) { return it += n; }
+    friend DequeIterator operator+(difference_type n, DequeIterator it) { return it += n; }
+    friend DequeIterator operator-(DequeIterator it, difference_type n) { return it -= n; }
+
+    // 空 Deque 的迭代器全为空指针 结果也是 0
+    friend difference_type operator-(const DequeIterator& a, const DequeIterator& b)
+    { return block * (a.node - b.node) + (a.cur - a.first) - (b.cur - b.first); }
+
+    friend bool operator==(const DequeIterator& a, const DequeIterator& b) { return a.cur == b.cur; }
+    friend bool operator!=(const DequeIterator& a, const DequeIterator& b) { return a.cur != b.cur; }
+    friend bool operator<(const DequeIterator& a, const DequeIterator& b)
+    { return a.node == b.node ? a.cur < b.cur : a.node < b.node; }
+    friend bool operator>(const DequeIterator& a, const DequeIterator& b) { return b < a; }
+    friend bool operator<=(const DequeIterator& a, const DequeIterator& b) { return !(b < a); }
+    friend bool operator>=(const DequeIterator& a, const DequeIterator& b) { return !(a < b); }
+};
+
+template<typename T, typename Alloc = Allocator<T>>
+class Deque
+{
+public:
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = const T*;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = std::size_t;
+    using difference_type   = std::ptrdiff_t;
+    using iterator          = DequeIterator<T, false>;
+    using const_iterator    = DequeIterator<T, true>;
+    using allocator_type    = Alloc;
+
+    // 每块元素个数
+    static constexpr size_type block_size = deque_block_size<T>();
+
+private:
+    using map_alloc_type = typename Alloc::template rebind<T*>::other;
+
+    // 中控数组 map_size 个块指针 [start.node, finish.node] 之外的位置未使用
+    T** map;
+    size_type map_size;
+    iterator start;
+    iterator finish;
+    // 缓存的空闲块 (没有时为空)
+    T* spare;
+
+    Alloc allocator;
+    map_alloc_type map_allocator;
+
+    T* allocate_block();
+    // 释放块 没有缓存的空闲块时留作缓存
+    void deallocate_block(T* block);
+
+    // 第一次插入时分配 map 和一个块
+    void initialize_map();
+    // 保证 map 尾部 / 头部还有 n 个空位 不够时重新居中或换更大的 map
+    void reserve_map_at_back(size_type n);
+    void reserve_map_at_front(size_type n);
+    void reallocate_map(size_type nodes_to_add, bool add_at_front);
+
+    // 当前块已满时的尾插 / 当前块没有空位时的头插
+    template<typename... Args>
+    void emplace_back_aux(Args&&... args);
+    template<typename... Args>
+    void emplace_front_aux(Args&&... args);
+
+    // 析构所有元素 释放所有块和 map 回到未分配状态
+    void release();
+
+public:
+    // ---------------------- 构造函数 --------------------------
+    // map 的分配器由 allocator rebind 而来 有状态的分配器 (内存池) 两者共用同一个资源
+    Deque()
+    : map(nullptr), map_size(0), spare(nullptr), map_allocator(allocator) {}
+    // 指定分配器 (有状态的分配器 如 arena/内存池)
+    explicit Deque(const Alloc& alloc)
+    : map(nullptr), map_size(0), spare(nullptr), allocator(alloc), map_allocator(alloc) {}
+    // n 个值初始化的元素
+    explicit Deque(size_type n);
+    Deque(size_type n, const value_type& value);
+    Deque(std::initializer_list<value_type> il);
+    // 拷贝
+    Deque(const Deque& other);
+    // 移动
+    Deque(Deque&& other) noexcept;
+
+    // 赋值
+    Deque& operator=(const Deque& rhs);
+    Deque& operator=(Deque&& rhs) noexcept;
+
+    ~Deque();
+
+    // ------------------------- 常用方法 ------------------------
+    size_type size() const
+    { return static_cast<size_type>(finish - start); }
+
+    bool empty() const
+    { return start == finish; }
+
+    Alloc get_allocator() const
+    { return allocator; }
+
+    iterator begin()
+    { return start; }
+    iterator end()
+    { return finish; }
+    const_iterator begin() const
+    { return start; }
+    const_iterator end() const
+    { return finish; }
+    const_iterator cbegin() const
+    { return start; }
+    const_iterator cend() const
+    { return finish; }
+
+    // 头尾插入 / 删除 不移动其他元素
+    void push_back(const value_type& value)
+    { emplace_back(value); }
+    void push_back(value_type&& value)
+    { emplace_back(std::move(value)); }
+    template<typename... Args>
+    reference emplace_back(Args&&... args);
+
+    void push_front(const value_type& value)
+    { emplace_front(value); }
+    void push_front(value_type&& value)
+    { emplace_front(std::move(value)); }
+    template<typename... Args>
+    reference emplace_front(Args&&... args);
+
+    void pop_back();
+    void pop_front();
+
+    // 中间插入 / 删除: 移动离 pos 较近的一端 所有迭代器和引用失效
+    iterator insert(const_iterator pos, const value_type& value)
+    { return emplace(pos, value); }
+    iterator insert(const_iterator pos, value_type&& value)
+    { return emplace(pos, std::move(value)); }
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    iterator erase(const_iterator pos);
+
+    // 改变元素个数 新增元素值初始化 / 拷贝 value (在尾部增删)
+    void resize(size_type n);
+    void resize(size_type n, const value_type& value);
+
+    // 清空元素 保留一个块和 map
+    void clear();
+    // 释放缓存的空闲块
+    void shrink_to_fit();
+    void swap(Deque& other) noexcept;
+
+    // --------------------------- 访问 --------------------------
+    reference operator[](size_type n)
+    { return start[static_cast<difference_type>(n)]; }
+    const_reference operator[](size_type n) const
+    { return start[static_cast<difference_type>(n)]; }
+    reference at(size_type n);
+    const_reference at(size_type n) const;
+
+    reference front()
+    { return *start; }
+    const_reference front() const
+    { return *start; }
+    reference back()
+    { return *(finish - 1); }
+    const_reference back() const
+    { return *(finish - 1); }
+};
+
+#include "Deque.cpp"
+
+#endif // YXY__STL__DEQUE_H
@@ -0,0 +1,386 @@
+#include "MappedVector.h"
+#include<cerrno>
+#include<cstring>
+#include<new>
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+
+namespace mapped_vector_detail
+{
+    constexpr char magic[8] = {'Y', 'X', 'Y', 'M', 'V', 'E', 'C', '\0'};
+    constexpr std::uint32_t version = 1;
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::throw_errno(const char* what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::check_writable() const
+{
+    if(!base)
+        throw std::logic_error("MappedVector:: file not open!");
+    if(readonly)
+        throw std::logic_error("MappedVector:: file opened read-only!");
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::set_pointers(size_type size, size_type capacity)
+{
+    start = reinterpret_cast<T*>(static_cast<char*>(base) + header_bytes);
+    finish = start + size;
+    end_of_storage = start + capacity;
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::reset_state()
+{
+    fd = -1;
+    base = nullptr;
+    mapped_bytes = 0;
+    readonly = false;
+    start = finish = end_of_storage = nullptr;
+}
+
+// ---------------------- 构造函数 --------------------------
+template<typename T, typename GrowthPolicy>
+MappedVector<T, GrowthPolicy>::MappedVector(const std::string& path, MapMode mode)
+: MappedVector()
+{
+    open(path, mode);
+}
+
+template<typename T, typename GrowthPolicy>
+MappedVector<T, GrowthPolicy>::MappedVector(MappedVector&& other) noexcept
+: fd(other.fd), base(other.base), mapped_bytes(other.mapped_bytes), readonly(other.readonly),
+  start(other.start), finish(other.finish), end_of_storage(other.end_of_storage)
+{
+    other.reset_state();
+}
+
+template<typename T, typename GrowthPolicy>
+MappedVector<T, GrowthPolicy>& MappedVector<T, GrowthPolicy>::operator=(MappedVector&& rhs) noexcept
+{
+    if(this != &rhs)
+    {
+        close();
+        fd = rhs.fd;
+        base = rhs.base;
+        mapped_bytes = rhs.mapped_bytes;
+        readonly = rhs.readonly;
+        start = rhs.start;
+        finish = rhs.finish;
+        end_of_storage = rhs.end_of_storage;
+        rhs.reset_state();
+    }
+    return *this;
+}
+
+template<typename T, typename GrowthPolicy>
+MappedVector<T, GrowthPolicy>::~MappedVector()
+{
+    close();
+}
+
+// ------------------------- 文件 ---------------------------
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::open(const std::string& path, MapMode mode)
+{
+    close();
+    int flags = mode == MapMode::ReadOnly ? O_RDONLY
+              : mode == MapMode::Truncate ? O_RDWR | O_CREAT | O_TRUNC
+              : O_RDWR | O_CREAT;
+    int f = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if(f < 0)
+        throw_errno("MappedVector:: open failed!");
+
+    // 映射建立前出错时关闭文件 之后由 close() 负责
+    struct stat st;
+    if(::fstat(f, &st) != 0)
+    {
+        int e = errno;
+        ::close(f);
+        errno = e;
+        throw_errno("MappedVector:: fstat failed!");
+    }
+    size_type file_bytes = static_cast<size_type>(st.st_size);
+    bool fresh = file_bytes == 0 && mode != MapMode::ReadOnly;
+    if(fresh)
+    {
+        if(::ftruncate(f, header_bytes) != 0)
+        {
+            int e = errno;
+            ::close(f);
+            errno = e;
+            throw_errno("MappedVector:: ftruncate failed!");
+        }
+        file_bytes = header_bytes;
+    }
+    if(file_bytes < header_bytes || (file_bytes - header_bytes) % sizeof(T) != 0)
+    {
+        ::close(f);
+        throw std::runtime_error("MappedVector:: not a MappedVector file!");
+    }
+
+    int prot = mode == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* p = ::mmap(nullptr, file_bytes, prot, MAP_SHARED, f, 0);
+    if(p == MAP_FAILED)
+    {
+        int e = errno;
+        ::close(f);
+        errno = e;
+        throw_errno("MappedVector:: mmap failed!");
+    }
+    fd = f;
+    base = p;
+    mapped_bytes = file_bytes;
+    readonly = mode == MapMode::ReadOnly;
+
+    Header* h = header();
+    size_type capacity = (file_bytes - header_bytes) / sizeof(T);
+    if(fresh)
+    {
+        std::memcpy(h->magic, mapped_vector_detail::magic, sizeof(h->magic));
+        h->version = mapped_vector_detail::version;
+        h->elem_size = static_cast<std::uint32_t>(sizeof(T));
+        h->size = 0;
+    }
+    else
+    {
+        const char* error = nullptr;
+        if(std::memcmp(h->magic, mapped_vector_detail::magic, sizeof(h->magic)) != 0)
+            error = "MappedVector:: not a MappedVector file!";
+        else if(h->version != mapped_vector_detail::version)
+            error = "MappedVector:: unsupported file version!";
+        else if(h->elem_size != sizeof(T))
+            error = "MappedVector:: element size mismatch!";
+        else if(h->size > capacity)
+            error = "MappedVector:: corrupted size in header!";
+        if(error)
+        {
+            // 不改动文件: 不写文件头 也不截断
+            ::munmap(base, mapped_bytes);
+            ::close(fd);
+            reset_state();
+            throw std::runtime_error(error);
+        }
+    }
+    set_pointers(static_cast<size_type>(h->size), capacity);
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::close() noexcept
+{
+    if(!base)
+        return;
+    if(!readonly)
+    {
+        size_type n = size();
+        header()->size = n;
+        ::munmap(base, mapped_bytes);
+        // 截掉多余容量 失败时文件仍然有效 (只是偏大)
+        (void)::ftruncate(fd, static_cast<off_t>(bytes_for(n)));
+    }
+    else
+        ::munmap(base, mapped_bytes);
+    ::close(fd);
+    reset_state();
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::sync(bool wait)
+{
+    if(!base)
+        throw std::logic_error("MappedVector:: file not open!");
+    if(readonly)
+        return;
+    header()->size = size();
+    if(::msync(base, mapped_bytes, wait ? MS_SYNC : MS_ASYNC) != 0)
+        throw_errno("MappedVector:: msync failed!");
+}
+
+template<typename T, typename GrowthPolicy>
+bool MappedVector<T, GrowthPolicy>::advise(MapAdvice advice)
+{
+    if(!base)
+        return false;
+    int a;
+    switch(advice)
+    {
+        case MapAdvice::Sequential: a = MADV_SEQUENTIAL; break;
+        case MapAdvice::Random:     a = MADV_RANDOM; break;
+        case MapAdvice::WillNeed:   a = MADV_WILLNEED; break;
+        case MapAdvice::DontNeed:   a = MADV_DONTNEED; break;
+        case MapAdvice::HugePage:
+#if defined(MADV_HUGEPAGE)
+            a = MADV_HUGEPAGE;
+            break;
+#else
+            return false;
+#endif
+        default:                    a = MADV_NORMAL; break;
+    }
+    return ::madvise(base, mapped_bytes, a) == 0;
+}
+
+// 先加长文件再扩大映射: 映射超出文件末尾的部分访问会触发 SIGBUS
+// 缩小时顺序相反
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::remap(size_type new_capacity)
+{
+    size_type n = size() < new_capacity ? size() : new_capacity;
+    size_type new_bytes = bytes_for(new_capacity);
+    if(new_bytes == mapped_bytes)
+        return;
+    bool grow = new_bytes > mapped_bytes;
+    if(grow && ::ftruncate(fd, static_cast<off_t>(new_bytes)) != 0)
+        throw_errno("MappedVector:: ftruncate failed!");
+
+#if defined(__linux__)
+    void* p = ::mremap(base, mapped_bytes, new_bytes, MREMAP_MAYMOVE);
+#else
+    // 没有 mremap: 先建新映射再拆旧映射 两者映射同一个文件 数据不需要拷贝
+    void* p = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(p != MAP_FAILED)
+        ::munmap(base, mapped_bytes);
+#endif
+    if(p == MAP_FAILED)
+    {
+        int e = errno;
+        if(grow)
+            (void)::ftruncate(fd, static_cast<off_t>(mapped_bytes));
+        errno = e;
+        throw_errno("MappedVector:: mremap failed!");
+    }
+    base = p;
+    mapped_bytes = new_bytes;
+    if(!grow)
+        (void)::ftruncate(fd, static_cast<off_t>(new_bytes));
+    set_pointers(n, new_capacity);
+}
+
+// ------------------------- 常用方法 ------------------------
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::reserve(size_type n)
+{
+    check_writable();
+    if(n > capacity())
+        remap(n);
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::shrink_to_fit()
+{
+    check_writable();
+    remap(size());
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::clear()
+{
+    check_writable();
+    finish = start;
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::resize(size_type n)
+{
+    check_writable();
+    if(n > capacity())
+        remap(next_capacity(n));
+    for(;finish < start + n;++finish)
+        ::new(static_cast<void*>(finish)) value_type();
+    finish = start + n;
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::resize(size_type n, const value_type& value)
+{
+    check_writable();
+    value_type copy = value;            // value 可能就在数组里 扩容后会失效
+    if(n > capacity())
+        remap(next_capacity(n));
+    for(;finish < start + n;++finish)
+        std::memcpy(static_cast<void*>(finish), &copy, sizeof(value_type));
+    finish = start + n;
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::push_back(const value_type& value)
+{
+    check_writable();
+    if(finish == end_of_storage)
+    {
+        value_type copy = value;
+        remap(next_capacity(size() + 1));
+        std::memcpy(static_cast<void*>(finish), &copy, sizeof(value_type));
+    }
+    else
+        std::memcpy(static_cast<void*>(finish), &value, sizeof(value_type));
+    ++finish;
+}
+
+template<typename T, typename GrowthPolicy>
+template<typename... Args>
+void MappedVector<T, GrowthPolicy>::emplace_back(Args&&... args)
+{
+    check_writable();
+    if(finish == end_of_storage)
+    {
+        value_type tmp(std::forward<Args>(args)...);
+        remap(next_capacity(size() + 1));
+        std::memcpy(static_cast<void*>(finish), &tmp, sizeof(value_type));
+    }
+    else
+        ::new(static_cast<void*>(finish)) value_type(std::forward<Args>(args)...);
+    ++finish;
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::pop_back()
+{
+    check_writable();
+    --finish;
+}
+
+template<typename T, typename GrowthPolicy>
+void MappedVector<T, GrowthPolicy>::append(const value_type* first, size_type n)
+{
+    check_writable();
+    if(n == 0)
+        return;
+    if(n > max_size() - size())
+        throw std::length_error("MappedVector:: capacity exceeds max_size()!");
+    if(size() + n > capacity())
+    {
+        // 源区间在数组内部时 记下偏移 扩容后重新定位
+        bool inside = first >= start && first < finish;
+        size_type offset = inside ? static_cast<size_type>(first - start) : 0;
+        remap(next_capacity(size() + n));
+        if(inside)
+            first = start + offset;
+    }
+    std::memmove(static_cast<void*>(finish), first, n * sizeof(value_type));
+    finish += n;
+}
+
+// --------------------------- 访问 --------------------------
+template<typename T, typename GrowthPolicy>
+typename MappedVector<T, GrowthPolicy>::reference MappedVector<T, GrowthPolicy>::at(size_type n)
+{
+    if(n >= size())
+        throw std::out_of_range("MappedVector:: index out of range!");
+    return start[n];
+}
+
+template<typename T, typename GrowthPolicy>
+typename MappedVector<T, GrowthPolicy>::const_reference MappedVector<T, GrowthPolicy>::at(size_type n) const
+{
+    if(n >= size())
+        throw std::out_of_range("MappedVector:: index out of range!");
+    return start[n];
+}
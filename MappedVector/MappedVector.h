@@ -0,0 +1,206 @@
+#ifndef YXY__STL__MAPPED_VECTOR_H
+#define YXY__STL__MAPPED_VECTOR_H
+
+#include "../Vector/growth_policy.h"
+#include<cstddef>
+#include<cstdint>
+#include<limits>
+#include<string>
+#include<stdexcept>
+#include<system_error>
+#include<type_traits>
+#include<utility>
+#include<sys/types.h>
+
+/*
+--- 文件映射的 Vector: 元素直接存放在 mmap 的文件里 数据量可以超过内存 由内核按页换入换出
+--- 与 Vector 相同的三指针 start / finish / end_of_storage 只是内存来自文件映射
+--- 文件布局: 4096 字节文件头 (魔数 / 元素大小 / 元素个数) + 元素数组 数组按页对齐
+--- 打开已有文件只需 mmap 并检查文件头 不解析也不拷贝数据 启动时间与文件大小无关
+--- 扩容: ftruncate 加长文件 + mremap 扩大映射 (Linux 上可以原地扩展 否则换地址 数据不拷贝)
+--- 文件头中的元素个数在 sync() / close() 时写入 进程崩溃时丢失的只是上次 sync 之后追加的元素
+--- close() 时把文件截到实际大小 多出的容量不占磁盘
+--- 只支持可平凡拷贝的元素 (按字节存取 不调用构造/析构)
+*/
+
+// 打开方式
+enum class MapMode
+{
+    ReadOnly,       // 文件必须存在 只读映射 修改操作抛出 std::logic_error
+    ReadWrite,      // 文件存在则打开 不存在则新建
+    Truncate,       // 新建 已存在则清空
+};
+
+// 访问模式提示 (madvise)
+enum class MapAdvice
+{
+    Normal,
+    Sequential,     // 顺序扫描 加大预读 读过的页优先回收
+    Random,         // 随机访问 关闭预读
+    WillNeed,       // 马上要用 后台预读整个映射
+    DontNeed,       // 暂时不用 允许回收
+    HugePage,       // 使用透明大页 文件映射是否支持取决于文件系统 (tmpfs 支持)
+};
+
+template<typename T, typename GrowthPolicy = GrowDouble>
+class MappedVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "MappedVector requires a trivially copyable element type");
+
+public:
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = const T*;
+    using iterator          = T*;
+    using const_iterator    = const T*;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = std::size_t;
+
+    // 文件头占一页 元素数组从页边界开始
+    static constexpr size_type header_bytes = 4096;
+    static_assert(alignof(T) <= header_bytes, "element alignment exceeds page size");
+
+private:
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t elem_size;
+        std::uint64_t size;             // 元素个数 sync / close 时更新
+    };
+
+    int fd;
+    void* base;                         // 映射起点 (文件头)
+    size_type mapped_bytes;             // 映射长度 = 文件长度
+    bool readonly;
+
+    iterator start;
+    iterator finish;                    // 最后一个数据后的地址
+    iterator end_of_storage;            // 映射中最后一个元素位置之后
+
+    Header* header() const
+    { return static_cast<Header*>(base); }
+
+    // 超过 max_size() 时抛出 std::length_error 乘法不会溢出
+    static size_type bytes_for(size_type capacity)
+    {
+        if(capacity > max_size())
+            throw std::length_error("MappedVector:: capacity exceeds max_size()!");
+        return header_bytes + capacity * sizeof(T);
+    }
+
+    size_type next_capacity(size_type required) const
+    { return GrowthPolicy::next_capacity(capacity(), required, sizeof(value_type)); }
+
+    // 把文件和映射调整为 new_capacity 个元素 (可增可减) 元素个数不变
+    void remap(size_type new_capacity);
+    // 修改前检查
+    void check_writable() const;
+    // 把三指针指向 base 中的数组
+    void set_pointers(size_type size, size_type capacity);
+    void reset_state();
+
+    [[noreturn]] static void throw_errno(const char* what);
+
+public:
+    // ---------------------- 构造函数 --------------------------
+    MappedVector()
+    : fd(-1), base(nullptr), mapped_bytes(0), readonly(false),
+      start(nullptr), finish(nullptr), end_of_storage(nullptr) {}
+    // 打开 (或新建) path
+    explicit MappedVector(const std::string& path, MapMode mode = MapMode::ReadWrite);
+    // 持有文件和映射 只能移动
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+    MappedVector(MappedVector&& other) noexcept;
+    MappedVector& operator=(MappedVector&& rhs) noexcept;
+
+    // ------------------------- 文件 ---------------------------
+    // 已打开时先关闭 文件不存在 / 格式不符 / 元素大小不符时抛出异常
+    void open(const std::string& path, MapMode mode = MapMode::ReadWrite);
+    // 写回元素个数 截掉多余容量 解除映射 不抛出异常
+    void close() noexcept;
+    // 写回元素个数 并把脏页刷到磁盘 (wait = false 时只发起写回)
+    void sync(bool wait = true);
+    // 访问模式提示 系统不支持时返回 false
+    bool advise(MapAdvice advice);
+
+    bool is_open() const
+    { return base != nullptr; }
+    bool read_only() const
+    { return readonly; }
+
+    // ------------------------- 常用方法 ------------------------
+    size_type size() const
+    { return finish - start; }
+
+    size_type capacity() const
+    { return end_of_storage - start; }
+
+    bool empty() const
+    { return start == finish; }
+
+    // 文件长度 (off_t) 和映射长度 (size_t) 都要容得下 文件头 + 元素数组
+    static size_type max_size() noexcept
+    {
+        constexpr std::uint64_t max_bytes = std::uint64_t(std::numeric_limits<off_t>::max()) < SIZE_MAX
+            ? std::uint64_t(std::numeric_limits<off_t>::max()) : SIZE_MAX;
+        return static_cast<size_type>((max_bytes - header_bytes) / sizeof(T));
+    }
+
+    iterator begin()
+    { return start; }
+    iterator end()
+    { return finish; }
+    const_iterator begin() const
+    { return start; }
+    const_iterator end() const
+    { return finish; }
+
+    // 扩容 (加长文件)
+    void reserve(size_type n);
+    // 容量 = 元素个数 (截短文件)
+    void shrink_to_fit();
+    void clear();
+
+    // 新增元素值初始化 / 拷贝 value
+    void resize(size_type n);
+    void resize(size_type n, const value_type& value);
+
+    void push_back(const value_type& value);
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+    void pop_back();
+
+    // 尾部追加 n 个元素 一次扩容 按字节拷贝
+    void append(const value_type* first, size_type n);
+
+    // --------------------------- 访问 --------------------------
+    reference operator[](size_type n)
+    { return start[n]; }
+    const_reference operator[](size_type n) const
+    { return start[n]; }
+    reference at(size_type n);
+    const_reference at(size_type n) const;
+
+    reference front()
+    { return *start; }
+    const_reference front() const
+    { return *start; }
+    reference back()
+    { return *(finish - 1); }
+    const_reference back() const
+    { return *(finish - 1); }
+
+    pointer data() noexcept
+    { return start; }
+    const_pointer data() const noexcept
+    { return start; }
+
+    ~MappedVector();
+};
+
+#include "MappedVector.cpp"
+
+#endif // YXY__STL__MAPPED_VECTOR_H
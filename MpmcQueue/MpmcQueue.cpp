@@ -0,0 +1,177 @@
+#include "MpmcQueue.h"
+
+template<typename T, typename Alloc>
+typename MpmcQueue<T, Alloc>::size_type MpmcQueue<T, Alloc>::round_up(size_type n)
+{
+    // 超过最大的 2 的幂时 c <<= 1 会溢出成 0 循环不会结束
+    if(n > (~size_type(0) >> 1) + 1)
+        throw std::length_error("MpmcQueue:: capacity exceeds the largest power of two!");
+    size_type c = 2;
+    while(c < n)
+        c <<= 1;
+    return c;
+}
+
+template<typename T, typename Alloc>
+MpmcQueue<T, Alloc>::MpmcQueue(size_type capacity, const Alloc& alloc)
+: allocator(alloc)
+{
+    size_type c = round_up(capacity);
+    cells = allocator.allocate(c);
+    mask = c - 1;
+    for(size_type i = 0;i<c;++i)
+        ::new(static_cast<void*>(&cells[i].seq)) std::atomic<size_type>(i);
+}
+
+template<typename T, typename Alloc>
+MpmcQueue<T, Alloc>::~MpmcQueue()
+{
+    // 此时已没有其他线程访问 [dequeue_pos, enqueue_pos) 都是已写入的元素
+    size_type head = dequeue_pos.load(std::memory_order_relaxed);
+    size_type tail = enqueue_pos.load(std::memory_order_relaxed);
+    for(;head != tail;++head)
+        cells[head & mask].value()->~T();
+    allocator.deallocate(cells, mask + 1);
+}
+
+template<typename T, typename Alloc>
+typename MpmcQueue<T, Alloc>::size_type MpmcQueue<T, Alloc>::size_approx() const
+{
+    size_type head = dequeue_pos.load(std::memory_order_acquire);
+    size_type tail = enqueue_pos.load(std::memory_order_acquire);
+    // 两次读取之间消费者可能越过读到的 tail
+    return tail > head ? tail - head : 0;
+}
+
+template<typename T, typename Alloc>
+template<bool Produce>
+typename MpmcQueue<T, Alloc>::size_type MpmcQueue<T, Alloc>::claim(size_type n, size_type& pos)
+{
+    std::atomic<size_type>& counter = Produce ? enqueue_pos : dequeue_pos;
+    // 位置 p 可写时序号为 p 可读时为 p + 1
+    const size_type expect = Produce ? 0 : 1;
+    pos = counter.load(std::memory_order_relaxed);
+    while(true)
+    {
+        size_type k = 0;
+        std::ptrdiff_t diff = 0;
+        for(;k<n;++k)
+        {
+            size_type seq = cells[(pos + k) & mask].seq.load(std::memory_order_acquire);
+            diff = static_cast<std::ptrdiff_t>(seq - (pos + k + expect));
+            if(diff != 0)
+                break;
+        }
+        if(k == 0)
+        {
+            // 序号落后: 上一圈的元素还没被取走 (满) / 还没写入 (空)
+            if(diff < 0)
+                return 0;
+            // 序号超前: pos 已被其他线程抢走
+            pos = counter.load(std::memory_order_relaxed);
+            continue;
+        }
+        // 失败时 pos 更新为最新值 重新数
+        if(counter.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+            return k;
+    }
+}
+
+template<typename T, typename Alloc>
+template<typename... Args>
+bool MpmcQueue<T, Alloc>::try_emplace(Args&&... args)
+{
+    // 先在队列外构造 构造抛异常时队列不受影响
+    T tmp(std::forward<Args>(args)...);
+    return try_push(std::move(tmp));
+}
+
+template<typename T, typename Alloc>
+bool MpmcQueue<T, Alloc>::try_push(const value_type& value)
+{
+    if constexpr(std::is_nothrow_copy_constructible<T>::value)
+    {
+        size_type pos;
+        if(!claim<true>(1, pos))
+            return false;
+        Cell& c = cells[pos & mask];
+        ::new(static_cast<void*>(c.storage)) T(value);
+        c.seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+    else
+    {
+        T tmp(value);
+        return try_push(std::move(tmp));
+    }
+}
+
+template<typename T, typename Alloc>
+bool MpmcQueue<T, Alloc>::try_push(value_type&& value)
+{
+    size_type pos;
+    if(!claim<true>(1, pos))
+        return false;
+    Cell& c = cells[pos & mask];
+    ::new(static_cast<void*>(c.storage)) T(std::move(value));
+    c.seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Alloc>
+typename MpmcQueue<T, Alloc>::size_type MpmcQueue<T, Alloc>::push_n(const value_type* first, size_type n)
+{
+    // 拷贝可能抛异常时不能整批抢占 逐个入队
+    if constexpr(!std::is_nothrow_copy_constructible<T>::value)
+    {
+        size_type i = 0;
+        while(i < n && try_push(first[i]))
+            ++i;
+        return i;
+    }
+    else
+    {
+        if(n == 0)
+            return 0;
+        size_type pos;
+        size_type k = claim<true>(n, pos);
+        for(size_type i = 0;i<k;++i)
+        {
+            Cell& c = cells[(pos + i) & mask];
+            ::new(static_cast<void*>(c.storage)) T(first[i]);
+            c.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        return k;
+    }
+}
+
+template<typename T, typename Alloc>
+bool MpmcQueue<T, Alloc>::try_pop(value_type& out)
+{
+    size_type pos;
+    if(!claim<false>(1, pos))
+        return false;
+    Cell& c = cells[pos & mask];
+    out = std::move(*c.value());
+    c.value()->~T();
+    // 下一圈同一位置的生产者等的序号
+    c.seq.store(pos + mask + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Alloc>
+typename MpmcQueue<T, Alloc>::size_type MpmcQueue<T, Alloc>::pop_n(value_type* out, size_type n)
+{
+    if(n == 0)
+        return 0;
+    size_type pos;
+    size_type k = claim<false>(n, pos);
+    for(size_type i = 0;i<k;++i)
+    {
+        Cell& c = cells[(pos + i) & mask];
+        out[i] = std::move(*c.value());
+        c.value()->~T();
+        c.seq.store(pos + i + mask + 1, std::memory_order_release);
+    }
+    return k;
+}
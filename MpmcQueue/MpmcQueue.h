@@ -0,0 +1,87 @@
+#ifndef YXY__STL__MPMC_QUEUE_H
+#define YXY__STL__MPMC_QUEUE_H
+
+#include "../allocator.h"
+#include<atomic>
+#include<cstddef>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+
+/*
+--- 多生产者多消费者有界无锁队列 (Vyukov 算法)
+--- 每个槽位带一个序号: 序号 == 位置 表示空闲可写 序号 == 位置 + 1 表示已写入可读
+--- 生产者 / 消费者各自用 CAS 抢占 enqueue_pos / dequeue_pos 抢到后独占该槽位 写完再发布序号
+--- 两个位置计数器各占一条缓存行 生产者之间和消费者之间竞争 但生产者与消费者互不干扰
+--- push_n / pop_n 先数出从当前位置起连续可用的槽位 一次 CAS 抢下整批
+--- 槽位被抢占后不能退还 所以元素的移动构造 / 移动赋值不能抛异常
+--- 拷贝入队先在队列外拷贝一份 再移动进槽位
+*/
+template<typename T, typename Alloc = Allocator<T>>
+class MpmcQueue
+{
+    static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+                  "MpmcQueue requires nothrow move construction and assignment");
+
+public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+
+private:
+    struct Cell
+    {
+        std::atomic<size_type> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value()
+        { return reinterpret_cast<T*>(storage); }
+    };
+    using cell_alloc_type = typename Alloc::template rebind<Cell>::other;
+
+    // 生产者与消费者的位置计数器分占两条缓存行
+    alignas(64) std::atomic<size_type> enqueue_pos{0};
+    alignas(64) std::atomic<size_type> dequeue_pos{0};
+
+    // 以下构造后只读
+    alignas(64) Cell* cells;
+    size_type mask;
+    cell_alloc_type allocator;
+
+    static size_type round_up(size_type n);
+
+    // 抢占从 pos 起最多 n 个连续可写 (Produce) / 可读 (!Produce) 的槽位 返回抢到的个数和起点
+    template<bool Produce>
+    size_type claim(size_type n, size_type& pos);
+
+public:
+    // 容量向上取整到 2 的幂 (至少 2) 超过 SIZE_MAX / 2 + 1 时抛出 std::length_error
+    explicit MpmcQueue(size_type capacity, const Alloc& alloc = Alloc());
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+    ~MpmcQueue();
+
+    size_type capacity() const
+    { return mask + 1; }
+
+    // 元素个数的近似值 (并发修改中只作参考)
+    size_type size_approx() const;
+    bool empty_approx() const
+    { return size_approx() == 0; }
+
+    // 队列满时返回 false 参数不被移动
+    bool try_push(const value_type& value);
+    bool try_push(value_type&& value);
+    template<typename... Args>
+    bool try_emplace(Args&&... args);
+    // 尽量多地拷贝 [first, first + n) 一次抢占 返回实际入队个数
+    size_type push_n(const value_type* first, size_type n);
+
+    // 队列空时返回 false
+    bool try_pop(value_type& out);
+    // 最多取 n 个移动到 out 一次抢占 返回实际出队个数
+    size_type pop_n(value_type* out, size_type n);
+};
+
+#include "MpmcQueue.cpp"
+
+#endif // YXY__STL__MPMC_QUEUE_H
@@ -0,0 +1,301 @@
+#include "SmallVector.h"
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+void SmallVector<T, N, Alloc, GrowthPolicy>::release()
+{
+    destroy_range(allocator, start, finish);
+    if(!is_inline())
+        allocator.deallocate(start, capacity());
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+AllocationResult<typename SmallVector<T, N, Alloc, GrowthPolicy>::pointer> SmallVector<T, N, Alloc, GrowthPolicy>::allocate_storage(size_type n)
+{
+    if constexpr(allocator_has_allocate_at_least<Alloc>::value)
+        return allocator.allocate_at_least(n);
+    else
+        return {allocator.allocate(n), n};
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+void SmallVector<T, N, Alloc, GrowthPolicy>::take(SmallVector& other)
+{
+    if(!other.is_inline())
+    {
+        // 堆内存直接转移
+        start = other.start;
+        finish = other.finish;
+        end_of_storage = other.end_of_storage;
+    }
+    else
+    {
+        // 内部缓冲区只能逐个搬运
+        reset_inline();
+        finish = uninitialized_relocate(allocator, other.start, other.finish, start);
+    }
+    other.reset_inline();
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+SmallVector<T, N, Alloc, GrowthPolicy>::SmallVector(size_type capacity)
+{
+    reset_inline();
+    try
+    {
+        reserve(capacity);
+        for(size_type i = 0;i<capacity;++i)
+        {
+            allocator.construct(finish);
+            ++finish;
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+SmallVector<T, N, Alloc, GrowthPolicy>::SmallVector(size_type capacity, const value_type& value)
+{
+    reset_inline();
+    try
+    {
+        reserve(capacity);
+        for(size_type i = 0;i<capacity;++i)
+        {
+            allocator.construct(finish, value);
+            ++finish;
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+SmallVector<T, N, Alloc, GrowthPolicy>::SmallVector(std::initializer_list<value_type> il)
+{
+    reset_inline();
+    try
+    {
+        reserve(il.size());
+        for(const auto& it : il)
+        {
+            allocator.construct(finish, it);
+            ++finish;
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+SmallVector<T, N, Alloc, GrowthPolicy>::SmallVector(const SmallVector& other)
+: allocator(other.allocator)
+{
+    reset_inline();
+    try
+    {
+        reserve(other.size());
+        for(auto it = other.begin();it!=other.end();++it)
+        {
+            allocator.construct(finish, *it);
+            ++finish;
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+SmallVector<T, N, Alloc, GrowthPolicy>::SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+: allocator(other.allocator)
+{
+    take(other);
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+SmallVector<T, N, Alloc, GrowthPolicy>& SmallVector<T, N, Alloc, GrowthPolicy>::operator=(const SmallVector& rhs)
+{
+    if(this != &rhs)
+    {
+        destroy_range(allocator, start, finish);
+        finish = start;
+        reserve(rhs.size());
+        for(auto it = rhs.begin();it!=rhs.end();++it)
+        {
+            allocator.construct(finish, *it);
+            ++finish;
+        }
+    }
+    return *this;
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+SmallVector<T, N, Alloc, GrowthPolicy>& SmallVector<T, N, Alloc, GrowthPolicy>::operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+    if(this != &rhs)
+    {
+        release();
+        allocator = rhs.allocator;
+        take(rhs);
+    }
+    return *this;
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+void SmallVector<T, N, Alloc, GrowthPolicy>::reserve(size_type n)
+{
+    if(n <= capacity())
+        return;
+
+    // 分配器多给的空间也计入容量
+    AllocationResult<pointer> block = allocate_storage(n);
+    pointer new_start = block.ptr;
+    pointer new_finish;
+    try
+    {
+        new_finish = uninitialized_relocate(allocator, start, finish, new_start);
+    }
+    catch(...)
+    {
+        allocator.deallocate(new_start, block.count);
+        throw;
+    }
+
+    if(!is_inline())
+        allocator.deallocate(start, capacity());
+
+    start = new_start;
+    finish = new_finish;
+    end_of_storage = new_start + block.count;
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+void SmallVector<T, N, Alloc, GrowthPolicy>::push_back(const value_type& value)
+{
+    emplace_back(value);
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+void SmallVector<T, N, Alloc, GrowthPolicy>::push_back(value_type&& value)
+{
+    emplace_back(std::move(value));
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+template<typename... Args>
+void SmallVector<T, N, Alloc, GrowthPolicy>::emplace_back(Args&&... args)
+{
+    if(finish == end_of_storage)
+    {
+        // 扩容 - 参数可能引用容器内元素 先构造出来
+        value_type tmp(std::forward<Args>(args)...);
+        reserve(next_capacity(size() + 1));
+        allocator.construct(finish, std::move(tmp));
+    }
+    else
+        allocator.construct(finish, std::forward<Args>(args)...);
+    ++finish;
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+void SmallVector<T, N, Alloc, GrowthPolicy>::pop_back()
+{
+    if(empty())
+        return;
+
+    allocator.destroy(--finish);
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::iterator SmallVector<T, N, Alloc, GrowthPolicy>::insert(const_iterator pos, const value_type& value)
+{
+    return emplace(pos, value);
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::iterator SmallVector<T, N, Alloc, GrowthPolicy>::insert(const_iterator pos, value_type&& value)
+{
+    return emplace(pos, std::move(value));
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+template<typename... Args>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::iterator SmallVector<T, N, Alloc, GrowthPolicy>::emplace(const_iterator pos, Args&&... args)
+{
+    size_type n = pos - start;
+    if(start + n == finish && finish != end_of_storage)
+    {
+        allocator.construct(finish, std::forward<Args>(args)...);
+        ++finish;
+        return start + n;
+    }
+
+    // 参数可能引用容器内的元素 先构造出新元素再挪动/扩容
+    value_type tmp(std::forward<Args>(args)...);
+    if(finish == end_of_storage)
+        reserve(next_capacity(size() + 1));
+    return insert_value(n, std::move(tmp));
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::iterator SmallVector<T, N, Alloc, GrowthPolicy>::insert_value(size_type n, value_type&& value)
+{
+    iterator p = start + n;
+    finish = relocate_insert(allocator, p, finish, std::move(value));
+    return p;
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::iterator SmallVector<T, N, Alloc, GrowthPolicy>::erase(const_iterator pos)
+{
+    if(pos < start || pos >= finish)
+        return start + (pos - start);
+    return erase(pos, pos + 1);
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::iterator SmallVector<T, N, Alloc, GrowthPolicy>::erase(const_iterator first, const_iterator last)
+{
+    if(last <= first || last > finish || first < start)
+        return start + (first - start);
+
+    iterator p = start + (first - start);
+    finish = relocate_erase(allocator, p, p + (last - first), finish);
+    return p;
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::reference SmallVector<T, N, Alloc, GrowthPolicy>::at(size_type n)
+{
+    if(n >= size())
+        throw std::out_of_range("SmallVector:: index out of range!");
+
+    return *(start + n);
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::const_reference SmallVector<T, N, Alloc, GrowthPolicy>::at(size_type n) const
+{
+    if(n >= size())
+        throw std::out_of_range("SmallVector:: index out of range!");
+
+    return *(start + n);
+}
+
+template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+SmallVector<T, N, Alloc, GrowthPolicy>::~SmallVector()
+{
+    release();
+}
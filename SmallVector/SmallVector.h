@@ -0,0 +1,169 @@
+#ifndef YXY__STL__SMALL_VECTOR_H
+#define YXY__STL__SMALL_VECTOR_H
+
+#include "../allocator.h"
+#include "../relocate.h"
+#include "../Vector/growth_policy.h"
+#include<memory>
+#include<initializer_list>
+#include<stdexcept>
+
+/*
+--- 前 N 个元素放在对象内部的缓冲区 (small buffer) 不申请堆内存
+--- 超过 N 个时整体搬到 Alloc 分配的堆内存 之后与 Vector 相同 (按 GrowthPolicy 扩容 默认 2 倍)
+--- 接口与 Vector 保持一致 可以直接替换
+--- 注意: 元素在内部缓冲区时 移动 SmallVector 会逐个搬运元素 迭代器随之失效
+*/
+template<typename T, std::size_t N, typename Alloc = Allocator<T>, typename GrowthPolicy = GrowDouble>
+class SmallVector
+{
+    static_assert(N > 0, "SmallVector: inline capacity must be positive");
+
+public:
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = const T*;
+    using iterator          = T*;
+    using const_iterator    = const T*;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = std::size_t;
+
+private:
+    iterator start;
+    iterator finish;                    // 最后一个数据后的地址
+    iterator end_of_storage;            // 最后一个内存地址
+
+    Alloc allocator;
+
+    // 内部缓冲区 未初始化
+    alignas(T) unsigned char buffer[N * sizeof(T)];
+
+    pointer inline_data()
+    { return reinterpret_cast<pointer>(buffer); }
+
+    // 回到空的内部缓冲区状态 (不析构 不释放)
+    void reset_inline()
+    {
+        start = inline_data();
+        finish = start;
+        end_of_storage = start + N;
+    }
+
+    // 按扩容策略计算 至少容纳 required 个元素的新容量
+    size_type next_capacity(size_type required) const
+    { return GrowthPolicy::next_capacity(capacity(), required, sizeof(value_type)); }
+
+    // 申请至少 n 个元素的内存 分配器支持 allocate_at_least 时按整块实际大小返回
+    AllocationResult<pointer> allocate_storage(size_type n);
+
+    // 析构所有元素 释放堆内存
+    void release();
+
+    // 从 other 接管元素 (other 在堆上时直接拿走指针 否则逐个搬运) other 变为空
+    void take(SmallVector& other);
+
+    // 容量足够时在下标 n 处插入已构造好的元素
+    iterator insert_value(size_type n, value_type&& value);
+
+public:
+    // ---------------------- 构造函数 --------------------------
+    SmallVector()
+    { reset_inline(); }
+    // 指定分配器
+    explicit SmallVector(const Alloc& alloc)
+    : allocator(alloc)
+    { reset_inline(); }
+    // 容量
+    SmallVector(size_type capacity);
+    // 容量 + 初值
+    SmallVector(size_type capacity, const value_type& value);
+    // 参数列表
+    SmallVector(std::initializer_list<value_type> il);
+    // 拷贝
+    SmallVector(const SmallVector& other);
+    // 移动
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    // ------------------------- 常用方法 ------------------------
+    size_type size() const
+    { return finish - start; }
+
+    size_type capacity() const
+    { return end_of_storage - start; }
+
+    bool empty() const
+    { return start == finish; }
+
+    // 元素是否仍在内部缓冲区
+    bool is_inline() const
+    { return start == reinterpret_cast<const_pointer>(buffer); }
+
+    iterator begin() const
+    { return start; }
+
+    iterator end() const
+    { return finish; }
+
+    Alloc get_allocator() const
+    { return allocator; }
+
+    // 赋值
+    SmallVector& operator=(const SmallVector& rhs);
+    SmallVector& operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    // 扩容
+    void reserve(size_type n);
+
+    // 尾插 - 左值: 拷贝
+    void push_back(const value_type& value);
+
+    // 尾插 - 右值: 移动
+    void push_back(value_type&& value);
+
+    // 尾插 - 无临时对象
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+
+    // 尾出
+    void pop_back();
+
+    // 插入  拷贝/移动
+    iterator insert(const_iterator pos, const value_type& value);
+    iterator insert(const_iterator pos, value_type&& value);
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+
+    // 删除 返回删除位置迭代器
+    iterator erase(const_iterator pos);
+    // 区间删除
+    iterator erase(const_iterator first, const_iterator last);
+
+    // --------------------------- 访问 --------------------------
+    reference operator[](size_type n)
+    { return *(start + n); }
+    const_reference operator[](size_type n) const
+    { return *(start + n); }
+    reference at(size_type n);
+    const_reference at(size_type n) const;
+
+    reference front()
+    { return *start; }
+    const_reference front() const
+    { return *start; }
+    reference back()
+    { return *(finish - 1); }
+    const_reference back() const
+    { return *(finish - 1); }
+
+    pointer data() noexcept
+    { return start; }
+    const_pointer data() const noexcept
+    { return start; }
+
+    ~SmallVector();
+};
+
+#include "SmallVector.cpp"
+
+#endif // YXY__STL__SMALL_VECTOR_H
@@ -0,0 +1,349 @@
+#include "SoaVector.h"
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+typename BasicSoaVector<Alloc, GrowthPolicy, Fields...>::columns_type
+BasicSoaVector<Alloc, GrowthPolicy, Fields...>::allocate_columns(size_type n)
+{
+    columns_type cols;
+    size_type done = 0;
+    try
+    {
+        for_each_column([&](auto ic)
+        {
+            constexpr size_type I = decltype(ic)::value;
+            std::get<I>(cols) = get_column_allocator<I>().allocate(n);
+            ++done;
+        });
+    }
+    catch(...)
+    {
+        for_each_column([&](auto ic)
+        {
+            constexpr size_type I = decltype(ic)::value;
+            if(I < done)
+                get_column_allocator<I>().deallocate(std::get<I>(cols), n);
+        });
+        throw;
+    }
+    return cols;
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::deallocate_columns(columns_type& cols, size_type n)
+{
+    for_each_column([&](auto ic)
+    {
+        constexpr size_type I = decltype(ic)::value;
+        get_column_allocator<I>().deallocate(std::get<I>(cols), n);
+        std::get<I>(cols) = nullptr;
+    });
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::destroy_rows(columns_type& cols, size_type first, size_type last)
+{
+    for_each_column([&](auto ic)
+    {
+        constexpr size_type I = decltype(ic)::value;
+        column_alloc<I> a = get_column_allocator<I>();
+        destroy_range(a, std::get<I>(cols) + first, std::get<I>(cols) + last);
+    });
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+template<std::size_t... Is, typename... Args>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::construct_row(columns_type& cols, size_type i,
+                                                                  std::index_sequence<Is...>, Args&&... args)
+{
+    size_type built = 0;
+    try
+    {
+        ((get_column_allocator<Is>().construct(std::get<Is>(cols) + i, std::forward<Args>(args)), ++built), ...);
+    }
+    catch(...)
+    {
+        for_each_column([&](auto ic)
+        {
+            constexpr size_type I = decltype(ic)::value;
+            if(I < built)
+                get_column_allocator<I>().destroy(std::get<I>(cols) + i);
+        });
+        throw;
+    }
+}
+
+// 先拷贝 移动构造可能抛异常的列 (源数据不变 失败时析构已拷贝的列即可)
+// 全部成功后再搬运其余的列: 可平凡搬运时整段 memcpy 否则逐个移动构造 都不会抛异常
+// 分支在编译期选定 只能移动的列 (如 std::unique_ptr) 不会实例化拷贝
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::relocate_rows(columns_type& dest)
+{
+    size_type done = 0;
+    try
+    {
+        for_each_column([&](auto ic)
+        {
+            constexpr size_type I = decltype(ic)::value;
+            using T = column_type<I>;
+            if constexpr(!is_trivially_relocatable<T>::value && !std::is_nothrow_move_constructible<T>::value)
+            {
+                column_alloc<I> a = get_column_allocator<I>();
+                T* src = std::get<I>(columns);
+                uninitialized_copy_range(a, src, src + count, std::get<I>(dest));
+            }
+            ++done;
+        });
+    }
+    catch(...)
+    {
+        for_each_column([&](auto ic)
+        {
+            constexpr size_type I = decltype(ic)::value;
+            using T = column_type<I>;
+            if constexpr(!is_trivially_relocatable<T>::value && !std::is_nothrow_move_constructible<T>::value)
+            {
+                if(I < done)
+                {
+                    column_alloc<I> a = get_column_allocator<I>();
+                    destroy_range(a, std::get<I>(dest), std::get<I>(dest) + count);
+                }
+            }
+        });
+        throw;
+    }
+    for_each_column([&](auto ic)
+    {
+        constexpr size_type I = decltype(ic)::value;
+        using T = column_type<I>;
+        column_alloc<I> a = get_column_allocator<I>();
+        T* src = std::get<I>(columns);
+        if constexpr(is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value)
+            uninitialized_relocate(a, src, src + count, std::get<I>(dest));
+        else
+            destroy_range(a, src, src + count);
+    });
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::reallocate(size_type n)
+{
+    columns_type cols = n ? allocate_columns(n) : columns_type();
+    try
+    {
+        relocate_rows(cols);
+    }
+    catch(...)
+    {
+        if(n)
+            deallocate_columns(cols, n);
+        throw;
+    }
+    if(cap)
+        deallocate_columns(columns, cap);
+    columns = cols;
+    cap = n;
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+template<typename... Args>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::realloc_emplace_back(Args&&... args)
+{
+    size_type n = GrowthPolicy::next_capacity(cap, count + 1, (sizeof(Fields) + ...));
+    columns_type cols = allocate_columns(n);
+    try
+    {
+        construct_row(cols, count, indices(), std::forward<Args>(args)...);
+        try
+        {
+            relocate_rows(cols);
+        }
+        catch(...)
+        {
+            destroy_rows(cols, count, count + 1);
+            throw;
+        }
+    }
+    catch(...)
+    {
+        deallocate_columns(cols, n);
+        throw;
+    }
+    if(cap)
+        deallocate_columns(columns, cap);
+    columns = cols;
+    cap = n;
+    ++count;
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::release()
+{
+    if(!cap)
+        return;
+    destroy_rows(columns, 0, count);
+    deallocate_columns(columns, cap);
+    count = 0;
+    cap = 0;
+}
+
+// ---------------------- 构造函数 --------------------------
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+BasicSoaVector<Alloc, GrowthPolicy, Fields...>::BasicSoaVector(const BasicSoaVector& other)
+: count(0), cap(0), allocator(other.allocator)
+{
+    if(other.count == 0)
+        return;
+    columns = allocate_columns(other.count);
+    cap = other.count;
+    size_type done = 0;
+    try
+    {
+        for_each_column([&](auto ic)
+        {
+            constexpr size_type I = decltype(ic)::value;
+            column_alloc<I> a = get_column_allocator<I>();
+            const column_type<I>* src = std::get<I>(other.columns);
+            uninitialized_copy_range(a, src, src + other.count, std::get<I>(columns));
+            ++done;
+        });
+    }
+    catch(...)
+    {
+        for_each_column([&](auto ic)
+        {
+            constexpr size_type I = decltype(ic)::value;
+            if(I < done)
+            {
+                column_alloc<I> a = get_column_allocator<I>();
+                destroy_range(a, std::get<I>(columns), std::get<I>(columns) + other.count);
+            }
+        });
+        deallocate_columns(columns, cap);
+        throw;
+    }
+    count = other.count;
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+BasicSoaVector<Alloc, GrowthPolicy, Fields...>::BasicSoaVector(BasicSoaVector&& other) noexcept
+: columns(other.columns), count(other.count), cap(other.cap), allocator(other.allocator)
+{
+    other.columns = columns_type();
+    other.count = 0;
+    other.cap = 0;
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+BasicSoaVector<Alloc, GrowthPolicy, Fields...>&
+BasicSoaVector<Alloc, GrowthPolicy, Fields...>::operator=(const BasicSoaVector& rhs)
+{
+    if(this != &rhs)
+    {
+        BasicSoaVector tmp(rhs);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+BasicSoaVector<Alloc, GrowthPolicy, Fields...>&
+BasicSoaVector<Alloc, GrowthPolicy, Fields...>::operator=(BasicSoaVector&& rhs) noexcept
+{
+    if(this != &rhs)
+    {
+        release();
+        swap(rhs);
+    }
+    return *this;
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+BasicSoaVector<Alloc, GrowthPolicy, Fields...>::~BasicSoaVector()
+{
+    release();
+}
+
+// ------------------------- 常用方法 ------------------------
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::reserve(size_type n)
+{
+    if(n > cap)
+        reallocate(n);
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::shrink_to_fit()
+{
+    if(count < cap)
+        reallocate(count);
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::clear()
+{
+    destroy_rows(columns, 0, count);
+    count = 0;
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::resize(size_type n)
+{
+    if(n < count)
+    {
+        destroy_rows(columns, n, count);
+        count = n;
+        return;
+    }
+    reserve(n);
+    for(;count < n;++count)
+        construct_row(columns, count, indices(), Fields()...);
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+template<typename... Args>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::emplace_back(Args&&... args)
+{
+    static_assert(sizeof...(Args) == sizeof...(Fields), "SoaVector::emplace_back: one argument per column");
+    if(count < cap)
+    {
+        construct_row(columns, count, indices(), std::forward<Args>(args)...);
+        ++count;
+    }
+    else
+        realloc_emplace_back(std::forward<Args>(args)...);
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::pop_back()
+{
+    --count;
+    destroy_rows(columns, count, count + 1);
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Alloc, GrowthPolicy, Fields...>::swap(BasicSoaVector& other) noexcept
+{
+    std::swap(columns, other.columns);
+    std::swap(count, other.count);
+    std::swap(cap, other.cap);
+    std::swap(allocator, other.allocator);
+}
+
+// --------------------------- 访问 --------------------------
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+typename BasicSoaVector<Alloc, GrowthPolicy, Fields...>::reference
+BasicSoaVector<Alloc, GrowthPolicy, Fields...>::at(size_type n)
+{
+    if(n >= count)
+        throw std::out_of_range("SoaVector:: index out of range!");
+    return (*this)[n];
+}
+
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+typename BasicSoaVector<Alloc, GrowthPolicy, Fields...>::const_reference
+BasicSoaVector<Alloc, GrowthPolicy, Fields...>::at(size_type n) const
+{
+    if(n >= count)
+        throw std::out_of_range("SoaVector:: index out of range!");
+    return (*this)[n];
+}
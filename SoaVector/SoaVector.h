@@ -0,0 +1,240 @@
+#ifndef YXY__STL__SOA_VECTOR_H
+#define YXY__STL__SOA_VECTOR_H
+
+#include "../allocator.h"
+#include "../relocate.h"
+#include "../Vector/growth_policy.h"
+#include<cstddef>
+#include<cstring>
+#include<stdexcept>
+#include<tuple>
+#include<type_traits>
+#include<utility>
+
+/*
+--- 列式存储 (structure of arrays): 每个字段一段独立的连续数组 下标相同的各列元素组成一行
+--- 只扫描一个字段的循环只读这一列 不会把整条记录带进缓存
+--- column<I>() / data<I>() 给出第 I 列的连续内存 可以直接交给 simd_sum / simd_find 等
+--- 各列经由 Alloc 的 rebind 分别申请 容量相同 按 GrowthPolicy 一起扩容
+--- 扩容时先在新内存构造好所有列 再析构旧元素 任何一列抛异常时容器不变
+--- 扩容后所有列的指针 / 引用失效 (与 Vector 相同)
+*/
+
+// 一列的连续区间 (不拥有内存) 提供 begin / end / size / operator[]
+template<typename T>
+class SoaSpan
+{
+public:
+    using value_type    = typename std::remove_const<T>::type;
+    using pointer       = T*;
+    using reference     = T&;
+    using iterator      = T*;
+    using size_type     = std::size_t;
+
+    SoaSpan() : first(nullptr), count(0) {}
+    SoaSpan(pointer p, size_type n) : first(p), count(n) {}
+
+    pointer data() const
+    { return first; }
+    size_type size() const
+    { return count; }
+    bool empty() const
+    { return count == 0; }
+    iterator begin() const
+    { return first; }
+    iterator end() const
+    { return first + count; }
+    reference operator[](size_type i) const
+    { return first[i]; }
+
+private:
+    pointer first;
+    size_type count;
+};
+
+// Alloc 可以是任意元素类型的分配器 每列按自己的字段类型 rebind
+template<typename Alloc, typename GrowthPolicy, typename... Fields>
+class BasicSoaVector
+{
+    static_assert(sizeof...(Fields) > 0, "SoaVector: at least one field is required");
+
+public:
+    using size_type         = std::size_t;
+    using allocator_type    = Alloc;
+    // 一行的值 / 对一行各字段的引用
+    using value_type        = std::tuple<Fields...>;
+    using reference         = std::tuple<Fields&...>;
+    using const_reference   = std::tuple<const Fields&...>;
+
+    static constexpr size_type column_count = sizeof...(Fields);
+
+    // 第 I 列的元素类型
+    template<size_type I>
+    using column_type = typename std::tuple_element<I, value_type>::type;
+
+private:
+    template<size_type I>
+    using column_alloc = typename Alloc::template rebind<column_type<I>>::other;
+
+    using columns_type = std::tuple<Fields*...>;
+    using indices = std::index_sequence_for<Fields...>;
+
+    columns_type columns;
+    size_type count;
+    size_type cap;
+
+    Alloc allocator;
+
+    // 依次对每一列调用 f(std::integral_constant<size_type, I>)
+    template<typename F>
+    static void for_each_column(F&& f)
+    { for_each_column(std::forward<F>(f), indices()); }
+    template<typename F, size_type... Is>
+    static void for_each_column(F&& f, std::index_sequence<Is...>)
+    { (f(std::integral_constant<size_type, Is>()), ...); }
+
+    template<size_type I>
+    column_alloc<I> get_column_allocator() const
+    { return column_alloc<I>(allocator); }
+
+    // 为每一列申请 n 个元素的内存 中途失败时释放已申请的列
+    columns_type allocate_columns(size_type n);
+    // 释放 cols 中每列 n 个元素的内存 (不析构)
+    void deallocate_columns(columns_type& cols, size_type n);
+    // 析构 cols 中下标 [first, last) 的所有行
+    void destroy_rows(columns_type& cols, size_type first, size_type last);
+
+    // 在 cols 的第 i 行逐列构造 每个参数构造一列 某列抛异常时析构本行已构造的列
+    template<size_type... Is, typename... Args>
+    void construct_row(columns_type& cols, size_type i, std::index_sequence<Is...>, Args&&... args);
+
+    // 把 [0, count) 行搬到新内存 dest (逐列 移动不抛异常时移动 否则拷贝)
+    // 抛异常时 dest 中已构造的元素被析构 原数据不变
+    void relocate_rows(columns_type& dest);
+
+    // 换到容量为 n 的新内存
+    void reallocate(size_type n);
+
+    // 容量已满时尾插: 先在新内存构造新行 (参数可能引用本容器的元素) 再搬运旧行
+    template<typename... Args>
+    void realloc_emplace_back(Args&&... args);
+
+    // 析构所有元素 释放内存
+    void release();
+
+public:
+    // ---------------------- 构造函数 --------------------------
+    BasicSoaVector()
+    : count(0), cap(0) {}
+    // 指定分配器 (有状态的分配器 如 arena/内存池)
+    explicit BasicSoaVector(const Alloc& alloc)
+    : count(0), cap(0), allocator(alloc) {}
+    // 拷贝
+    BasicSoaVector(const BasicSoaVector& other);
+    // 移动
+    BasicSoaVector(BasicSoaVector&& other) noexcept;
+
+    // 赋值
+    BasicSoaVector& operator=(const BasicSoaVector& rhs);
+    BasicSoaVector& operator=(BasicSoaVector&& rhs) noexcept;
+
+    ~BasicSoaVector();
+
+    // ------------------------- 常用方法 ------------------------
+    size_type size() const
+    { return count; }
+
+    size_type capacity() const
+    { return cap; }
+
+    bool empty() const
+    { return count == 0; }
+
+    Alloc get_allocator() const
+    { return allocator; }
+
+    // 扩容 (所有列)
+    void reserve(size_type n);
+
+    // 释放多余容量 (容量 = 行数)
+    void shrink_to_fit();
+
+    // 清空元素 保留容量
+    void clear();
+
+    // 改变行数 新增行的每个字段值初始化
+    void resize(size_type n);
+
+    // 尾插一行 每列一个值
+    void push_back(const Fields&... values)
+    { emplace_back(values...); }
+    void push_back(Fields&&... values)
+    { emplace_back(std::move(values)...); }
+    void push_back(const value_type& row)
+    { std::apply([this](const Fields&... values) { emplace_back(values...); }, row); }
+
+    // 尾插一行 第 k 个参数用来构造第 k 列
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+
+    // 尾出
+    void pop_back();
+
+    void swap(BasicSoaVector& other) noexcept;
+
+    // --------------------------- 访问 --------------------------
+    // 第 I 列的首地址 / 整列区间 元素个数为 size()
+    template<size_type I>
+    column_type<I>* data() noexcept
+    { return std::get<I>(columns); }
+    template<size_type I>
+    const column_type<I>* data() const noexcept
+    { return std::get<I>(columns); }
+    template<size_type I>
+    SoaSpan<column_type<I>> column() noexcept
+    { return SoaSpan<column_type<I>>(data<I>(), count); }
+    template<size_type I>
+    SoaSpan<const column_type<I>> column() const noexcept
+    { return SoaSpan<const column_type<I>>(data<I>(), count); }
+
+    // 第 n 行第 I 列
+    template<size_type I>
+    column_type<I>& get(size_type n)
+    { return data<I>()[n]; }
+    template<size_type I>
+    const column_type<I>& get(size_type n) const
+    { return data<I>()[n]; }
+
+    // 第 n 行 (各字段的引用) 逐行访问会同时读所有列 只扫一列时用 column<I>()
+    reference operator[](size_type n)
+    { return row(n, indices()); }
+    const_reference operator[](size_type n) const
+    { return row(n, indices()); }
+    reference at(size_type n);
+    const_reference at(size_type n) const;
+
+    reference front()
+    { return (*this)[0]; }
+    const_reference front() const
+    { return (*this)[0]; }
+    reference back()
+    { return (*this)[count - 1]; }
+    const_reference back() const
+    { return (*this)[count - 1]; }
+
+private:
+    template<size_type... Is>
+    reference row(size_type n, std::index_sequence<Is...>)
+    { return reference(std::get<Is>(columns)[n]...); }
+    template<size_type... Is>
+    const_reference row(size_type n, std::index_sequence<Is...>) const
+    { return const_reference(std::get<Is>(columns)[n]...); }
+};
+
+// 默认分配器 / 2 倍扩容
+template<typename... Fields>
+using SoaVector = BasicSoaVector<Allocator<unsigned char>, GrowDouble, Fields...>;
+
+#include "SoaVector.cpp"
+
+#endif // YXY__STL__SOA_VECTOR_H
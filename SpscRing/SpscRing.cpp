@@ -0,0 +1,141 @@
+#include "SpscRing.h"
+
+template<typename T, typename Alloc>
+typename SpscRing<T, Alloc>::size_type SpscRing<T, Alloc>::round_up(size_type n)
+{
+    // 超过最大的 2 的幂时 c <<= 1 会溢出成 0 循环不会结束
+    if(n > (~size_type(0) >> 1) + 1)
+        throw std::length_error("SpscRing:: capacity exceeds the largest power of two!");
+    size_type c = 2;
+    while(c < n)
+        c <<= 1;
+    return c;
+}
+
+template<typename T, typename Alloc>
+SpscRing<T, Alloc>::SpscRing(size_type capacity, const Alloc& alloc)
+: allocator(alloc)
+{
+    size_type c = round_up(capacity);
+    buffer = allocator.allocate(c);
+    mask = c - 1;
+}
+
+template<typename T, typename Alloc>
+SpscRing<T, Alloc>::~SpscRing()
+{
+    size_type head = consumer.head.load(std::memory_order_relaxed);
+    size_type tail = producer.tail.load(std::memory_order_relaxed);
+    for(;head != tail;++head)
+        allocator.destroy(buffer + (head & mask));
+    allocator.deallocate(buffer, mask + 1);
+}
+
+template<typename T, typename Alloc>
+typename SpscRing<T, Alloc>::size_type SpscRing<T, Alloc>::size_approx() const
+{
+    // 先读 head 再读 tail: tail 只增不减 结果不会小于 0
+    size_type head = consumer.head.load(std::memory_order_acquire);
+    size_type tail = producer.tail.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+template<typename T, typename Alloc>
+bool SpscRing<T, Alloc>::reserve_slots(size_type tail, size_type n)
+{
+    if(tail - producer.head_cache + n <= capacity())
+        return true;
+    producer.head_cache = consumer.head.load(std::memory_order_acquire);
+    return tail - producer.head_cache + n <= capacity();
+}
+
+template<typename T, typename Alloc>
+typename SpscRing<T, Alloc>::size_type SpscRing<T, Alloc>::readable(size_type head, size_type want)
+{
+    if(consumer.tail_cache - head < want)
+        consumer.tail_cache = producer.tail.load(std::memory_order_acquire);
+    return consumer.tail_cache - head;
+}
+
+// ---------------- 生产者 ----------------
+template<typename T, typename Alloc>
+template<typename... Args>
+bool SpscRing<T, Alloc>::try_emplace(Args&&... args)
+{
+    size_type tail = producer.tail.load(std::memory_order_relaxed);
+    if(!reserve_slots(tail, 1))
+        return false;
+    // 构造抛异常时 tail 未发布 槽位仍然空闲
+    allocator.construct(buffer + (tail & mask), std::forward<Args>(args)...);
+    producer.tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Alloc>
+typename SpscRing<T, Alloc>::size_type SpscRing<T, Alloc>::push_n(const value_type* first, size_type n)
+{
+    size_type tail = producer.tail.load(std::memory_order_relaxed);
+    if(!reserve_slots(tail, n))
+    {
+        // 放不下全部时 能放多少放多少
+        size_type free = capacity() - (tail - producer.head_cache);
+        n = free < n ? free : n;
+        if(n == 0)
+            return 0;
+    }
+    size_type i = 0;
+    try
+    {
+        for(;i<n;++i)
+            allocator.construct(buffer + ((tail + i) & mask), first[i]);
+    }
+    catch(...)
+    {
+        // 已构造好的部分照常发布
+        producer.tail.store(tail + i, std::memory_order_release);
+        throw;
+    }
+    producer.tail.store(tail + n, std::memory_order_release);
+    return n;
+}
+
+// ---------------- 消费者 ----------------
+template<typename T, typename Alloc>
+bool SpscRing<T, Alloc>::try_pop(value_type& out)
+{
+    size_type head = consumer.head.load(std::memory_order_relaxed);
+    if(readable(head, 1) == 0)
+        return false;
+    T* p = buffer + (head & mask);
+    // 赋值抛异常时 head 未发布 元素留在队列中
+    out = std::move(*p);
+    allocator.destroy(p);
+    consumer.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Alloc>
+typename SpscRing<T, Alloc>::size_type SpscRing<T, Alloc>::pop_n(value_type* out, size_type n)
+{
+    size_type head = consumer.head.load(std::memory_order_relaxed);
+    size_type avail = readable(head, n);
+    n = avail < n ? avail : n;
+    size_type i = 0;
+    try
+    {
+        for(;i<n;++i)
+        {
+            T* p = buffer + ((head + i) & mask);
+            out[i] = std::move(*p);
+            allocator.destroy(p);
+        }
+    }
+    catch(...)
+    {
+        consumer.head.store(head + i, std::memory_order_release);
+        throw;
+    }
+    if(n)
+        consumer.head.store(head + n, std::memory_order_release);
+    return n;
+}
@@ -0,0 +1,90 @@
+#ifndef YXY__STL__SPSC_RING_H
+#define YXY__STL__SPSC_RING_H
+
+#include "../allocator.h"
+#include<atomic>
+#include<cstddef>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+
+/*
+--- 单生产者单消费者无锁环形队列
+--- 容量向上取整到 2 的幂 下标用不回绕的计数器 取模变成按位与
+--- tail 只由生产者写 head 只由消费者写 两者各占一条缓存行 没有 CAS 只有 acquire/release 读写
+--- 双方各自缓存对方下标的最近一次读数 只有看起来满/空时才去读对方的缓存行 减少缓存行来回迁移
+--- push_n / pop_n 一次处理一批元素 只发布一次下标
+--- 同一时刻只能有一个线程 push 一个线程 pop (可以是同一个线程)
+*/
+template<typename T, typename Alloc = Allocator<T>>
+class SpscRing
+{
+public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+
+private:
+    // 生产者独占的缓存行
+    struct alignas(64) ProducerSide
+    {
+        std::atomic<size_type> tail{0};     // 下一个写入位置
+        size_type head_cache = 0;           // 最近读到的 head
+    };
+    // 消费者独占的缓存行
+    struct alignas(64) ConsumerSide
+    {
+        std::atomic<size_type> head{0};     // 下一个读取位置
+        size_type tail_cache = 0;           // 最近读到的 tail
+    };
+
+    ProducerSide producer;
+    ConsumerSide consumer;
+
+    // 以下构造后只读 与两端下标分开
+    alignas(64) T* buffer;
+    size_type mask;
+    Alloc allocator;
+
+    static size_type round_up(size_type n);
+
+    // 生产者: 至少还有 n 个空位时返回 true (先看缓存 不够再读 head)
+    bool reserve_slots(size_type tail, size_type n);
+    // 消费者: 可读元素个数 (先看缓存 不足 want 个再读 tail)
+    size_type readable(size_type head, size_type want);
+
+public:
+    // 容量向上取整到 2 的幂 (至少 2) 超过 SIZE_MAX / 2 + 1 时抛出 std::length_error
+    explicit SpscRing(size_type capacity, const Alloc& alloc = Alloc());
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    ~SpscRing();
+
+    size_type capacity() const
+    { return mask + 1; }
+
+    // 元素个数的近似值 (另一端可能正在修改)
+    size_type size_approx() const;
+    bool empty_approx() const
+    { return size_approx() == 0; }
+
+    // ---------------- 生产者 ----------------
+    // 队列满时返回 false 参数不被移动
+    bool try_push(const value_type& value)
+    { return try_emplace(value); }
+    bool try_push(value_type&& value)
+    { return try_emplace(std::move(value)); }
+    template<typename... Args>
+    bool try_emplace(Args&&... args);
+    // 尽量多地拷贝 [first, first + n) 返回实际入队个数
+    size_type push_n(const value_type* first, size_type n);
+
+    // ---------------- 消费者 ----------------
+    // 队列空时返回 false
+    bool try_pop(value_type& out);
+    // 最多取 n 个移动到 out 返回实际出队个数
+    size_type pop_n(value_type* out, size_type n);
+};
+
+#include "SpscRing.cpp"
+
+#endif // YXY__STL__SPSC_RING_H
@@ -0,0 +1,1050 @@
+#include "Unordered_map.h"
+
+#include<tuple>
+
+// ---------------------------- 内部工具 ----------------------------
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::size_type
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::capacity_for(size_type n)
+{
+    if(n == 0)
+        return 0;
+    size_type capacity = HashGroup::width;
+    while(max_load(capacity) < n)
+        capacity *= 2;
+    return capacity;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename K>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::size_type
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::find_in(const ctrl_t* c, const node_type* n, size_type capacity, const K& key, std::size_t hash) const
+{
+    if(capacity == 0)
+        return capacity;
+    return HashProbe::find(c, capacity, hash, [&](size_type i) { return key_equal(n[i].data.first, key); });
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::size_type
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::prepare_insert(std::size_t hash)
+{
+    if(_capacity == 0)
+        resize(capacity_for(1));
+    if(old_capacity)
+        migrate_step();
+
+    size_type i = find_first_non_full(hash);
+    // 已删除槽位可以直接复用 只有占用空槽位才消耗 growth_left
+    if(growth_left == 0 && ctrl[i] != HashCtrl::Deleted)
+    {
+        // 已删除槽位过多时原容量重建即可 否则翻倍
+        size_type new_capacity = _size < max_load(_capacity) / 2 ? _capacity : _capacity * 2;
+        if(incremental)
+        {
+            finish_migration();
+            start_migration(new_capacity);
+        }
+        else
+            resize(new_capacity);
+        i = find_first_non_full(hash);
+    }
+
+    if(ctrl[i] == HashCtrl::Empty)
+        --growth_left;
+    set_ctrl(i, h2(hash));
+    ++_size;
+    return i;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+std::pair<typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::iterator, bool>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::find_or_prepare_insert(const Key& key)
+{
+    std::size_t hash = hash_of(key);
+    size_type i = find_index(key, hash);
+    if(i != _capacity)
+        return {iterator_at(i), false};
+    size_type j = find_old_index(key, hash);
+    if(j != old_capacity)
+        return {old_iterator_at(j), false};
+    return {iterator_at(prepare_insert(hash)), true};
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename... Args>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::construct_at(size_type i, Args&&... args)
+{
+    try
+    {
+        allocator.construct(&nodes[i].data, std::forward<Args>(args)...);
+    }
+    catch(...)
+    {
+        // 槽位记为已删除 growth_left 不退还 下次扩容时自然回收
+        --_size;
+        set_ctrl(i, HashCtrl::Deleted);
+        throw;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::erase_index(size_type i)
+{
+    allocator.destroy(&nodes[i].data);
+    vacate_index(i);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::vacate_index(size_type i)
+{
+    --_size;
+    if(HashProbe::vacate(ctrl, _capacity, i))
+        ++growth_left;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::relocate_into(size_type i, std::pair<Key, Value>* src)
+{
+    try
+    {
+        uninitialized_relocate(allocator, src, src + 1, &nodes[i].mutable_data);
+    }
+    catch(...)
+    {
+        --_size;
+        set_ctrl(i, HashCtrl::Deleted);
+        throw;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+bool Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::merge_one(std::pair<Key, Value>* src)
+{
+    std::size_t hash = hash_of(src->first);
+    if(find_index(src->first, hash) != _capacity || find_old_index(src->first, hash) != old_capacity)
+        return false;
+    relocate_into(prepare_insert(hash), src);
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::allocate_arrays(size_type capacity, ctrl_t*& new_ctrl, node_type*& new_nodes)
+{
+    new_nodes = allocator.allocate(capacity);
+    try
+    {
+        new_ctrl = ctrl_allocator.allocate(capacity + HashGroup::width);
+    }
+    catch(...)
+    {
+        allocator.deallocate(new_nodes, capacity);
+        throw;
+    }
+    std::memset(new_ctrl, HashCtrl::Empty, capacity + HashGroup::width);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::deallocate_arrays(ctrl_t* c, node_type* n, size_type capacity)
+{
+    allocator.deallocate(n, capacity);
+    ctrl_allocator.deallocate(c, capacity + HashGroup::width);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::allocate_table(size_type capacity)
+{
+    allocate_arrays(capacity, ctrl, nodes);
+    _capacity = capacity;
+    growth_left = max_load(capacity);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::release()
+{
+    if(old_capacity)
+    {
+        for(size_type j = 0;j<old_capacity;++j)
+            if(HashCtrl::is_full(old_ctrl[j]))
+                allocator.destroy(&old_nodes[j].data);
+        release_old();
+    }
+    if(_capacity == 0)
+        return;
+    for(size_type i = 0;i<_capacity;++i)
+        if(HashCtrl::is_full(ctrl[i]))
+            allocator.destroy(&nodes[i].data);
+    allocator.deallocate(nodes, _capacity);
+    ctrl_allocator.deallocate(ctrl, _capacity + HashGroup::width);
+
+    ctrl = nullptr;
+    nodes = nullptr;
+    _capacity = 0;
+    _size = 0;
+    growth_left = 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::resize(size_type new_capacity)
+{
+    using value_type = std::pair<Key, Value>;
+
+    // 新表先放在局部变量里 全部搬完才替换成员 中途抛异常时原表不变
+    ctrl_t* new_ctrl;
+    node_type* new_nodes;
+    allocate_arrays(new_capacity, new_ctrl, new_nodes);
+    try
+    {
+        if constexpr(is_trivially_relocatable<value_type>::value)
+        {
+            // 按字节拷贝不改动原元素 hash_of 抛异常时丢掉新表即可
+            for(size_type i = 0;i<_capacity;++i)
+            {
+                if(!HashCtrl::is_full(ctrl[i]))
+                    continue;
+                std::size_t hash = hash_of(nodes[i].data.first);
+                size_type j = HashProbe::find_first_non_full(new_ctrl, new_capacity, hash);
+                HashProbe::set_ctrl(new_ctrl, new_capacity, j, h2(hash));
+                std::memcpy(static_cast<void*>(&new_nodes[j]), static_cast<const void*>(&nodes[i]), sizeof(node_type));
+            }
+        }
+        else
+        {
+            // 移动会改动原元素 先算好所有 hash (可能抛异常) 再搬运
+            std::unique_ptr<std::size_t[]> hashes(new std::size_t[_size]);
+            size_type k = 0;
+            for(size_type i = 0;i<_capacity;++i)
+                if(HashCtrl::is_full(ctrl[i]))
+                    hashes[k++] = hash_of(nodes[i].data.first);
+
+            k = 0;
+            for(size_type i = 0;i<_capacity;++i)
+            {
+                if(!HashCtrl::is_full(ctrl[i]))
+                    continue;
+                std::size_t hash = hashes[k++];
+                size_type j = HashProbe::find_first_non_full(new_ctrl, new_capacity, hash);
+                if constexpr(std::is_nothrow_move_constructible<value_type>::value)
+                    uninitialized_relocate(allocator, &nodes[i].mutable_data, &nodes[i].mutable_data + 1, &new_nodes[j].mutable_data);
+                else
+                {
+                    // 只能拷贝: 原元素保留到全部拷贝成功 失败时析构新表中已有的拷贝
+                    try
+                    {
+                        allocator.construct(&new_nodes[j].mutable_data, static_cast<const value_type&>(nodes[i].mutable_data));
+                    }
+                    catch(...)
+                    {
+                        for(size_type t = 0;t<new_capacity;++t)
+                            if(HashCtrl::is_full(new_ctrl[t]))
+                                allocator.destroy(&new_nodes[t].data);
+                        throw;
+                    }
+                }
+                HashProbe::set_ctrl(new_ctrl, new_capacity, j, h2(hash));
+            }
+            if constexpr(!std::is_nothrow_move_constructible<value_type>::value)
+                for(size_type i = 0;i<_capacity;++i)
+                    if(HashCtrl::is_full(ctrl[i]))
+                        allocator.destroy(&nodes[i].data);
+        }
+    }
+    catch(...)
+    {
+        deallocate_arrays(new_ctrl, new_nodes, new_capacity);
+        throw;
+    }
+
+    if(_capacity)
+        deallocate_arrays(ctrl, nodes, _capacity);
+    ctrl = new_ctrl;
+    nodes = new_nodes;
+    _capacity = new_capacity;
+    growth_left = max_load(new_capacity) - _size;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::start_migration(size_type new_capacity)
+{
+    ctrl_t* cur_ctrl = ctrl;
+    node_type* cur_nodes = nodes;
+    size_type cur_capacity = _capacity;
+
+    // 分配失败时成员不变
+    allocate_table(new_capacity);
+
+    old_ctrl = cur_ctrl;
+    old_nodes = cur_nodes;
+    old_capacity = cur_capacity;
+    old_size = _size;
+    migrate_pos = 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::size_type
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::migrate_slot(size_type j)
+{
+    std::size_t hash = hash_of(old_nodes[j].data.first);
+    size_type i = find_first_non_full(hash);
+    // 先搬运 成功后再改控制字节 搬运抛异常时两张表都不变
+    uninitialized_relocate(allocator, &old_nodes[j].mutable_data, &old_nodes[j].mutable_data + 1, &nodes[i].mutable_data);
+    if(ctrl[i] == HashCtrl::Empty)
+        --growth_left;
+    set_ctrl(i, h2(hash));
+
+    // 旧表中记为已删除 经过它的探测链仍然完整
+    HashProbe::set_ctrl(old_ctrl, old_capacity, j, HashCtrl::Deleted);
+    --old_size;
+    return i;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::migrate_step()
+{
+    size_type end = migrate_pos + rehash_step < old_capacity ? migrate_pos + rehash_step : old_capacity;
+    for(;migrate_pos<end;++migrate_pos)
+        if(HashCtrl::is_full(old_ctrl[migrate_pos]))
+            migrate_slot(migrate_pos);
+    if(migrate_pos == old_capacity || old_size == 0)
+        release_old();
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::finish_migration()
+{
+    if(old_capacity == 0)
+        return;
+    for(;migrate_pos<old_capacity && old_size;++migrate_pos)
+        if(HashCtrl::is_full(old_ctrl[migrate_pos]))
+            migrate_slot(migrate_pos);
+    release_old();
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::release_old()
+{
+    allocator.deallocate(old_nodes, old_capacity);
+    ctrl_allocator.deallocate(old_ctrl, old_capacity + HashGroup::width);
+    old_ctrl = nullptr;
+    old_nodes = nullptr;
+    old_capacity = 0;
+    old_size = 0;
+    migrate_pos = 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::erase_old_index(size_type j)
+{
+    allocator.destroy(&old_nodes[j].data);
+    vacate_old_index(j);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::vacate_old_index(size_type j)
+{
+    HashProbe::set_ctrl(old_ctrl, old_capacity, j, HashCtrl::Deleted);
+    --old_size;
+    --_size;
+}
+
+// ---------------------------- 构造/析构 ----------------------------
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::Unordered_map(size_type n)
+: Unordered_map()
+{
+    reserve(n);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::Unordered_map(std::initializer_list<value_type> il)
+: Unordered_map()
+{
+    try
+    {
+        reserve(il.size());
+        for(const auto& it : il)
+            insert(it);
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::Unordered_map(const Unordered_map& other)
+: ctrl(nullptr), nodes(nullptr), _capacity(0), _size(0), growth_left(0), incremental(other.incremental),
+  allocator(other.allocator), ctrl_allocator(other.ctrl_allocator),
+  key_equal(other.key_equal), hasher(other.hasher), mixer(other.mixer)
+{
+    try
+    {
+        reserve(other._size);
+        for(const auto& it : other)
+            insert(it);
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::Unordered_map(Unordered_map&& other) noexcept
+: ctrl(other.ctrl), nodes(other.nodes), _capacity(other._capacity), _size(other._size),
+  growth_left(other.growth_left),
+  old_ctrl(other.old_ctrl), old_nodes(other.old_nodes), old_capacity(other.old_capacity),
+  old_size(other.old_size), migrate_pos(other.migrate_pos), incremental(other.incremental),
+  allocator(std::move(other.allocator)), ctrl_allocator(std::move(other.ctrl_allocator)),
+  key_equal(std::move(other.key_equal)), hasher(std::move(other.hasher)), mixer(std::move(other.mixer))
+{
+    other.ctrl = nullptr;
+    other.nodes = nullptr;
+    other._capacity = 0;
+    other._size = 0;
+    other.growth_left = 0;
+    other.old_ctrl = nullptr;
+    other.old_nodes = nullptr;
+    other.old_capacity = 0;
+    other.old_size = 0;
+    other.migrate_pos = 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>&
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::operator=(const Unordered_map& rhs)
+{
+    if(this != &rhs)
+    {
+        Unordered_map tmp(rhs);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>&
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::operator=(Unordered_map&& rhs) noexcept
+{
+    if(this != &rhs)
+    {
+        release();
+        swap(rhs);
+    }
+    return *this;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::~Unordered_map()
+{
+    release();
+}
+
+// ---------------------------- 常用方法 ----------------------------
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::iterator
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::begin()
+{
+    iterator it = old_size ? old_iterator_at(0) : iterator_at(0);
+    it.skip_empty();
+    return it;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::const_iterator
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::begin() const
+{
+    const_iterator it = old_size ? old_iterator_at(0) : iterator_at(0);
+    it.skip_empty();
+    return it;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::reserve(size_type n)
+{
+    size_type capacity = capacity_for(n);
+    if(capacity > _capacity)
+    {
+        finish_migration();
+        resize(capacity);
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::rehash(size_type n)
+{
+    finish_migration();
+    size_type capacity = capacity_for(_size);
+    if(n > capacity)
+    {
+        capacity = HashGroup::width;
+        while(capacity < n)
+            capacity *= 2;
+    }
+
+    if(capacity == 0)
+        release();
+    else
+        resize(capacity);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::set_incremental_rehash(bool enable)
+{
+    incremental = enable;
+    if(!enable)
+        finish_migration();
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+std::pair<typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::iterator, bool>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::insert(const value_type& value)
+{
+    auto res = find_or_prepare_insert(value.first);
+    if(res.second)
+        construct_at(index_of(res.first), value);
+    return res;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+std::pair<typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::iterator, bool>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::insert(value_type&& value)
+{
+    auto res = find_or_prepare_insert(value.first);
+    if(res.second)
+        construct_at(index_of(res.first), std::move(value));
+    return res;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename... Args>
+std::pair<typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::iterator, bool>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::emplace(Args&&... args)
+{
+    // 先在临时结点上构造 拿到 key 之后再决定是否搬进表里
+    node_type tmp;
+    allocator.construct(&tmp.mutable_data, std::forward<Args>(args)...);
+    try
+    {
+        auto res = find_or_prepare_insert(tmp.data.first);
+        if(res.second)
+            construct_at(index_of(res.first), std::move(tmp.mutable_data));
+        allocator.destroy(&tmp.mutable_data);
+        return res;
+    }
+    catch(...)
+    {
+        allocator.destroy(&tmp.mutable_data);
+        throw;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename K, typename... Args>
+std::pair<typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::iterator, bool>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::try_emplace_key(K&& key, Args&&... args)
+{
+    auto res = find_or_prepare_insert(key);
+    if(res.second)
+        construct_at(index_of(res.first), std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                     std::forward_as_tuple(std::forward<Args>(args)...));
+    return res;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename K, typename M>
+std::pair<typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::iterator, bool>
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::insert_or_assign_key(K&& key, M&& value)
+{
+    auto res = find_or_prepare_insert(key);
+    if(res.second)
+        construct_at(index_of(res.first), std::forward<K>(key), std::forward<M>(value));
+    else
+        res.first->second = std::forward<M>(value);
+    return res;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::node_handle
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::extract(const_iterator pos)
+{
+    node_handle nh(allocator);
+    if(in_old_table(pos.ctrl))
+    {
+        size_type j = pos.ctrl - old_ctrl;
+        nh.take(&old_nodes[j].mutable_data);
+        vacate_old_index(j);
+        if(old_size == 0)
+            release_old();
+    }
+    else
+    {
+        size_type i = pos.node - nodes;
+        nh.take(&nodes[i].mutable_data);
+        vacate_index(i);
+    }
+    return nh;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::node_handle
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::extract(const Key& key)
+{
+    const_iterator it = find_key(key);
+    if(it == end())
+        return node_handle(allocator);
+    return extract(it);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::insert_return_type
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::insert(node_handle&& nh)
+{
+    if(nh.empty())
+        return {end(), false, node_handle(allocator)};
+    auto res = find_or_prepare_insert(nh.key());
+    if(!res.second)
+        return {res.first, false, std::move(nh)};
+    relocate_into(index_of(res.first), &nh.node.mutable_data);
+    nh.has_value = false;
+    return {res.first, true, node_handle(allocator)};
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename H2, typename E2, typename M2>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::merge(Unordered_map<Key, Value, H2, E2, Alloc, M2>& source)
+{
+    if(static_cast<void*>(&source) == static_cast<void*>(this))
+        return;
+    // 按槽位下标扫描 source 搬走的槽位只改控制字节 不影响后面的扫描
+    for(size_type j = 0;j<source.old_capacity;++j)
+        if(HashCtrl::is_full(source.old_ctrl[j]) && merge_one(&source.old_nodes[j].mutable_data))
+            source.vacate_old_index(j);
+    for(size_type i = 0;i<source._capacity;++i)
+        if(HashCtrl::is_full(source.ctrl[i]) && merge_one(&source.nodes[i].mutable_data))
+            source.vacate_index(i);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+Value& Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::operator[](const Key& key)
+{
+    auto res = find_or_prepare_insert(key);
+    if(res.second)
+        construct_at(index_of(res.first), std::piecewise_construct, std::forward_as_tuple(key), std::tuple<>());
+    return res.first->second;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+Value& Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::operator[](Key&& key)
+{
+    auto res = find_or_prepare_insert(key);
+    if(res.second)
+        construct_at(index_of(res.first), std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::tuple<>());
+    return res.first->second;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+Value& Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::at(const Key& key)
+{
+    iterator it = find(key);
+    if(it == end())
+        throw std::out_of_range("Unordered_map:: key not found!");
+    return it->second;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+const Value& Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::at(const Key& key) const
+{
+    const_iterator it = find(key);
+    if(it == end())
+        throw std::out_of_range("Unordered_map:: key not found!");
+    return it->second;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename K>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::iterator
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::find_key(const K& key)
+{
+    std::size_t hash = hash_of(key);
+    size_type i = find_index(key, hash);
+    if(i == _capacity)
+    {
+        size_type j = find_old_index(key, hash);
+        if(j != old_capacity)
+            return old_iterator_at(j);
+    }
+    return iterator_at(i);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename K>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::const_iterator
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::find_key(const K& key) const
+{
+    std::size_t hash = hash_of(key);
+    size_type i = find_index(key, hash);
+    if(i == _capacity)
+    {
+        size_type j = find_old_index(key, hash);
+        if(j != old_capacity)
+            return old_iterator_at(j);
+    }
+    return iterator_at(i);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename K>
+bool Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::contains_key(const K& key) const
+{
+    std::size_t hash = hash_of(key);
+    return find_index(key, hash) != _capacity || find_old_index(key, hash) != old_capacity;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename F>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::lookup_batch(const Key* keys, size_type count, F f) const
+{
+    if(_capacity == 0)
+    {
+        for(size_type k = 0;k<count;++k)
+            f(k, std::size_t(0), _capacity);
+        return;
+    }
+
+    // 一批的大小约等于 CPU 能同时挂起的 cache miss 数
+    constexpr size_type batch = 16;
+    std::size_t hashes[batch];
+    for(size_type base = 0;base<count;base += batch)
+    {
+        size_type n = count - base < batch ? count - base : batch;
+        for(size_type k = 0;k<n;++k)
+        {
+            hashes[k] = hash_of(keys[base + k]);
+            size_type pos = buckets_index(hashes[k]);
+            prefetch_read(ctrl + pos);
+            prefetch_read(nodes + pos);
+        }
+        for(size_type k = 0;k<n;++k)
+            f(base + k, hashes[k], find_index(keys[base + k], hashes[k]));
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::find_batch(const Key* keys, size_type count, iterator* out)
+{
+    lookup_batch(keys, count, [&](size_type k, std::size_t hash, size_type i)
+    {
+        if(i == _capacity)
+        {
+            size_type j = find_old_index(keys[k], hash);
+            if(j != old_capacity)
+            {
+                out[k] = old_iterator_at(j);
+                return;
+            }
+        }
+        out[k] = iterator_at(i);
+    });
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::find_batch(const Key* keys, size_type count, const_iterator* out) const
+{
+    lookup_batch(keys, count, [&](size_type k, std::size_t hash, size_type i)
+    {
+        if(i == _capacity)
+        {
+            size_type j = find_old_index(keys[k], hash);
+            if(j != old_capacity)
+            {
+                out[k] = old_iterator_at(j);
+                return;
+            }
+        }
+        out[k] = iterator_at(i);
+    });
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::contains_batch(const Key* keys, size_type count, bool* out) const
+{
+    lookup_batch(keys, count, [&](size_type k, std::size_t hash, size_type i)
+    {
+        out[k] = i != _capacity || find_old_index(keys[k], hash) != old_capacity;
+    });
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+template<typename K>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::size_type
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::erase_key(const K& key)
+{
+    // 只删不插的负载也要把旧表搬完
+    if(old_capacity)
+        migrate_step();
+    std::size_t hash = hash_of(key);
+    size_type i = find_index(key, hash);
+    if(i != _capacity)
+    {
+        erase_index(i);
+        return 1;
+    }
+    size_type j = find_old_index(key, hash);
+    if(j == old_capacity)
+        return 0;
+    erase_old_index(j);
+    return 1;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::iterator
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::erase(const_iterator pos)
+{
+    if(in_old_table(pos.ctrl))
+    {
+        // 旧表还有元素时不释放 保证边遍历边删除时迭代器有效
+        // 删空后 next 已经接到新表 旧表上不再有有效的迭代器
+        size_type j = pos.ctrl - old_ctrl;
+        erase_old_index(j);
+        iterator next = old_iterator_at(j);
+        next.skip_empty();
+        if(old_size == 0)
+            release_old();
+        return next;
+    }
+    size_type i = pos.node - nodes;
+    erase_index(i);
+    iterator next = iterator_at(i);
+    next.skip_empty();
+    return next;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+typename Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::iterator
+Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::erase(iterator pos)
+{
+    return erase(const_iterator(pos));
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::clear()
+{
+    if(old_capacity)
+    {
+        for(size_type j = 0;j<old_capacity;++j)
+            if(HashCtrl::is_full(old_ctrl[j]))
+                allocator.destroy(&old_nodes[j].data);
+        release_old();
+    }
+    if(_capacity == 0)
+        return;
+    for(size_type i = 0;i<_capacity;++i)
+        if(HashCtrl::is_full(ctrl[i]))
+            allocator.destroy(&nodes[i].data);
+    std::memset(ctrl, HashCtrl::Empty, _capacity + HashGroup::width);
+    _size = 0;
+    growth_left = max_load(_capacity);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::swap(Unordered_map& other) noexcept
+{
+    std::swap(ctrl, other.ctrl);
+    std::swap(nodes, other.nodes);
+    std::swap(_capacity, other._capacity);
+    std::swap(_size, other._size);
+    std::swap(growth_left, other.growth_left);
+    std::swap(old_ctrl, other.old_ctrl);
+    std::swap(old_nodes, other.old_nodes);
+    std::swap(old_capacity, other.old_capacity);
+    std::swap(old_size, other.old_size);
+    std::swap(migrate_pos, other.migrate_pos);
+    std::swap(incremental, other.incremental);
+    std::swap(allocator, other.allocator);
+    std::swap(ctrl_allocator, other.ctrl_allocator);
+    std::swap(key_equal, other.key_equal);
+    std::swap(hasher, other.hasher);
+    std::swap(mixer, other.mixer);
+}
+
+// ------------------------- 快照 ---------------------------
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+bool Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::snapshot_hashes_match() const
+{
+    // 每张表均匀抽查至多 32 个槽位 不做全表扫描
+    auto check = [this](const ctrl_t* c, const node_type* n, size_type capacity)
+    {
+        size_type stride = capacity / 32 ? capacity / 32 : 1;
+        for(size_type i = 0;i<capacity;i += stride)
+            if(HashCtrl::is_full(c[i]) && h2(hash_of(n[i].data.first)) != c[i])
+                return false;
+        return true;
+    };
+    return check(ctrl, nodes, _capacity) && check(old_ctrl, old_nodes, old_capacity);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::save_snapshot(std::FILE* out) const
+{
+    static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value,
+                  "Unordered_map snapshot requires trivially copyable Key and Value");
+    static_assert(alignof(node_type) <= snapshot_detail::alignment, "node alignment exceeds snapshot section alignment");
+    SnapshotHeader h = snapshot_detail::make_header(SnapshotKind::UnorderedMap, sizeof(node_type), alignof(node_type));
+    h.key_size = static_cast<std::uint32_t>(sizeof(Key));
+    h.value_size = static_cast<std::uint32_t>(sizeof(Value));
+    h.group_width = static_cast<std::uint32_t>(HashGroup::width);
+    h.flags = incremental ? 1u : 0u;
+    h.count = _size;
+    h.capacity = _capacity;
+    h.growth_left = growth_left;
+    h.old_capacity = old_capacity;
+    h.old_size = old_size;
+    h.migrate_pos = migrate_pos;
+    snapshot_detail::write_bytes(out, &h, sizeof(h));
+    if(_capacity)
+    {
+        snapshot_detail::write_section(out, ctrl, _capacity + HashGroup::width);
+        write_snapshot_slots(out, ctrl, nodes, _capacity);
+    }
+    if(old_capacity)
+    {
+        snapshot_detail::write_section(out, old_ctrl, old_capacity + HashGroup::width);
+        write_snapshot_slots(out, old_ctrl, old_nodes, old_capacity);
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::write_snapshot_slots(std::FILE* out, const ctrl_t* c,
+                                                                                   const node_type* n, size_type capacity)
+{
+    // 按块拷到缓冲区 把非满槽位清零后写出
+    constexpr size_type block = (64 * 1024) / sizeof(node_type) + 1;
+    const size_type count = capacity < block ? capacity : block;
+    std::unique_ptr<unsigned char[]> buf(new unsigned char[count * sizeof(node_type)]);
+
+    snapshot_detail::write_padding(out);
+    for(size_type first = 0;first<capacity;first += count)
+    {
+        size_type m = capacity - first < count ? capacity - first : count;
+        std::memcpy(buf.get(), static_cast<const void*>(n + first), m * sizeof(node_type));
+        for(size_type i = 0;i<m;++i)
+            if(!HashCtrl::is_full(c[first + i]))
+                std::memset(buf.get() + i * sizeof(node_type), 0, sizeof(node_type));
+        snapshot_detail::write_bytes(out, buf.get(), m * sizeof(node_type));
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::save_snapshot(const std::string& path) const
+{
+    snapshot_detail::SnapshotFile file(path, true);
+    save_snapshot(file.get());
+    file.commit();
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::load_snapshot(std::FILE* in)
+{
+    static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value,
+                  "Unordered_map snapshot requires trivially copyable Key and Value");
+    SnapshotHeader h;
+    snapshot_detail::read_bytes(in, &h, sizeof(h));
+    snapshot_detail::check_header(h, SnapshotKind::UnorderedMap, sizeof(node_type), alignof(node_type));
+    if(h.key_size != sizeof(Key) || h.value_size != sizeof(Value) || h.group_width != HashGroup::width)
+        throw std::runtime_error("snapshot:: element layout mismatch!");
+
+    // 容量为 0 或不小于 group 宽度的 2 的幂 旧表不大于新表 (删除过多时按原容量重建)
+    auto valid_capacity = [](std::uint64_t c)
+    { return c == 0 || (c >= HashGroup::width && (c & (c - 1)) == 0 && c <= std::uint64_t(1) << 56); };
+    if(!valid_capacity(h.capacity) || !valid_capacity(h.old_capacity)
+        || h.old_capacity > h.capacity
+        || h.count > h.capacity + h.old_capacity || h.old_size > h.count
+        || h.growth_left > max_load(static_cast<size_type>(h.capacity))
+        || h.migrate_pos > h.old_capacity)
+        throw std::runtime_error("snapshot:: corrupted table header!");
+    // 每个槽位在文件中至少占一个控制字节加一个结点 申请内存前先和文件剩余长度比较
+    if(h.capacity + h.old_capacity > snapshot_detail::remaining(in) / (sizeof(node_type) + 1))
+        throw std::runtime_error("snapshot:: unexpected end of file!");
+
+    // 先读到临时表 成功后再交换 哈希相关的函数对象沿用本表的
+    Unordered_map tmp(allocator);
+    tmp.hasher = hasher;
+    tmp.key_equal = key_equal;
+    tmp.mixer = mixer;
+    if(h.capacity)
+    {
+        tmp.allocate_table(static_cast<size_type>(h.capacity));
+        snapshot_detail::read_section(in, tmp.ctrl, tmp._capacity + HashGroup::width);
+        snapshot_detail::read_section(in, tmp.nodes, tmp._capacity * sizeof(node_type));
+        tmp._size = static_cast<size_type>(h.count);
+        tmp.growth_left = static_cast<size_type>(h.growth_left);
+    }
+    if(h.old_capacity)
+    {
+        size_type oc = static_cast<size_type>(h.old_capacity);
+        node_type* on = tmp.allocator.allocate(oc);
+        ctrl_t* octl;
+        try
+        {
+            octl = tmp.ctrl_allocator.allocate(oc + HashGroup::width);
+        }
+        catch(...)
+        {
+            tmp.allocator.deallocate(on, oc);
+            throw;
+        }
+        // 读入途中失败时 tmp 析构要能正确识别旧表中的满槽位
+        std::memset(octl, HashCtrl::Empty, oc + HashGroup::width);
+        tmp.old_ctrl = octl;
+        tmp.old_nodes = on;
+        tmp.old_capacity = oc;
+        snapshot_detail::read_section(in, tmp.old_ctrl, oc + HashGroup::width);
+        snapshot_detail::read_section(in, tmp.old_nodes, oc * sizeof(node_type));
+        tmp.old_size = static_cast<size_type>(h.old_size);
+        tmp.migrate_pos = static_cast<size_type>(h.migrate_pos);
+    }
+    tmp.incremental = (h.flags & 1u) != 0;
+
+    // 控制字节只能是 Empty / Deleted / 7 位的 h2 镜像字节必须与表头一致 否则探测会越过表尾读到错误的控制字节
+    size_type full = 0, deleted = 0, old_full = 0, old_deleted = 0;
+    auto scan = [](const ctrl_t* c, size_type capacity, size_type& n_full, size_type& n_deleted)
+    {
+        if(capacity && std::memcmp(c, c + capacity, HashGroup::width) != 0)
+            return false;
+        for(size_type i = 0;i<capacity;++i)
+        {
+            if(HashCtrl::is_full(c[i]))
+                ++n_full;
+            else if(c[i] == HashCtrl::Deleted)
+                ++n_deleted;
+            else if(c[i] != HashCtrl::Empty)
+                return false;
+        }
+        return true;
+    };
+    if(!scan(tmp.ctrl, tmp._capacity, full, deleted) || !scan(tmp.old_ctrl, tmp.old_capacity, old_full, old_deleted))
+        throw std::runtime_error("snapshot:: corrupted control bytes!");
+    // 计数必须与控制字节一致: 新表至少留有 growth_left 个空槽位 且装得下旧表剩余的元素
+    // 否则插入 / 搬运时找不到空槽位 探测不会结束
+    size_type limit = max_load(tmp._capacity);
+    if(full + old_full != tmp._size || old_full != tmp.old_size
+        || full + deleted > limit || tmp.growth_left > limit - full - deleted
+        || tmp.old_size > tmp.growth_left)
+        throw std::runtime_error("snapshot:: element counts do not match control bytes!");
+    if(!tmp.snapshot_hashes_match())
+        throw std::runtime_error("snapshot:: hash function mismatch!");
+    swap(tmp);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Alloc, typename Mixer>
+void Unordered_map<Key, Value, Hash, KeyEqual, Alloc, Mixer>::load_snapshot(const std::string& path)
+{
+    snapshot_detail::SnapshotFile file(path, false);
+    load_snapshot(file.get());
+}
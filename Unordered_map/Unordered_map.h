@@ -3,33 +3,456 @@
 
 
 #include<functional>    // std::hash
+#include<string_view>
+#include<type_traits>
 #include<utility>       // std::pair
+#include<iterator>
+#include<initializer_list>
+#include<stdexcept>
+#include<cstdint>
+#include<cstring>
+#include<memory>
+#if defined(__SSE2__) || defined(_M_X64)
+#include<emmintrin.h>
+#endif
 #include "../allocator.h"
-#include "../Vector/Vector.h"
+#include "../relocate.h"
+#include "../snapshot.h"
 
-/* 
---- 使用桶(指针数组) + 链表 
---- 链表结点中存储key + value 
---- key->hash作为数组下标
---- hash因子过大时rehash负载均衡解决
+/*
+--- 开放寻址 (Swiss table): 控制字节数组 + 结点数组 两块连续内存
+--- 每个槽位1字节控制信息: 空 / 已删除 / 满(低7位存hash的h2)
+--- 一次用SSE2比较16个控制字节 (一个group) 命中后才去比较key
+--- 结点直接存放在槽位中 不再单独new 也没有next指针链
+--- 容量恒为2的幂 负载因子上限 7/8 超过时整体扩容
+--- 可选渐进式 rehash: 扩容时保留旧表 之后每次插入只搬运一小段 查找同时查两张表
+--- 避免大表一次性搬运全部元素造成的延迟尖刺
 */
 
-// 哈希结点
+// 控制字节: 满槽位为 0~127 (hash 的低7位) 负数表示空/已删除
+using ctrl_t = signed char;
+
+struct HashCtrl
+{
+    static constexpr ctrl_t Empty   = -128;      // 0b10000000
+    static constexpr ctrl_t Deleted = -2;        // 0b11111110
+
+    static bool is_full(ctrl_t c) { return c >= 0; }
+};
+
+// 位掩码中最低位 1 的下标
+inline unsigned lowest_bit_index(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned i = 0;
+    while(!(mask & 1u)) { mask >>= 1; ++i; }
+    return i;
+#endif
+}
+
+// 预取到缓存 只是提示 不影响正确性
+inline void prefetch_read(const void* p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 0, 3);
+#elif defined(__SSE2__) || defined(_M_X64)
+    _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+    (void)p;
+#endif
+}
+
+// 16位掩码中最高位 1 之上的 0 的个数
+inline unsigned leading_zeros16(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_clz(mask)) - 16;
+#else
+    unsigned n = 0;
+    for(uint32_t bit = 1u << 15; bit && !(mask & bit); bit >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+// 对用户 hash 再做一次混合 作为 Unordered_map 的 Mixer 参数 按 key 的哈希质量选择
+// 探测起点取混合结果的 [7, 7+log2(capacity)) 位 h2 取低7位 所以这些位都要足够随机
+
+// 乘以黄金分割常数 (Fibonacci hashing) 后把高低64位折叠 高位信息也能落到探测起点和h2上
+// 一次乘法 默认选项 能打散 std::hash<int> 这类恒等哈希
+struct HashMixFibonacci
+{
+    std::size_t operator()(std::size_t h) const
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 m = static_cast<unsigned __int128>(h) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(static_cast<uint64_t>(m) ^ static_cast<uint64_t>(m >> 64));
+#else
+        uint64_t x = static_cast<uint64_t>(h);
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33;
+        return static_cast<std::size_t>(x);
+#endif
+    }
+};
+
+// murmur3 的 fmix64 两次乘法 雪崩效果最好 适合只有少数位变化的 key (如对齐的指针)
+struct HashMixMurmur
+{
+    std::size_t operator()(std::size_t h) const
+    {
+        uint64_t x = static_cast<uint64_t>(h);
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ull;
+        x ^= x >> 33;
+        return static_cast<std::size_t>(x);
+    }
+};
+
+// 不混合 仅用于本身已经均匀的哈希 (如 std::hash<std::string>)
+// 对 std::hash<int> 连续的 key 会挤在同一个 group 里 退化严重
+struct HashMixIdentity
+{
+    std::size_t operator()(std::size_t h) const
+    { return h; }
+};
+
+inline std::size_t hash_mix(std::size_t h)
+{ return HashMixFibonacci()(h); }
+
+// 透明查找: Hash 与 KeyEqual 都声明 is_transparent 时
+// find / count / contains / erase 接受任意能被它们哈希和比较的类型 不必先构造 Key
+template<typename T, typename = void>
+struct has_is_transparent : std::false_type {};
+template<typename T>
+struct has_is_transparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+
+// 透明的字符串哈希 与 std::hash<std::string> 结果相同
+// 配合 std::equal_to<> 可以直接用 std::string_view / const char* 查找 std::string key
+struct StringHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view s) const
+    { return std::hash<std::string_view>()(s); }
+};
+
+// 一组16个控制字节 匹配结果以位掩码返回 第i位对应第i个槽位
+struct HashGroup
+{
+    static constexpr std::size_t width = 16;
+
+#if defined(__SSE2__) || defined(_M_X64)
+    __m128i ctrl;
+
+    explicit HashGroup(const ctrl_t* pos)
+    : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    // h2 相同的槽位
+    uint32_t match(ctrl_t h2) const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+    }
+
+    uint32_t match_empty() const
+    {
+        return match(HashCtrl::Empty);
+    }
+
+    // 空/已删除 最高位都为1
+    uint32_t match_empty_or_deleted() const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+    }
+#else
+    const ctrl_t* ctrl;
+
+    explicit HashGroup(const ctrl_t* pos) : ctrl(pos) {}
+
+    uint32_t match(ctrl_t h2) const
+    {
+        uint32_t mask = 0;
+        for(std::size_t i = 0;i<width;++i)
+            if(ctrl[i] == h2)
+                mask |= 1u << i;
+        return mask;
+    }
+
+    uint32_t match_empty() const
+    {
+        return match(HashCtrl::Empty);
+    }
+
+    uint32_t match_empty_or_deleted() const
+    {
+        uint32_t mask = 0;
+        for(std::size_t i = 0;i<width;++i)
+            if(!HashCtrl::is_full(ctrl[i]))
+                mask |= 1u << i;
+        return mask;
+    }
+#endif
+};
+
+// 控制字节数组上的探测 / 删除 Unordered_map 与 ConcurrentUnorderedMap 共用
+// 控制字节数组长度 capacity + width 末尾 width 个字节是开头的镜像 capacity 为 2 的幂
+struct HashProbe
+{
+    // 高位决定探测起点 低7位(h2)存入控制字节
+    static std::size_t buckets_index(std::size_t hash, std::size_t capacity)
+    { return (hash >> 7) & (capacity - 1); }
+
+    static ctrl_t h2(std::size_t hash)
+    { return static_cast<ctrl_t>(hash & 0x7F); }
+
+    static void set_ctrl(ctrl_t* ctrl, std::size_t capacity, std::size_t i, ctrl_t c)
+    {
+        ctrl[i] = c;
+        // 开头 width 个字节同步到末尾镜像
+        if(i < HashGroup::width)
+            ctrl[capacity + i] = c;
+    }
+
+    // 沿探测序列找 h2 相同且 eq(i) 为真的槽位 不存在返回 capacity
+    // 按 group 做三角探测 capacity / width 步内走遍所有 group
+    // 步数有上限 并发读者读到正在修改的控制字节时也一定会结束
+    template<typename Eq>
+    static std::size_t find(const ctrl_t* ctrl, std::size_t capacity, std::size_t hash, Eq eq)
+    {
+        const std::size_t mask = capacity - 1;
+        const ctrl_t tag = h2(hash);
+        std::size_t pos = buckets_index(hash, capacity);
+        std::size_t step = 0;
+        for(std::size_t probes = capacity / HashGroup::width;probes;--probes)
+        {
+            HashGroup group(ctrl + pos);
+            for(uint32_t m = group.match(tag);m;m &= m - 1)
+            {
+                std::size_t i = (pos + lowest_bit_index(m)) & mask;
+                if(eq(i))
+                    return i;
+            }
+            if(group.match_empty())
+                return capacity;
+            step += HashGroup::width;
+            pos = (pos + step) & mask;
+        }
+        return capacity;
+    }
+
+    // 沿探测序列找到第一个空/已删除槽位 (负载因子 < 1 保证存在)
+    static std::size_t find_first_non_full(const ctrl_t* ctrl, std::size_t capacity, std::size_t hash)
+    {
+        const std::size_t mask = capacity - 1;
+        std::size_t pos = buckets_index(hash, capacity);
+        std::size_t step = 0;
+        while(true)
+        {
+            uint32_t m = HashGroup(ctrl + pos).match_empty_or_deleted();
+            if(m)
+                return (pos + lowest_bit_index(m)) & mask;
+            step += HashGroup::width;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    // 槽位 i 的元素已析构或已搬走 更新控制字节 置空 (可退还 growth_left) 时返回 true
+    // 若 i 前后两个 group 中的空槽位把 i 夹在同一个 16 字节窗口内
+    // 说明没有任何探测序列曾经越过 i 可以直接置空 否则只能留下墓碑
+    static bool vacate(ctrl_t* ctrl, std::size_t capacity, std::size_t i)
+    {
+        const std::size_t before = (i - HashGroup::width) & (capacity - 1);
+        uint32_t empty_after = HashGroup(ctrl + i).match_empty();
+        uint32_t empty_before = HashGroup(ctrl + before).match_empty();
+        bool was_never_full = empty_before && empty_after &&
+            lowest_bit_index(empty_after) + leading_zeros16(empty_before) < HashGroup::width;
+
+        set_ctrl(ctrl, capacity, i, was_never_full ? HashCtrl::Empty : HashCtrl::Deleted);
+        return was_never_full;
+    }
+};
+
+// 哈希结点 - 直接作为槽位存放在结点数组中
+// mutable_data 仅供容器内部搬运时移动 key 使用 对外只暴露 data
 template<typename Key, typename Value>
-struct HashNode
+union HashNode
 {
     // pair存储数据
     std::pair<const Key, Value> data;
+    std::pair<Key, Value> mutable_data;
 
-    HashNode* next;
+    HashNode() {}
+    ~HashNode() {}
+};
+
+// 迭代器 顺序扫描控制字节 跳过非满槽位
+// 渐进式 rehash 期间先走旧表 走完后经 next_* 接到新表
+template<typename Key, typename Value, bool IsConst>
+class HashIterator
+{
+    template<typename, typename, typename, typename, typename, typename>
+    friend class Unordered_map;
+    template<typename, typename, bool>
+    friend class HashIterator;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::pair<const Key, Value>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = typename std::conditional<IsConst, const value_type*, value_type*>::type;
+    using reference         = typename std::conditional<IsConst, const value_type&, value_type&>::type;
 
-    HashNode(const Key& key, Value& value)
-    : data(key, value), next(nullptr) {}
+private:
+    using node_type = HashNode<Key, Value>;
+
+    const ctrl_t* ctrl;
+    node_type* node;
+    const ctrl_t* ctrl_end;
+    // 当前表走完后接着走的表 (只有旧表上的迭代器才有)
+    const ctrl_t* next_ctrl;
+    node_type* next_node;
+    const ctrl_t* next_end;
 
-    HashNode(const Key& key, Value&& value)
-    : data(key, std::move(value)), next(nullptr) {}
+    HashIterator(const ctrl_t* c, node_type* n, const ctrl_t* e,
+                 const ctrl_t* nc = nullptr, node_type* nn = nullptr, const ctrl_t* ne = nullptr)
+    : ctrl(c), node(n), ctrl_end(e), next_ctrl(nc), next_node(nn), next_end(ne) {}
 
-    ~HashNode() = default;
+    void skip_empty()
+    {
+        while(true)
+        {
+            while(ctrl != ctrl_end && !HashCtrl::is_full(*ctrl))
+            {
+                ++ctrl;
+                ++node;
+            }
+            if(ctrl != ctrl_end || next_ctrl == nullptr)
+                return;
+            ctrl = next_ctrl;
+            node = next_node;
+            ctrl_end = next_end;
+            next_ctrl = nullptr;
+        }
+    }
+
+public:
+    HashIterator()
+    : ctrl(nullptr), node(nullptr), ctrl_end(nullptr), next_ctrl(nullptr), next_node(nullptr), next_end(nullptr) {}
+
+    // 非const -> const
+    template<bool C = IsConst, typename = typename std::enable_if<C>::type>
+    HashIterator(const HashIterator<Key, Value, false>& other)
+    : ctrl(other.ctrl), node(other.node), ctrl_end(other.ctrl_end),
+      next_ctrl(other.next_ctrl), next_node(other.next_node), next_end(other.next_end) {}
+
+    reference operator*() const { return node->data; }
+    pointer operator->() const { return &node->data; }
+
+    HashIterator& operator++()
+    {
+        ++ctrl;
+        ++node;
+        skip_empty();
+        return *this;
+    }
+
+    HashIterator operator++(int)
+    {
+        HashIterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    friend bool operator==(const HashIterator& a, const HashIterator& b) { return a.ctrl == b.ctrl; }
+    friend bool operator!=(const HashIterator& a, const HashIterator& b) { return a.ctrl != b.ctrl; }
+};
+
+// 结点句柄: extract 取出的元素 不属于任何 map 可以改 key 后插回或插入另一个 map
+// 结点内联在槽位数组里 没有单独的结点内存可以转交
+// 句柄持有从槽位搬出的元素本身 不会分配内存 Key 与 Value 都可平凡搬运时只是一次 memcpy
+template<typename Key, typename Value, typename Alloc>
+class HashNodeHandle
+{
+    template<typename, typename, typename, typename, typename, typename>
+    friend class Unordered_map;
+
+public:
+    using key_type          = Key;
+    using mapped_type       = Value;
+    using allocator_type    = Alloc;
+
+    HashNodeHandle() : has_value(false) {}
+    HashNodeHandle(HashNodeHandle&& other) noexcept(std::is_nothrow_move_constructible<std::pair<Key, Value>>::value)
+    : allocator(other.allocator), has_value(false)
+    {
+        if(other.has_value)
+        {
+            take(&other.node.mutable_data);
+            other.has_value = false;
+        }
+    }
+    HashNodeHandle& operator=(HashNodeHandle&& other)
+    {
+        if(this != &other)
+        {
+            reset();
+            allocator = other.allocator;
+            if(other.has_value)
+            {
+                take(&other.node.mutable_data);
+                other.has_value = false;
+            }
+        }
+        return *this;
+    }
+    HashNodeHandle(const HashNodeHandle&) = delete;
+    HashNodeHandle& operator=(const HashNodeHandle&) = delete;
+
+    ~HashNodeHandle()
+    { reset(); }
+
+    bool empty() const
+    { return !has_value; }
+    explicit operator bool() const
+    { return has_value; }
+
+    // 元素已不在表中 key 可以修改
+    Key& key() const
+    { return node.mutable_data.first; }
+    Value& mapped() const
+    { return node.mutable_data.second; }
+
+    Alloc get_allocator() const
+    { return allocator; }
+
+    // 析构持有的元素
+    void reset()
+    {
+        if(has_value)
+        {
+            allocator.destroy(&node.mutable_data);
+            has_value = false;
+        }
+    }
+
+private:
+    explicit HashNodeHandle(const Alloc& alloc) : allocator(alloc), has_value(false) {}
+
+    // 把 src 处的元素搬进来 之后 src 视为未构造 抛异常时 src 不变
+    void take(std::pair<Key, Value>* src)
+    {
+        uninitialized_relocate(allocator, src, src + 1, &node.mutable_data);
+        has_value = true;
+    }
+
+    mutable HashNode<Key, Value> node;
+    Alloc allocator;
+    bool has_value;
 };
 
 template<
@@ -37,35 +460,367 @@ template<
     typename Value,
     typename Hash = std::hash<Key>,
     typename KeyEqual = std::equal_to<Key>,
-    typename Alloc = Allocator<HashNode<Key, Value>>
+    typename Alloc = Allocator<HashNode<Key, Value>>,
+    typename Mixer = HashMixFibonacci
 >
 class Unordered_map
 {
+    // merge 需要访问其他 Hash/KeyEqual/Mixer 的 map 的槽位
+    template<typename, typename, typename, typename, typename, typename>
+    friend class Unordered_map;
+
 public:
-    using node_type = HashNode<Key, Value>;
-    using size_type = size_t;
+    using key_type          = Key;
+    using mapped_type       = Value;
+    using value_type        = std::pair<const Key, Value>;
+    using node_type         = HashNode<Key, Value>;
+    using size_type         = std::size_t;
+    using hasher_type       = Hash;
+    using key_equal_type    = KeyEqual;
+    using mixer_type        = Mixer;
+    using iterator          = HashIterator<Key, Value, false>;
+    using const_iterator    = HashIterator<Key, Value, true>;
+    // std 中的 node_type 在这里已是槽位结点 句柄另起名字
+    using node_handle       = HashNodeHandle<Key, Value, Alloc>;
+
+    // insert(node_handle&&) 的结果 未插入时句柄原样交还
+    struct insert_return_type
+    {
+        iterator position;
+        bool inserted;
+        node_handle node;
+    };
 
 private:
-    // 桶数组
-    Vector<node_type*> buckets;
+    using ctrl_alloc_type = typename Alloc::template rebind<ctrl_t>::other;
+
+    // 控制字节数组 长度 capacity + width 末尾 width 个字节是开头的镜像
+    // 这样从任意槽位起读一整个 group 都不会越界
+    ctrl_t* ctrl;
+    // 结点数组 长度 capacity
+    node_type* nodes;
+    // 槽位数 0 或 2的幂(>= group 宽度)
+    size_type _capacity;
     // 元素总数
     size_type _size;
-    
+    // 不触发扩容还能占用的空槽位数 (已删除槽位不计入)
+    size_type growth_left;
+
+    // 渐进式 rehash 的旧表 old_capacity == 0 表示没有在搬运
+    // 已搬走的槽位标为已删除 旧表的探测链保持完整
+    ctrl_t* old_ctrl = nullptr;
+    node_type* old_nodes = nullptr;
+    size_type old_capacity = 0;
+    size_type old_size = 0;             // 旧表中剩余元素数 (计入 _size)
+    size_type migrate_pos = 0;          // 旧表中 [0, migrate_pos) 已搬运
+    bool incremental = false;
+
     // 辅助器
     Alloc allocator;
+    ctrl_alloc_type ctrl_allocator;
     KeyEqual key_equal;
     Hash hasher;
+    Mixer mixer;
+
+    // 负载因子上限 7/8
+    static size_type max_load(size_type capacity)
+    { return capacity - capacity / 8; }
+
+    // 容纳 n 个元素需要的槽位数
+    static size_type capacity_for(size_type n);
+
+    template<typename K>
+    std::size_t hash_of(const K& key) const
+    { return mixer(hasher(key)); }
+
+    // 透明查找重载的开关 K 能转换成迭代器时不参与 避免和 erase(iterator) 冲突
+    template<typename K>
+    using transparent_key = typename std::enable_if<
+        has_is_transparent<Hash>::value && has_is_transparent<KeyEqual>::value
+        && !std::is_convertible<const K&, iterator>::value
+        && !std::is_convertible<const K&, const_iterator>::value, int>::type;
+
+    // 探测 / 控制字节的实现见 HashProbe
+    static size_type buckets_index(std::size_t hash, size_type capacity)
+    { return HashProbe::buckets_index(hash, capacity); }
+    size_type buckets_index(std::size_t hash) const
+    { return buckets_index(hash, _capacity); }
+
+    static ctrl_t h2(std::size_t hash)
+    { return HashProbe::h2(hash); }
+
+    void set_ctrl(size_type i, ctrl_t c)
+    { HashProbe::set_ctrl(ctrl, _capacity, i, c); }
+
+    // 在给定的表中查找 key 所在槽位 不存在返回 capacity
+    // K 为 Key 或透明查找时的其他类型 下同
+    template<typename K>
+    size_type find_in(const ctrl_t* c, const node_type* n, size_type capacity, const K& key, std::size_t hash) const;
+    // 查找 key 所在槽位 不存在返回 _capacity
+    template<typename K>
+    size_type find_index(const K& key, std::size_t hash) const
+    { return find_in(ctrl, nodes, _capacity, key, hash); }
+    // 在旧表中查找 不在搬运或不存在时返回 old_capacity
+    template<typename K>
+    size_type find_old_index(const K& key, std::size_t hash) const
+    { return old_size ? find_in(old_ctrl, old_nodes, old_capacity, key, hash) : old_capacity; }
+    // find / contains / erase 的实现 同时查新旧两张表
+    template<typename K>
+    iterator find_key(const K& key);
+    template<typename K>
+    const_iterator find_key(const K& key) const;
+    template<typename K>
+    bool contains_key(const K& key) const;
+    template<typename K>
+    size_type erase_key(const K& key);
+    // 沿探测序列找到第一个空/已删除槽位
+    size_type find_first_non_full(std::size_t hash) const
+    { return HashProbe::find_first_non_full(ctrl, _capacity, hash); }
+    // 占用一个新槽位(设置控制字节 计数) 必要时先扩容 返回槽位下标 结点尚未构造
+    size_type prepare_insert(std::size_t hash);
+    // 查找 key 不存在则准备一个槽位 返回 <位置, 是否新槽位> 新槽位总在新表中
+    // 渐进式 rehash 期间命中旧表时原地返回 不搬运 (只是查到已有元素 不使任何迭代器失效)
+    std::pair<iterator, bool> find_or_prepare_insert(const Key& key);
+    // 在 prepare_insert 得到的槽位上构造结点 构造失败则退还槽位
+    template<typename... Args>
+    void construct_at(size_type i, Args&&... args);
+
+    void erase_index(size_type i);
+    // 槽位 i 的元素已析构或已搬走 更新控制字节和计数
+    void vacate_index(size_type i);
+    // 把 src 处的元素搬到 prepare_insert 得到的槽位 i 搬运抛异常时退还槽位 src 不变
+    void relocate_into(size_type i, std::pair<Key, Value>* src);
+    // 合并时搬运 source 中的一个元素 本表已有该 key 时返回 false 元素留在原处
+    bool merge_one(std::pair<Key, Value>* src);
 
-    // rehash阈值
-    double max_load_factor = 1.00;
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace_key(K&& key, Args&&... args);
+    template<typename K, typename M>
+    std::pair<iterator, bool> insert_or_assign_key(K&& key, M&& value);
 
-    // 计算key对应的下标
-    size_type buckets_index(const Key& key, size_type bucket_count) const
+    // 分配 capacity 个空槽位的控制字节和结点 (不改动成员) / 释放
+    void allocate_arrays(size_type capacity, ctrl_t*& new_ctrl, node_type*& new_nodes);
+    void deallocate_arrays(ctrl_t* c, node_type* n, size_type capacity);
+    // 分配 capacity 个空槽位作为当前表 (不释放旧表)
+    void allocate_table(size_type capacity);
+    // 析构所有元素 释放内存 回到空表状态
+    void release();
+    // 重新分配到 new_capacity 个槽位 所有元素重新探测放置 (调用前旧表已搬完)
+    // 哈希函数或拷贝抛异常时原表不变
+    void resize(size_type new_capacity);
+
+    // ---- 渐进式 rehash ----
+    // 每次插入搬运的旧表槽位数 新表容量不小于旧表 在新表填满前一定能搬完
+    static constexpr size_type rehash_step = HashGroup::width;
+    // 当前表变为旧表 分配 new_capacity 个槽位的新表 元素暂不搬运
+    void start_migration(size_type new_capacity);
+    // 把旧表槽位 j 的元素搬到新表 返回新表中的下标
+    size_type migrate_slot(size_type j);
+    // 搬运 rehash_step 个旧表槽位 搬完后释放旧表 (由插入新元素和 erase(key) 调用)
+    void migrate_step();
+    // 搬完旧表剩余的所有元素
+    void finish_migration();
+    // 释放旧表内存 (元素已全部搬走或已析构)
+    void release_old();
+    // 快照读入后抽查: 表中元素重新计算的 h2 应与控制字节一致
+    bool snapshot_hashes_match() const;
+    // 写出一张表的槽位数组 空 / 已删除槽位写零 (未初始化内存或已析构的旧元素不落盘)
+    static void write_snapshot_slots(std::FILE* out, const ctrl_t* c, const node_type* n, size_type capacity);
+    void erase_old_index(size_type j);
+    void vacate_old_index(size_type j);
+    bool in_old_table(const ctrl_t* c) const
     {
-        return hasher(key) % bucket_count;
+        return old_capacity && !std::less<const ctrl_t*>()(c, old_ctrl)
+            && std::less<const ctrl_t*>()(c, old_ctrl + old_capacity);
     }
+
+    // 批量查找的公共部分: 先算出一批 key 的 hash 并预取探测起点的控制字节和结点
+    // 再逐个解析 对第 k 个 key 调用 f(k, hash, 新表下标) 不存在时下标为 _capacity
+    template<typename F>
+    void lookup_batch(const Key* keys, size_type count, F f) const;
+
+    // 新表迭代器对应的槽位下标
+    size_type index_of(const_iterator pos) const
+    { return pos.node - nodes; }
+
+    iterator iterator_at(size_type i)
+    { return iterator(ctrl + i, nodes + i, ctrl + _capacity); }
+    const_iterator iterator_at(size_type i) const
+    { return const_iterator(ctrl + i, nodes + i, ctrl + _capacity); }
+    // 旧表上的迭代器 走完旧表后接到新表
+    iterator old_iterator_at(size_type j)
+    { return iterator(old_ctrl + j, old_nodes + j, old_ctrl + old_capacity, ctrl, nodes, ctrl + _capacity); }
+    const_iterator old_iterator_at(size_type j) const
+    { return const_iterator(old_ctrl + j, old_nodes + j, old_ctrl + old_capacity, ctrl, nodes, ctrl + _capacity); }
+
+public:
+    // ---------------------- 构造函数 --------------------------
+    // 控制字节的分配器由 allocator rebind 而来 有状态的分配器 (内存池) 两者共用同一个资源
+    Unordered_map()
+    : ctrl(nullptr), nodes(nullptr), _capacity(0), _size(0), growth_left(0), ctrl_allocator(allocator) {}
+    // 指定分配器 (有状态的分配器 如 arena/内存池)
+    explicit Unordered_map(const Alloc& alloc)
+    : ctrl(nullptr), nodes(nullptr), _capacity(0), _size(0), growth_left(0),
+      allocator(alloc), ctrl_allocator(alloc) {}
+    // 预留可容纳 n 个元素的空间
+    explicit Unordered_map(size_type n);
+    // 参数列表
+    Unordered_map(std::initializer_list<value_type> il);
+    // 拷贝
+    Unordered_map(const Unordered_map& other);
+    // 移动
+    Unordered_map(Unordered_map&& other) noexcept;
+
+    // 赋值
+    Unordered_map& operator=(const Unordered_map& rhs);
+    Unordered_map& operator=(Unordered_map&& rhs) noexcept;
+
+    ~Unordered_map();
+
+    // ------------------------- 常用方法 ------------------------
+    size_type size() const
+    { return _size; }
+
+    bool empty() const
+    { return _size == 0; }
+
+    // 槽位数
+    size_type bucket_count() const
+    { return _capacity; }
+
+    float load_factor() const
+    { return _capacity ? static_cast<float>(_size) / _capacity : 0.0f; }
+
+    float max_load_factor() const
+    { return 0.875f; }
+
+    Alloc get_allocator() const
+    { return allocator; }
+
+    iterator begin();
+    iterator end()
+    { return iterator_at(_capacity); }
+    const_iterator begin() const;
+    const_iterator end() const
+    { return iterator_at(_capacity); }
+    const_iterator cbegin() const
+    { return begin(); }
+    const_iterator cend() const
+    { return end(); }
+
+    // 预留可容纳 n 个元素的空间
+    void reserve(size_type n);
+    // 按元素个数重建表 n 为槽位数下限 可用于清理已删除槽位
+    void rehash(size_type n);
+
+    // 渐进式 rehash 开关 (默认关闭) 关闭时若正在搬运则一次搬完
+    // 开启后扩容只分配新表 旧表元素在之后的插入和 erase(key) 中每次搬运 rehash_step 个槽位
+    // 迭代器失效规则: 插入新元素可能使所有迭代器失效 key 已存在时不会
+    // 搬运期间 erase(key) 也可能使所有迭代器失效 erase(iterator) / extract 只影响被删元素
+    void set_incremental_rehash(bool enable);
+    bool incremental_rehash() const
+    { return incremental; }
+    // 是否有尚未搬完的旧表
+    bool rehashing() const
+    { return old_capacity != 0; }
+
+    // 插入 - 已存在则不修改 返回 <位置, 是否插入>
+    std::pair<iterator, bool> insert(const value_type& value);
+    std::pair<iterator, bool> insert(value_type&& value);
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+
+    // key 不存在时才用 args 构造 value 已存在时 key 和 args 都不会被移动
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+    { return try_emplace_key(key, std::forward<Args>(args)...); }
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+    { return try_emplace_key(std::move(key), std::forward<Args>(args)...); }
+
+    // 不存在则插入 存在则赋值 返回 <位置, 是否插入>
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& value)
+    { return insert_or_assign_key(key, std::forward<M>(value)); }
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& value)
+    { return insert_or_assign_key(std::move(key), std::forward<M>(value)); }
+
+    // 取出元素 (不析构) 交给句柄 槽位按删除处理 其他迭代器不失效
+    node_handle extract(const_iterator pos);
+    node_handle extract(const Key& key);
+    // 插入句柄中的元素 key 已存在时不插入 句柄交还给调用者
+    insert_return_type insert(node_handle&& nh);
+
+    // 把 source 中本表没有的 key 对应的元素搬过来 已有的留在 source
+    // 元素直接从 source 的槽位搬到本表槽位 不经过临时对象
+    template<typename H2, typename E2, typename M2>
+    void merge(Unordered_map<Key, Value, H2, E2, Alloc, M2>& source);
+    template<typename H2, typename E2, typename M2>
+    void merge(Unordered_map<Key, Value, H2, E2, Alloc, M2>&& source)
+    { merge(source); }
+
+    // 不存在时默认构造 value
+    Value& operator[](const Key& key);
+    Value& operator[](Key&& key);
+
+    Value& at(const Key& key);
+    const Value& at(const Key& key) const;
+
+    iterator find(const Key& key)
+    { return find_key(key); }
+    const_iterator find(const Key& key) const
+    { return find_key(key); }
+    size_type count(const Key& key) const
+    { return contains_key(key) ? 1 : 0; }
+    bool contains(const Key& key) const
+    { return contains_key(key); }
+
+    // 透明查找 (Hash 与 KeyEqual 都有 is_transparent 时可用) 如 StringHash + std::equal_to<>
+    // 用 std::string_view 查 std::string key 不会构造临时 string
+    template<typename K, transparent_key<K> = 0>
+    iterator find(const K& key)
+    { return find_key(key); }
+    template<typename K, transparent_key<K> = 0>
+    const_iterator find(const K& key) const
+    { return find_key(key); }
+    template<typename K, transparent_key<K> = 0>
+    size_type count(const K& key) const
+    { return contains_key(key) ? 1 : 0; }
+    template<typename K, transparent_key<K> = 0>
+    bool contains(const K& key) const
+    { return contains_key(key); }
+
+    // 批量查找: out[k] 为 keys[k] 的查找结果 (不存在为 end())
+    // 一批 key 先统一算 hash 并发出预取 多个 cache miss 的等待相互重叠
+    void find_batch(const Key* keys, size_type count, iterator* out);
+    void find_batch(const Key* keys, size_type count, const_iterator* out) const;
+    void contains_batch(const Key* keys, size_type count, bool* out) const;
+
+    // 删除 返回删除个数
+    size_type erase(const Key& key)
+    { return erase_key(key); }
+    template<typename K, transparent_key<K> = 0>
+    size_type erase(const K& key)
+    { return erase_key(key); }
+    // 删除 返回下一个元素的迭代器
+    iterator erase(const_iterator pos);
+    iterator erase(iterator pos);
+
+    void clear();
+    void swap(Unordered_map& other) noexcept;
+
+    // ------------------------- 快照 ---------------------------
+    // 二进制快照 (格式见 snapshot.h) 仅限 Key 与 Value 都可平凡拷贝
+    // 内容是控制字节数组与槽位数组的原样字节 (渐进式 rehash 中还有旧表) 读取时不重新哈希
+    // 读取后抽查部分元素的 h2 与控制字节是否一致 哈希函数 / Mixer 与保存时不同会被发现
+    // 按路径保存时先写临时文件再改名 读取失败时本容器不变
+    void save_snapshot(std::FILE* out) const;
+    void save_snapshot(const std::string& path) const;
+    void load_snapshot(std::FILE* in);
+    void load_snapshot(const std::string& path);
 };
 
 #include "Unordered_map.cpp"
 
-#endif // YXY__STL__UNORDERED_MAP_H
\ No newline at end of file
+#endif // YXY__STL__UNORDERED_MAP_H
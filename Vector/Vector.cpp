@@ -1,7 +1,7 @@
 #include "Vector.h"
 
-template<typename T, typename Alloc>
-Vector<T, Alloc>::Vector(size_type capacity)
+template<typename T, typename Alloc, typename GrowthPolicy>
+Vector<T, Alloc, GrowthPolicy>::Vector(size_type capacity)
 {
     start = allocator.allocate(capacity);
     finish = start;
@@ -22,8 +22,8 @@ Vector<T, Alloc>::Vector(size_type capacity)
     }
 }
 
-template<typename T, typename Alloc>
-Vector<T, Alloc>::Vector(size_type capacity, const value_type& value)
+template<typename T, typename Alloc, typename GrowthPolicy>
+Vector<T, Alloc, GrowthPolicy>::Vector(size_type capacity, const value_type& value)
 {
     start = allocator.allocate(capacity);
     finish = start;
@@ -44,8 +44,8 @@ Vector<T, Alloc>::Vector(size_type capacity, const value_type& value)
     }
 }
 
-template<typename T, typename Alloc>
-Vector<T, Alloc>::Vector(std::initializer_list<value_type> il)
+template<typename T, typename Alloc, typename GrowthPolicy>
+Vector<T, Alloc, GrowthPolicy>::Vector(std::initializer_list<value_type> il)
 {
     size_type n = il.size();
     start = allocator.allocate(n);
@@ -68,8 +68,9 @@ Vector<T, Alloc>::Vector(std::initializer_list<value_type> il)
     }
 }   
 
-template<typename T, typename Alloc>
-Vector<T, Alloc>::Vector(const Vector& other)
+template<typename T, typename Alloc, typename GrowthPolicy>
+Vector<T, Alloc, GrowthPolicy>::Vector(const Vector& other)
+: allocator(other.allocator)
 {
     this->start = this->allocator.allocate(other.size());
     this->end_of_storage = this->start + other.size();
@@ -91,45 +92,35 @@ Vector<T, Alloc>::Vector(const Vector& other)
     }
 }
 
-template<typename T, typename Alloc>
-Vector<T, Alloc>::Vector(Vector&& other) noexcept
-: start(other.start), finish(other.finish), end_of_storage(other.end_of_storage)
+template<typename T, typename Alloc, typename GrowthPolicy>
+Vector<T, Alloc, GrowthPolicy>::Vector(Vector&& other) noexcept
+: start(other.start), finish(other.finish), end_of_storage(other.end_of_storage),
+  allocator(other.allocator)        // 有状态的分配器(内存池等)需随内存一起转移
 {
     other.start = nullptr;
     other.finish = nullptr;
     other.end_of_storage = nullptr;
 }
 
-template<typename T, typename Alloc>
-Vector<T, Alloc>::Vector(const_iterator first, const_iterator last)
+template<typename T, typename Alloc, typename GrowthPolicy>
+template<typename InputIt, typename>
+Vector<T, Alloc, GrowthPolicy>::Vector(InputIt first, InputIt last)
+: start(nullptr), finish(nullptr), end_of_storage(nullptr)
 {
-    size_type n = last >= first ? last - first : 0;
-
-    start = allocator.allocate(n);
-    finish = start;
-    end_of_storage = start + n;
-
     try
     {
-        while(first != last)
-        {
-            allocator.construct(finish, *first);
-            ++finish;
-            ++first;
-        }
+        append(first, last);
     }
     catch(...)
     {
-        for(auto it = start;it!=finish;++it)
-            allocator.destroy(it);
-        allocator.deallocate(start, n);
+        destroy_range(allocator, start, finish);
+        allocator.deallocate(start, capacity());
         throw;
     }
-    
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::Vector& Vector<T, Alloc>::operator=(const Vector& rhs) 
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::Vector& Vector<T, Alloc, GrowthPolicy>::operator=(const Vector& rhs) 
 {
     if(this != &rhs)
     {
@@ -157,8 +148,8 @@ typename Vector<T, Alloc>::Vector& Vector<T, Alloc>::operator=(const Vector& rhs
     return *this;
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::Vector& Vector<T, Alloc>::operator=(Vector&& rhs)
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::Vector& Vector<T, Alloc, GrowthPolicy>::operator=(Vector&& rhs)
 {
     if(this != &rhs)
     {
@@ -169,6 +160,7 @@ typename Vector<T, Alloc>::Vector& Vector<T, Alloc>::operator=(Vector&& rhs)
             allocator.deallocate(start, capacity());
         }
 
+        allocator = rhs.allocator;
         start = rhs.start;
         finish = rhs.finish;
         end_of_storage = rhs.end_of_storage;
@@ -181,83 +173,244 @@ typename Vector<T, Alloc>::Vector& Vector<T, Alloc>::operator=(Vector&& rhs)
 }
 
 
-template<typename T, typename Alloc>
-void Vector<T, Alloc>::reserve(size_type n)
+template<typename T, typename Alloc, typename GrowthPolicy>
+AllocationResult<typename Vector<T, Alloc, GrowthPolicy>::pointer> Vector<T, Alloc, GrowthPolicy>::allocate_storage(size_type n)
+{
+    if constexpr(allocator_has_allocate_at_least<Alloc>::value)
+        return allocator.allocate_at_least(n);
+    else
+        return {allocator.allocate(n), n};
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+bool Vector<T, Alloc, GrowthPolicy>::grow_in_place(size_type n)
+{
+    if(!start)
+        return false;
+
+    // 原地扩展: 地址不变 任何类型都适用
+    if constexpr(allocator_has_try_expand<Alloc>::value)
+    {
+        if(allocator.try_expand(start, capacity(), n))
+        {
+            end_of_storage = start + n;
+            return true;
+        }
+    }
+    // 重新映射: 地址可能改变 内容按字节保留 只适用于可平凡搬运的类型
+    if constexpr(allocator_has_reallocate<Alloc>::value && is_trivially_relocatable<T>::value)
+    {
+        size_type len = size();
+        pointer p = allocator.reallocate(start, capacity(), n);
+        if(p)
+        {
+            start = p;
+            finish = p + len;
+            end_of_storage = p + n;
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::reserve(size_type n)
 {
     // ---> 若 新容量 <= 原容量 直接退出
     if(n <= capacity())
         return;
-    
-    // ---> 定义新指针
-    pointer new_start = allocator.allocate(n);
-    pointer new_finish = new_start;
-    pointer new_end_of_storage = new_start + n;
 
-    // ---> 移动/拷贝构造元素 -> 新容器内存地址
-    // 此处try-catch中 
-    // 若构造函数noexcept则使用移动构造 此时不会进入catch;
+    // ---> 分配器支持时 直接扩展原内存块 (大块 mremap 不拷贝数据)
+    if(grow_in_place(n))
+        return;
+    
+    // ---> 定义新指针 (分配器多给的空间也计入容量)
+    AllocationResult<pointer> block = allocate_storage(n);
+    pointer new_start = block.ptr;
+    pointer new_finish;
+
+    // ---> 搬运元素 -> 新容器内存地址
+    // 可平凡搬运的类型直接 memcpy 整段 旧内存无需逐个析构
+    // 否则 若构造函数noexcept则使用移动构造 此时不会进入catch;
     // 否则使用拷贝构造保证原容器析构/释放内存时不会出现问题
     try
     {
-        for(auto it = start;it!=finish;++it)
-        {
-            allocator.construct(new_finish, std::move_if_noexcept(*it));
-            ++new_finish;
-        }
+        new_finish = uninitialized_relocate(allocator, start, finish, new_start);
     }
     catch(...)
     {
-        for(auto it = new_start;it!=new_finish;++it)
-            allocator.destroy(it);
-        allocator.deallocate(new_start, n);
+        allocator.deallocate(new_start, block.count);
         throw;
     }
     
-    // ---> 原容器元素析构并释放内存
-    for(auto it = start;it!=finish;++it)
-        allocator.destroy(it);
+    // ---> 释放原内存 (元素已在搬运时析构)
     allocator.deallocate(start, capacity());        // 此时指针指向不变     capacity()仍为原容器容量
 
     // ---> 更新指针指向
     start = new_start;
     finish = new_finish;
-    end_of_storage = new_end_of_storage;
+    end_of_storage = new_start + block.count;
 }
 
-template<typename T, typename Alloc>
-void Vector<T, Alloc>::push_back(const value_type& value)
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::shrink_to_fit()
 {
-    // 扩容
     if(finish == end_of_storage)
-        reserve(capacity() != 0 ? capacity() * 2 : 1);
-    
-    allocator.construct(finish, value);
-    ++finish;
+        return;
+
+    if(empty())
+    {
+        allocator.deallocate(start, capacity());
+        start = finish = end_of_storage = nullptr;
+        return;
+    }
+
+    size_type n = size();
+    pointer new_start = allocator.allocate(n);
+    pointer new_finish;
+    try
+    {
+        new_finish = uninitialized_relocate(allocator, start, finish, new_start);
+    }
+    catch(...)
+    {
+        allocator.deallocate(new_start, n);
+        throw;
+    }
+    allocator.deallocate(start, capacity());
+
+    start = new_start;
+    finish = new_finish;
+    end_of_storage = new_start + n;
 }
 
-template<typename T, typename Alloc>
-void Vector<T, Alloc>::push_back(value_type&& value)
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::clear()
 {
-    // 扩容
-    if(finish == end_of_storage)
-        reserve(capacity() != 0 ? capacity() * 2 : 1);
+    destroy_range(allocator, start, finish);
+    finish = start;
+}
 
-    allocator.construct(finish, std::move(value));
-    ++finish;
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::resize(size_type n)
+{
+    if(n <= size())
+    {
+        erase(start + n, finish);
+        return;
+    }
+    if(n > capacity())
+        reserve(next_capacity(n));
+    pointer old_finish = finish;
+    try
+    {
+        for(;finish != start + n;++finish)
+            allocator.construct(finish);
+    }
+    catch(...)
+    {
+        // 保持原有元素个数不变
+        destroy_range(allocator, old_finish, finish);
+        finish = old_finish;
+        throw;
+    }
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::resize(size_type n, const value_type& value)
+{
+    if(n <= size())
+    {
+        erase(start + n, finish);
+        return;
+    }
+    if(n > capacity())
+    {
+        // value 可能引用容器内元素 扩容前先拷贝一份
+        value_type tmp(value);
+        reserve(next_capacity(n));
+        while(finish != start + n)
+        {
+            allocator.construct(finish, tmp);
+            ++finish;
+        }
+        return;
+    }
+    while(finish != start + n)
+    {
+        allocator.construct(finish, value);
+        ++finish;
+    }
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::resize_default_init(size_type n)
+{
+    if(n <= size())
+    {
+        erase(start + n, finish);
+        return;
+    }
+    append_default_init(n - size());
 }
 
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::pointer Vector<T, Alloc, GrowthPolicy>::append_default_init(size_type n)
+{
+    if(n > size_type(end_of_storage - finish))
+        reserve(next_capacity(size() + n));
+
+    pointer first = finish;
+    if(std::is_trivially_default_constructible<value_type>::value)
+    {
+        // 默认初始化平凡类型什么也不做 直接移动尾指针
+        finish += n;
+        return first;
+    }
+    try
+    {
+        for(;finish != first + n;++finish)
+            ::new(static_cast<void*>(finish)) value_type;
+    }
+    catch(...)
+    {
+        destroy_range(allocator, first, finish);
+        finish = first;
+        throw;
+    }
+    return first;
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::push_back(const value_type& value)
+{
+    emplace_back(value);
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::push_back(value_type&& value)
+{
+    emplace_back(std::move(value));
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
 template<typename... Args>
-void Vector<T, Alloc>::emplace_back(Args&&... args)
+void Vector<T, Alloc, GrowthPolicy>::emplace_back(Args&&... args)
 {
     if(finish == end_of_storage)
-        reserve(capacity() != 0 ? capacity() * 2 : 1);
-    allocator.construct(finish, std::forward<Args>(args)...);
+    {
+        // 扩容 - 参数可能引用容器内元素 扩容会使其失效 所以先构造出来
+        value_type tmp(std::forward<Args>(args)...);
+        reserve(next_capacity(size() + 1));
+        allocator.construct(finish, std::move(tmp));
+    }
+    else
+        allocator.construct(finish, std::forward<Args>(args)...);
     ++finish;
 }
 
-template<typename T, typename Alloc>
-void Vector<T, Alloc>::pop_back()
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::pop_back()
 {
     if(empty())
         return;
@@ -265,213 +418,249 @@ void Vector<T, Alloc>::pop_back()
     allocator.destroy(--finish);
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::iterator Vector<T, Alloc>::insert(const_iterator pos, const value_type& value)
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::iterator Vector<T, Alloc, GrowthPolicy>::insert(const_iterator pos, const value_type& value)
+{
+    return emplace(pos, value);
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::iterator Vector<T, Alloc, GrowthPolicy>::insert(const_iterator pos, value_type&& value)
+{
+    return emplace(pos, std::move(value));
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+template<typename... Args>
+typename Vector<T, Alloc, GrowthPolicy>::iterator Vector<T, Alloc, GrowthPolicy>::emplace(const_iterator pos, Args&&... args)
 {
     size_type n = pos - start;
-    if(size() != capacity()) 
+    if(finish == end_of_storage)
+        return realloc_insert(n, std::forward<Args>(args)...);
+
+    iterator p = start + n;
+    if(p == finish)
     {
-        for(auto it = finish - 1;it>=pos;--it)
-        {
-            allocator.construct(it+1, std::move(*it));
-            allocator.destroy(it);
-        }
+        allocator.construct(finish, std::forward<Args>(args)...);
         ++finish;
-        allocator.construct(start + n, value);
-        return start + n;
+        return p;
+    }
+
+    // 参数可能引用容器内的元素 先构造出新元素再挪动
+    value_type tmp(std::forward<Args>(args)...);
+    finish = relocate_insert(allocator, p, finish, std::move(tmp));
+    return p;
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+template<typename... Args>
+typename Vector<T, Alloc, GrowthPolicy>::iterator Vector<T, Alloc, GrowthPolicy>::realloc_insert(size_type n, Args&&... args)
+{
+    AllocationResult<pointer> block = allocate_storage(next_capacity(size() + 1));
+    size_type new_capacity = block.count;
+    pointer new_start = block.ptr;
+    pointer new_pos = new_start + n;
+
+    // ---> 构造新元素 (参数可能引用旧内存 所以在搬运之前)
+    try
+    {
+        allocator.construct(new_pos, std::forward<Args>(args)...);
+    }
+    catch(...)
+    {
+        allocator.deallocate(new_start, new_capacity);
+        throw;
+    }
+
+    relocate_around_gap(block, n, new_pos + 1);
+    return start + n;
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::relocate_around_gap(AllocationResult<pointer> block, size_type n, pointer gap_end)
+{
+    pointer new_start = block.ptr;
+    pointer gap_begin = new_start + n;
+
+    // ---> 挪前一段 + 挪后一段
+    pointer new_finish;
+    if(is_trivially_relocatable<value_type>::value)
+    {
+        uninitialized_relocate(allocator, start, start + n, new_start);
+        new_finish = uninitialized_relocate(allocator, start + n, finish, gap_end);
     }
     else
     {
-        // 准备挪动
-        iterator new_start = allocator.allocate(capacity() != 0 ? capacity() * 2 : 1);
-        iterator new_finish = new_start;
-        iterator new_end_of_storage = new_start + (capacity() != 0 ? capacity() * 2 : 1);
-        iterator new_pos = start + n;
-        auto it = start;
-        
-        // 挪前一段
-        while(it < pos)
+        pointer mid = new_start;
+        try
         {
-            allocator.construct(new_finish, std::move(*it));
-            ++it;
-            ++new_finish;
+            mid = uninitialized_move_if_noexcept(allocator, start, start + n, new_start);
+            new_finish = uninitialized_move_if_noexcept(allocator, start + n, finish, gap_end);
         }
-        // 构造新元素
-        allocator.construct(new_finish++, value);
-        // 挪后一段
-        while(it<finish)
+        catch(...)
         {
-            allocator.construct(new_finish, std::move(*it));
-            ++it;
-            ++new_finish;
-        } 
-
-        // 销毁原Vector
-        for(auto i = start;i<finish;++i)
-            allocator.destroy(i);
-        allocator.deallocate(start, capacity());
-
-        // 挪指针
-        start = new_start;
-        finish = new_finish;
-        end_of_storage = new_end_of_storage;
-        return start + n;
+            destroy_range(allocator, new_start, mid);
+            destroy_range(allocator, gap_begin, gap_end);
+            allocator.deallocate(new_start, block.count);
+            throw;
+        }
+        // 销毁原Vector中的元素
+        destroy_range(allocator, start, finish);
     }
+    allocator.deallocate(start, capacity());
+
+    // 挪指针
+    start = new_start;
+    finish = new_finish;
+    end_of_storage = new_start + block.count;
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::iterator Vector<T, Alloc>::insert(const_iterator pos, value_type&& value)
+template<typename T, typename Alloc, typename GrowthPolicy>
+template<typename InputIt, typename>
+typename Vector<T, Alloc, GrowthPolicy>::iterator Vector<T, Alloc, GrowthPolicy>::insert(const_iterator pos, InputIt first, InputIt last)
 {
     size_type n = pos - start;
-    if(size() != capacity()) 
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+    if constexpr(std::is_base_of<std::forward_iterator_tag, category>::value)
     {
-        for(auto it = finish - 1;it>=pos;--it)
+        size_type count = std::distance(first, last);
+        if(count == 0)
+            return start + n;
+
+        if(count > size_type(end_of_storage - finish))
         {
-            allocator.construct(it+1, std::move(*it));
-            allocator.destroy(it);
+            // ---> 只扩容一次: 先在新内存中构造新元素 再把旧元素搬到两侧
+            AllocationResult<pointer> block = allocate_storage(next_capacity(size() + count));
+            pointer gap_end;
+            try
+            {
+                gap_end = uninitialized_copy_range(allocator, first, last, block.ptr + n);
+            }
+            catch(...)
+            {
+                allocator.deallocate(block.ptr, block.count);
+                throw;
+            }
+            relocate_around_gap(block, n, gap_end);
         }
-        ++finish;
-        allocator.construct(start + n, std::move(value));
-        return start + n;
-    }
-    else
-    {
-        // 准备挪动
-        iterator new_start = allocator.allocate(capacity() != 0 ? capacity() * 2 : 1);
-        iterator new_finish = new_start;
-        iterator new_end_of_storage = new_start + (capacity() != 0 ? capacity() * 2 : 1);
-        iterator new_pos = start + n;
-        auto it = start;
-        
-        // 挪前一段
-        while(it < pos)
+        else if(is_trivially_relocatable<value_type>::value)
         {
-            allocator.construct(new_finish, std::move(*it));
-            ++it;
-            ++new_finish;
+            // ---> 后一段整体后移 count 位 空出的位置直接构造
+            iterator p = start + n;
+            size_type tail = finish - p;
+            std::memmove(static_cast<void*>(p + count), static_cast<const void*>(p), tail * sizeof(value_type));
+            try
+            {
+                uninitialized_copy_range(allocator, first, last, p);
+            }
+            catch(...)
+            {
+                std::memmove(static_cast<void*>(p), static_cast<const void*>(p + count), tail * sizeof(value_type));
+                throw;
+            }
+            finish += count;
         }
-        // 构造新元素
-        allocator.construct(new_finish++, std::move(value));
-        // 挪后一段
-        while(it<finish)
+        else
         {
-            allocator.construct(new_finish, std::move(*it));
-            ++it;
-            ++new_finish;
-        } 
-
-        // 销毁原Vector
-        for(auto i = start;i<finish;++i)
-            allocator.destroy(i);
-        allocator.deallocate(start, capacity());
-
-        // 挪指针
-        start = new_start;
-        finish = new_finish;
-        end_of_storage = new_end_of_storage;
-        return start + n;
+            // ---> 先构造在末尾 再旋转到插入位置
+            size_type old_size = size();
+            finish = uninitialized_copy_range(allocator, first, last, finish);
+            std::rotate(start + n, start + old_size, finish);
+        }
     }
+    else
+    {
+        // 单遍迭代器无法预知个数 逐个追加后旋转到插入位置
+        size_type old_size = size();
+        for(;first != last;++first)
+            emplace_back(*first);
+        std::rotate(start + n, start + old_size, finish);
+    }
+    return start + n;
 }
 
-template<typename T, typename Alloc>
-template<typename... Args>
-typename Vector<T, Alloc>::iterator Vector<T, Alloc>::emplace(const_iterator pos, Args&&... args)
+template<typename T, typename Alloc, typename GrowthPolicy>
+template<typename InputIt, typename>
+void Vector<T, Alloc, GrowthPolicy>::assign(InputIt first, InputIt last)
 {
-    size_type n = pos - start;
-    if(size() != capacity()) 
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+    destroy_range(allocator, start, finish);
+    finish = start;
+    if constexpr(std::is_base_of<std::forward_iterator_tag, category>::value)
     {
-        // 这里使用赋值运算 增加缓存复用
-        allocator.construct(finish, std::move(*(finish - 1)));
-        std::move_backward(pos, finish - 1, finish);
-        ++finish;
-        allocator.construct(start + n, std::forward<Args>(args)...);
-        return start + n;
+        size_type count = std::distance(first, last);
+        if(count > capacity())
+        {
+            // 旧内容已清空 直接换一块刚好够用的内存 无需搬运
+            AllocationResult<pointer> block = allocate_storage(count);
+            allocator.deallocate(start, capacity());
+            start = finish = block.ptr;
+            end_of_storage = block.ptr + block.count;
+        }
+        finish = uninitialized_copy_range(allocator, first, last, start);
     }
     else
     {
-        // 准备挪动
-        iterator new_start = allocator.allocate(capacity() != 0 ? capacity() * 2 : 1);
-        iterator new_finish = new_start;
-        iterator new_end_of_storage = new_start + (capacity() != 0 ? capacity() * 2 : 1);
-        iterator new_pos = start + n;
-        auto it = start;
-        
-        // 挪前一段
-        while(it < pos)
-        {
-            allocator.construct(new_finish, std::move(*it));
-            ++it;
-            ++new_finish;
-        }
-        // 构造新元素
-        allocator.construct(new_finish++, std::forward<Args>(args)...);
-        // 挪后一段
-        while(it<finish)
-        {
-            allocator.construct(new_finish, std::move(*it));
-            ++it;
-            ++new_finish;
-        } 
-
-        // 销毁原Vector
-        for(auto i = start;i<finish;++i)
-            allocator.destroy(i);
-        allocator.deallocate(start, capacity());
+        for(;first != last;++first)
+            emplace_back(*first);
+    }
+}
 
-        // 挪指针
-        start = new_start;
-        finish = new_finish;
-        end_of_storage = new_end_of_storage;
-        return start + n;
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::assign(size_type n, const value_type& value)
+{
+    // value 可能引用容器内元素 先拷贝一份
+    value_type tmp(value);
+    destroy_range(allocator, start, finish);
+    finish = start;
+    reserve(n);
+    for(size_type i = 0;i<n;++i)
+    {
+        allocator.construct(finish, tmp);
+        ++finish;
     }
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::iterator Vector<T, Alloc>::erase(const_iterator pos)
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::iterator Vector<T, Alloc, GrowthPolicy>::erase(const_iterator pos)
 {
     if(!pos || pos >= finish)
         return start + (pos - start);
 
-    size_type n = pos - start;
-    for(auto it = start + n;it<finish - 1;++it)
-        *it = std::move(*(it+1));
-    allocator.destroy(--finish);
-    return start + n;
+    iterator p = start + (pos - start);
+    finish = relocate_erase(allocator, p, p + 1, finish);
+    return p;
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::iterator Vector<T, Alloc>::erase(const_iterator first, const_iterator last)
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::iterator Vector<T, Alloc, GrowthPolicy>::erase(const_iterator first, const_iterator last)
 {
     if(!first || !last || last <= first || last > finish || first < start)
         return start + (first - start);
     
-    size_type n = last - first;
-    size_type k = first - start;
-    for(auto it = start + k;it+n<finish;++it)
-        *it = std::move(*(it + n));
-    iterator new_finish = finish - n;
-    for(auto it = new_finish;it<finish;++it)
-        allocator.destroy(it);
-    finish = new_finish;
-    return start + k;
+    iterator p = start + (first - start);
+    finish = relocate_erase(allocator, p, p + (last - first), finish);
+    return p;
 }
 // 这里可以使用auto - C14特性来推到返回值类型 
 // 这样更方便编写代码 但不够清晰 这里选择一个函数使用此特性
 // 选择了front() 函数
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::reference Vector<T, Alloc>::operator[](size_type n)
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::reference Vector<T, Alloc, GrowthPolicy>::operator[](size_type n)
 {
     return *(start + n);
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::const_reference Vector<T, Alloc>::operator[](size_type n) const
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::const_reference Vector<T, Alloc, GrowthPolicy>::operator[](size_type n) const
 {
     return *(start + n);
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::reference Vector<T, Alloc>::at(size_type n)
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::reference Vector<T, Alloc, GrowthPolicy>::at(size_type n)
 {
     if(n >= size())
         throw std::out_of_range("Vector:: index out of range!");
@@ -479,8 +668,8 @@ typename Vector<T, Alloc>::reference Vector<T, Alloc>::at(size_type n)
     return *(start + n);
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::const_reference Vector<T, Alloc>::at(size_type n) const
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::const_reference Vector<T, Alloc, GrowthPolicy>::at(size_type n) const
 {
     if(n >= size())
         throw std::out_of_range("Vector:: index out of range!");
@@ -488,44 +677,91 @@ typename Vector<T, Alloc>::const_reference Vector<T, Alloc>::at(size_type n) con
     return *(start + n);
 }
 
-template<typename T, typename Alloc>
-auto& Vector<T, Alloc>::front() 
+template<typename T, typename Alloc, typename GrowthPolicy>
+auto& Vector<T, Alloc, GrowthPolicy>::front() 
 {
     return *start;
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::const_reference Vector<T, Alloc>::front() const
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::const_reference Vector<T, Alloc, GrowthPolicy>::front() const
 {
     return *start;
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::reference Vector<T, Alloc>::back()
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::reference Vector<T, Alloc, GrowthPolicy>::back()
 {
     return *(finish - 1);
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::const_reference Vector<T, Alloc>::back() const
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::const_reference Vector<T, Alloc, GrowthPolicy>::back() const
 {
     return *(finish - 1);
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::pointer Vector<T, Alloc>::data() noexcept
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::pointer Vector<T, Alloc, GrowthPolicy>::data() noexcept
 {
     return start;
 }
 
-template<typename T, typename Alloc>
-typename Vector<T, Alloc>::const_pointer Vector<T, Alloc>::data() const noexcept
+template<typename T, typename Alloc, typename GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::const_pointer Vector<T, Alloc, GrowthPolicy>::data() const noexcept
 {
     return start;
 }
 
-template<typename T, typename Alloc>
-Vector<T, Alloc>::~Vector()
+// ------------------------- 快照 ---------------------------
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::save_snapshot(std::FILE* out) const
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Vector snapshot requires a trivially copyable element type");
+    static_assert(alignof(T) <= snapshot_detail::alignment, "element alignment exceeds snapshot section alignment");
+    SnapshotHeader h = snapshot_detail::make_header(SnapshotKind::Vector, sizeof(T), alignof(T));
+    h.count = size();
+    snapshot_detail::write_bytes(out, &h, sizeof(h));
+    snapshot_detail::write_section(out, start, size() * sizeof(T));
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::save_snapshot(const std::string& path) const
+{
+    snapshot_detail::SnapshotFile file(path, true);
+    save_snapshot(file.get());
+    file.commit();
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::load_snapshot(std::FILE* in)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Vector snapshot requires a trivially copyable element type");
+    SnapshotHeader h;
+    snapshot_detail::read_bytes(in, &h, sizeof(h));
+    snapshot_detail::check_header(h, SnapshotKind::Vector, sizeof(T), alignof(T));
+    if(h.count > std::size_t(-1) / sizeof(T))
+        throw std::runtime_error("snapshot:: element count too large!");
+    // 表头中的个数来自文件 先和文件剩余长度比较 截断 / 损坏的文件不会导致巨量分配
+    if(h.count > snapshot_detail::remaining(in) / sizeof(T))
+        throw std::runtime_error("snapshot:: unexpected end of file!");
+
+    // 先读到临时容器 成功后再替换
+    Vector tmp(allocator);
+    tmp.resize_default_init(static_cast<size_type>(h.count));
+    snapshot_detail::read_section(in, tmp.start, tmp.size() * sizeof(T));
+    *this = std::move(tmp);
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::load_snapshot(const std::string& path)
+{
+    snapshot_detail::SnapshotFile file(path, false);
+    load_snapshot(file.get());
+}
+
+template<typename T, typename Alloc, typename GrowthPolicy>
+Vector<T, Alloc, GrowthPolicy>::~Vector()
 {
     if(start)
     {
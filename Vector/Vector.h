@@ -2,11 +2,23 @@
 #define YXY__STL__VECTOR_H
 
 #include "../allocator.h"
+#include "../relocate.h"
+#include "growth_policy.h"
+#include "../snapshot.h"
 #include<memory>
 #include<initializer_list>
 #include<stdexcept>
+#include<iterator>
+#include<algorithm>
+#include<type_traits>
 
-template<typename T, typename Alloc = Allocator<T>>
+// 仅当 It 是迭代器时启用 (避免 Vector<int>(5, 10) 匹配到范围版本)
+template<typename It>
+using RequireInputIter = typename std::enable_if<std::is_convertible<
+    typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>::value>::type;
+
+// GrowthPolicy: 扩容策略 见 growth_policy.h (默认 2 倍)
+template<typename T, typename Alloc = Allocator<T>, typename GrowthPolicy = GrowDouble>
 class Vector
 {
 public:
@@ -26,10 +38,31 @@ private:
 
     Alloc allocator;
 
+    // 按扩容策略计算 至少容纳 required 个元素的新容量
+    size_type next_capacity(size_type required) const
+    { return GrowthPolicy::next_capacity(capacity(), required, sizeof(value_type)); }
+
+    // 申请至少 n 个元素的内存 分配器支持 allocate_at_least 时按整块实际大小返回
+    AllocationResult<pointer> allocate_storage(size_type n);
+
+    // 借助分配器扩展 (try_expand / reallocate) 不经搬运把容量扩到 n 成功返回 true
+    bool grow_in_place(size_type n);
+
+    // 容量已满时插入: 分配新内存 先构造新元素 再把两段旧元素搬过去
+    template<typename... Args>
+    iterator realloc_insert(size_type n, Args&&... args);
+
+    // 扩容插入的后半步: 新内存 block 中 [ptr + n, gap_end) 已构造好新元素
+    // 把旧元素分两段搬到其两侧 释放旧内存并更新指针 失败时清理新内存
+    void relocate_around_gap(AllocationResult<pointer> block, size_type n, pointer gap_end);
+
 public:
     // ---------------------- 构造函数 --------------------------
     Vector()
     : start(nullptr), finish(nullptr), end_of_storage(nullptr) {}
+    // 指定分配器 (有状态的分配器 如 arena/内存池)
+    explicit Vector(const Alloc& alloc)
+    : start(nullptr), finish(nullptr), end_of_storage(nullptr), allocator(alloc) {}
     // 容量
     Vector(size_type capacity);
     // 容量 + 初值
@@ -40,8 +73,9 @@ public:
     Vector(const Vector& other);    
     // 移动
     Vector(Vector&& other) noexcept;
-    // 范围构造             暂不支持其他STL转换为Vector 只支持Vector的范围构造
-    Vector(const_iterator first, const_iterator last);
+    // 范围构造 任意输入迭代器 前向迭代器只分配一次
+    template<typename InputIt, typename = RequireInputIter<InputIt>>
+    Vector(InputIt first, InputIt last);
 
     // ------------------------- 常用方法 ------------------------
     size_type size() const
@@ -59,6 +93,9 @@ public:
     iterator end() const
     { return finish; }
 
+    Alloc get_allocator() const
+    { return allocator; }
+
     // 赋值
     Vector& operator=(const Vector& rhs);
     Vector& operator=(Vector&& rhs);
@@ -66,6 +103,23 @@ public:
     // 扩容
     void reserve(size_type n);
 
+    // 释放多余容量 (容量 = 元素个数)
+    void shrink_to_fit();
+
+    // 清空元素 保留容量
+    void clear();
+
+    // 改变元素个数 新增元素值初始化 / 拷贝 value
+    void resize(size_type n);
+    void resize(size_type n, const value_type& value);
+
+    // 改变元素个数 新增元素默认初始化: 平凡类型不清零 内容未定义
+    // 用于随后会被整体覆盖的缓冲区 (如读文件/网络) 省掉一次写内存
+    void resize_default_init(size_type n);
+
+    // 尾部追加 n 个默认初始化的元素 返回第一个新元素的地址 供调用者直接写入
+    pointer append_default_init(size_type n);
+
     // 尾插 - 左值: 拷贝
     void push_back(const value_type& value);
 
@@ -85,6 +139,27 @@ public:
     template<typename... Args>
     iterator emplace(const_iterator pos, Args&&... args);
 
+    // 区间插入 (区间不能来自本容器) 前向迭代器先算出个数 最多扩容一次
+    template<typename InputIt, typename = RequireInputIter<InputIt>>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<value_type> il)
+    { return insert(pos, il.begin(), il.end()); }
+
+    // 尾部追加一段
+    template<typename InputIt, typename = RequireInputIter<InputIt>>
+    void append(InputIt first, InputIt last)
+    { insert(finish, first, last); }
+    template<typename Range>
+    void append_range(const Range& range)
+    { append(std::begin(range), std::end(range)); }
+
+    // 整体替换内容
+    template<typename InputIt, typename = RequireInputIter<InputIt>>
+    void assign(InputIt first, InputIt last);
+    void assign(size_type n, const value_type& value);
+    void assign(std::initializer_list<value_type> il)
+    { assign(il.begin(), il.end()); }
+
     // 删除 返回删除位置迭代器
     iterator erase(const_iterator pos);
     // 区间删除
@@ -107,6 +182,15 @@ public:
     pointer data() noexcept;
     const_pointer data() const noexcept;
 
+    // ------------------------- 快照 ---------------------------
+    // 二进制快照 (格式见 snapshot.h) 仅限可平凡拷贝的元素
+    // 文件头 + data() 的原样字节 读取时一次整块读入 不逐个构造
+    // 按路径保存时先写临时文件再改名 读取失败时本容器不变
+    void save_snapshot(std::FILE* out) const;
+    void save_snapshot(const std::string& path) const;
+    void load_snapshot(std::FILE* in);
+    void load_snapshot(const std::string& path);
+
     ~Vector();
 };
 
@@ -0,0 +1,113 @@
+#ifndef YXY__STL__GROWTH_POLICY_H
+#define YXY__STL__GROWTH_POLICY_H
+
+#include<atomic>
+#include<cstddef>
+
+/*
+--- Vector 扩容策略
+--- 约定: static size_type next_capacity(size_type current, size_type required, size_type elem_size)
+---       返回不小于 required 的新容量 (元素个数)
+--- current 为当前容量 required 为本次操作至少需要的容量 elem_size = sizeof(T)
+*/
+
+// 2 倍扩容 (默认) 扩容次数最少
+struct GrowDouble
+{
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t)
+    {
+        std::size_t n = current != 0 ? current * 2 : 1;
+        return n < required ? required : n;
+    }
+};
+
+// 1.5 倍扩容 之前释放的几块旧内存加起来能容纳新块 分配器有机会复用
+struct GrowOneAndHalf
+{
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t)
+    {
+        std::size_t n = current + current / 2;
+        if(n < current + 1)
+            n = current + 1;
+        return n < required ? required : n;
+    }
+};
+
+// 固定步长 每次多 Step 个元素 内存占用最紧 扩容次数多
+template<std::size_t Step>
+struct GrowFixedStep
+{
+    static_assert(Step > 0, "GrowFixedStep: step must be positive");
+
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t)
+    {
+        std::size_t n = current + Step;
+        return n < required ? required : n;
+    }
+};
+
+// 大块按页取整: 按 Base 算出容量后 字节数超过 Threshold 时向上取整到 PageSize 的倍数
+// 配合按页分配的分配器 (Allocator 的 mmap 大块) 不浪费页尾
+template<typename Base = GrowDouble, std::size_t PageSize = 4096, std::size_t Threshold = 64 * 1024>
+struct GrowPageAligned
+{
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t elem_size)
+    {
+        std::size_t n = Base::next_capacity(current, required, elem_size);
+        std::size_t bytes = n * elem_size;
+        if(bytes < Threshold)
+            return n;
+        bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+        return bytes / elem_size;
+    }
+};
+
+// 扩容统计 每次 Vector 因容量不足而扩容时累加
+struct RegrowStats
+{
+    // 扩容回调: 参数同 next_capacity 可在其中打印调用栈 找出缺少 reserve 的调用点
+    using hook_type = void (*)(std::size_t current, std::size_t required, std::size_t elem_size);
+
+    std::atomic<std::size_t> regrows{0};
+    std::atomic<std::size_t> relocated_bytes{0};    // 扩容前的容量字节数之和 (近似搬运量)
+    std::atomic<hook_type> hook{nullptr};
+
+    void reset()
+    {
+        regrows.store(0, std::memory_order_relaxed);
+        relocated_bytes.store(0, std::memory_order_relaxed);
+    }
+};
+
+// 计数扩容: 行为同 Base 另外把每次扩容记到 Tag 对应的 RegrowStats
+// next_capacity 只在容量不足时被调用 (显式 reserve 不经过这里) 所以计数就是"本可以避免"的扩容次数
+// 不使用时没有任何开销; 也可以用 StatsGrowth<Tag> 别名 只在定义了 YXY_STL_ALLOC_STATS 时计数
+template<typename Base = GrowDouble, typename Tag = void>
+struct CountingGrowth
+{
+    static RegrowStats& stats()
+    {
+        static RegrowStats s;
+        return s;
+    }
+
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t elem_size)
+    {
+        RegrowStats& s = stats();
+        s.regrows.fetch_add(1, std::memory_order_relaxed);
+        s.relocated_bytes.fetch_add(current * elem_size, std::memory_order_relaxed);
+        if(RegrowStats::hook_type hook = s.hook.load(std::memory_order_relaxed))
+            hook(current, required, elem_size);
+        return Base::next_capacity(current, required, elem_size);
+    }
+};
+
+#if defined(YXY_STL_ALLOC_STATS)
+template<typename Tag = void>
+using StatsGrowth = CountingGrowth<GrowDouble, Tag>;
+#else
+template<typename Tag = void>
+using StatsGrowth = GrowDouble;
+#endif
+
+#endif // YXY__STL__GROWTH_POLICY_H
@@ -0,0 +1,229 @@
+#ifndef YXY__STL__ALLOC_STATS_H
+#define YXY__STL__ALLOC_STATS_H
+
+#include "allocator.h"
+#include<atomic>
+#include<cstddef>
+#include<cstdio>
+#include<type_traits>
+
+/*
+--- 分配统计: 包装任意分配器 记录分配次数 / 当前占用 / 峰值 / 大小分布
+--- 统计按 Tag 归类 同一 Tag 的所有分配器 (包括 rebind 得到的) 累加到同一份 AllocStats
+--- 用法: struct OrdersTag;  Vector<Order, InstrumentedAllocator<Order, OrdersTag>> orders;
+---       alloc_stats<OrdersTag>().print("orders");
+--- 不用时没有任何开销: 容器默认的 Allocator 不变
+--- 也可以用 StatsAllocator<T, Tag> 别名 只有定义了 YXY_STL_ALLOC_STATS 时才换成带统计的版本
+*/
+
+struct AllocStats
+{
+    // 大小分布: 第 k 格统计字节数落在 [2^k, 2^(k+1)) 的分配
+    static constexpr std::size_t histogram_buckets = 48;
+
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> deallocations{0};
+    std::atomic<std::size_t> expansions{0};         // try_expand / reallocate 成功次数
+    std::atomic<std::size_t> total_bytes{0};        // 累计申请字节数
+    std::atomic<std::size_t> live_bytes{0};         // 当前占用字节数
+    std::atomic<std::size_t> peak_bytes{0};         // live_bytes 的最大值
+    std::atomic<std::size_t> histogram[histogram_buckets] = {};
+
+    static std::size_t bucket_of(std::size_t bytes)
+    {
+        std::size_t k = 0;
+        while(bytes > 1 && k + 1 < histogram_buckets)
+        {
+            bytes >>= 1;
+            ++k;
+        }
+        return k;
+    }
+
+    void record_allocate(std::size_t bytes)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        histogram[bucket_of(bytes)].fetch_add(1, std::memory_order_relaxed);
+        grow_live(bytes);
+    }
+
+    void record_deallocate(std::size_t bytes)
+    {
+        deallocations.fetch_add(1, std::memory_order_relaxed);
+        live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    // 同一块内存从 old_bytes 变为 new_bytes (原地扩展 / 重新映射)
+    void record_resize(std::size_t old_bytes, std::size_t new_bytes)
+    {
+        expansions.fetch_add(1, std::memory_order_relaxed);
+        if(new_bytes >= old_bytes)
+            grow_live(new_bytes - old_bytes);
+        else
+            live_bytes.fetch_sub(old_bytes - new_bytes, std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        allocations.store(0, std::memory_order_relaxed);
+        deallocations.store(0, std::memory_order_relaxed);
+        expansions.store(0, std::memory_order_relaxed);
+        total_bytes.store(0, std::memory_order_relaxed);
+        live_bytes.store(0, std::memory_order_relaxed);
+        peak_bytes.store(0, std::memory_order_relaxed);
+        for(auto& h : histogram)
+            h.store(0, std::memory_order_relaxed);
+    }
+
+    void print(const char* name, std::FILE* out = stderr) const
+    {
+        std::fprintf(out, "[alloc_stats] %s: allocations=%zu deallocations=%zu expansions=%zu "
+                          "total_bytes=%zu live_bytes=%zu peak_bytes=%zu\n",
+                     name, allocations.load(), deallocations.load(), expansions.load(),
+                     total_bytes.load(), live_bytes.load(), peak_bytes.load());
+        for(std::size_t k = 0;k<histogram_buckets;++k)
+        {
+            std::size_t count = histogram[k].load();
+            if(count)
+                std::fprintf(out, "[alloc_stats] %s:   [%zu, %zu) bytes: %zu\n",
+                             name, std::size_t(1) << k, std::size_t(2) << k, count);
+        }
+    }
+
+private:
+    void grow_live(std::size_t bytes)
+    {
+        total_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        std::size_t live = live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::size_t peak = peak_bytes.load(std::memory_order_relaxed);
+        while(live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    }
+};
+
+// 每个 Tag 一份统计
+template<typename Tag>
+AllocStats& alloc_stats()
+{
+    static AllocStats stats;
+    return stats;
+}
+
+// 带统计的分配器 实际分配转交给 Base
+// Base 支持的扩展 (allocate_at_least / try_expand / reallocate) 原样转发 容器的快速路径不受影响
+template<typename T, typename Tag = void, typename Base = Allocator<T>>
+class InstrumentedAllocator
+{
+public:
+    // --- STL 契约的类型定义 ---
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<class U>
+    struct rebind
+    {
+        using other = InstrumentedAllocator<U, Tag, typename Base::template rebind<U>::other>;
+    };
+
+public:
+    // --- 构造及析构 ---
+    InstrumentedAllocator() = default;
+    explicit InstrumentedAllocator(const Base& alloc)
+    : base(alloc) {}
+    InstrumentedAllocator(const InstrumentedAllocator&) = default;
+    InstrumentedAllocator& operator=(const InstrumentedAllocator&) = default;
+    template<typename U, typename BaseU>
+    InstrumentedAllocator(const InstrumentedAllocator<U, Tag, BaseU>& other) noexcept
+    : base(other.base_allocator()) {}
+    ~InstrumentedAllocator() = default;
+
+    pointer allocate(size_type n)
+    {
+        pointer p = base.allocate(n);
+        if(p)
+            stats().record_allocate(n * sizeof(value_type));
+        return p;
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        if(p)
+            stats().record_deallocate(n * sizeof(value_type));
+        base.deallocate(p, n);
+    }
+
+    // 按实际得到的个数记账 之后 deallocate 会以同样的个数归还
+    template<typename B = Base, typename = std::enable_if_t<allocator_has_allocate_at_least<B>::value>>
+    AllocationResult<pointer> allocate_at_least(size_type n)
+    {
+        AllocationResult<pointer> block = base.allocate_at_least(n);
+        if(block.ptr)
+            stats().record_allocate(block.count * sizeof(value_type));
+        return block;
+    }
+
+    template<typename B = Base, typename = std::enable_if_t<allocator_has_try_expand<B>::value>>
+    bool try_expand(pointer p, size_type old_n, size_type new_n)
+    {
+        if(!base.try_expand(p, old_n, new_n))
+            return false;
+        stats().record_resize(old_n * sizeof(value_type), new_n * sizeof(value_type));
+        return true;
+    }
+
+    template<typename B = Base, typename = std::enable_if_t<allocator_has_reallocate<B>::value>>
+    pointer reallocate(pointer p, size_type old_n, size_type new_n)
+    {
+        pointer q = base.reallocate(p, old_n, new_n);
+        if(q)
+            stats().record_resize(old_n * sizeof(value_type), new_n * sizeof(value_type));
+        return q;
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        base.construct(p, std::forward<Args>(args)...);
+    }
+    template<typename U>
+    void destroy(U* p)
+    {
+        base.destroy(p);
+    }
+
+    size_type max_size() const noexcept
+    {
+        return base.max_size();
+    }
+
+    static AllocStats& stats()
+    { return alloc_stats<Tag>(); }
+
+    const Base& base_allocator() const noexcept
+    { return base; }
+
+    template<typename U, typename BaseU>
+    friend bool operator==(const InstrumentedAllocator& a, const InstrumentedAllocator<U, Tag, BaseU>& b)
+    { return a.base == b.base_allocator(); }
+    template<typename U, typename BaseU>
+    friend bool operator!=(const InstrumentedAllocator& a, const InstrumentedAllocator<U, Tag, BaseU>& b)
+    { return !(a == b); }
+
+private:
+    Base base;
+};
+
+// 编译期开关: 定义 YXY_STL_ALLOC_STATS 时带统计 否则就是 Allocator<T> 本身
+#if defined(YXY_STL_ALLOC_STATS)
+template<typename T, typename Tag = void>
+using StatsAllocator = InstrumentedAllocator<T, Tag>;
+#else
+template<typename T, typename Tag = void>
+using StatsAllocator = Allocator<T>;
+#endif
+
+#endif // YXY__STL__ALLOC_STATS_H
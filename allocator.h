@@ -5,6 +5,20 @@
 #include<cstddef>
 #include<limits>
 #include<utility>
+#include<type_traits>
+#if defined(__linux__)
+#include<sys/mman.h>
+#include<unistd.h>
+#endif
+
+// allocate_at_least 的返回值: 首地址 + 实际可用元素个数 (>= 请求个数)
+// 释放时应把 count 传给 deallocate
+template<typename Pointer>
+struct AllocationResult
+{
+    Pointer ptr;
+    std::size_t count;
+};
 
 // 内存分配类
 template<typename T>
@@ -34,22 +48,89 @@ public:
     Allocator(const Allocator<U>&) noexcept {}
     ~Allocator() = default;
 
+    // 大块内存阈值: 不小于此字节数时直接向系统 mmap 整页
+    // 之后扩容可以 mremap 重新映射页表 而不必拷贝数据
+    static constexpr size_type mmap_threshold = size_type(1) << 20;
+
     // 分配/释放内存 构造
     pointer allocate(size_type n)
     {
         if(n == 0)
             return nullptr;
+        if(n > max_size())
+            throw std::bad_alloc();
+#if defined(__linux__)
+        if(is_mapped(n))
+        {
+            void* p = ::mmap(nullptr, mapped_bytes(n), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(p == MAP_FAILED)
+                throw std::bad_alloc();
+            return static_cast<pointer>(p);
+        }
+#endif
         // 只分配内存
         return static_cast<pointer>(::operator new(n * sizeof(value_type)));
     }
     // 传入初始(start) 直接释放连续的一块
-    void deallocate(pointer p, size_type)
+    // n 必须与分配时一致 (据此区分 mmap 块与普通块)
+    void deallocate(pointer p, size_type n)
     {
         if(p == nullptr)
             return;
+#if defined(__linux__)
+        if(is_mapped(n))
+        {
+            ::munmap(p, mapped_bytes(n));
+            return;
+        }
+#endif
         ::operator delete(p);
     }
-    
+
+    // 扩展: 分配至少 n 个元素 并告知整块内存实际能放下多少个
+    // mmap 大块按页取整 页尾的空间也交给容器使用
+    AllocationResult<pointer> allocate_at_least(size_type n)
+    {
+        pointer p = allocate(n);
+#if defined(__linux__)
+        if(is_mapped(n))
+            return {p, mapped_bytes(n) / sizeof(value_type)};
+#endif
+        return {p, n};
+    }
+
+    // ----------------------- 扩展: 原地扩容 ----------------------
+    // 尝试把 [p, p + old_n) 原地扩展到 new_n 个元素 地址不变 成功返回 true
+    // 仅 mmap 块且后续虚拟地址空闲时才可能成功
+    bool try_expand(pointer p, size_type old_n, size_type new_n)
+    {
+#if defined(__linux__)
+        if(p == nullptr || new_n > max_size() || !is_mapped(old_n) || !is_mapped(new_n))
+            return false;
+        if(mapped_bytes(old_n) >= mapped_bytes(new_n))
+            return true;
+        return ::mremap(p, mapped_bytes(old_n), mapped_bytes(new_n), 0) != MAP_FAILED;
+#else
+        (void)p; (void)old_n; (void)new_n;
+        return false;
+#endif
+    }
+
+    // 把 [p, p + old_n) 重新分配为 new_n 个元素 允许换地址 内容按字节保留
+    // 只适用于可平凡搬运的元素 不支持时返回 nullptr 由调用者走 分配+搬运 的常规路径
+    pointer reallocate(pointer p, size_type old_n, size_type new_n)
+    {
+#if defined(__linux__)
+        if(p == nullptr || new_n > max_size() || !is_mapped(old_n) || !is_mapped(new_n))
+            return nullptr;
+        void* q = ::mremap(p, mapped_bytes(old_n), mapped_bytes(new_n), MREMAP_MAYMOVE);
+        return q == MAP_FAILED ? nullptr : static_cast<pointer>(q);
+#else
+        (void)p; (void)old_n; (void)new_n;
+        return nullptr;
+#endif
+    }
+
     // 容器内构造/析构类 调用构造函数
     template<typename U, typename... Args>          // Args -> 构造类需要的所有参数
     void construct(U* p, Args&&... args)
@@ -73,7 +154,47 @@ public:
     friend bool operator==(const Allocator&, const Allocator&) { return true; };
     friend bool operator!=(const Allocator&, const Allocator&) { return false; };
 
+private:
+    static bool is_mapped(size_type n)
+    {
+        return n >= (mmap_threshold + sizeof(value_type) - 1) / sizeof(value_type);
+    }
+
+#if defined(__linux__)
+    // 向上取整到页大小
+    static size_type mapped_bytes(size_type n)
+    {
+        static const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+        return (n * sizeof(value_type) + page - 1) / page * page;
+    }
+#endif
 
 };
 
+// ---------------- 分配器扩展检测 (容器据此选择快速路径) ----------------
+
+// alloc.allocate_at_least(n) -> AllocationResult<pointer>
+template<typename A, typename = void>
+struct allocator_has_allocate_at_least : std::false_type {};
+template<typename A>
+struct allocator_has_allocate_at_least<A, std::void_t<decltype(
+    std::declval<A&>().allocate_at_least(std::size_t()))>>
+: std::true_type {};
+
+// alloc.try_expand(p, old_n, new_n) -> bool
+template<typename A, typename = void>
+struct allocator_has_try_expand : std::false_type {};
+template<typename A>
+struct allocator_has_try_expand<A, std::void_t<decltype(
+    std::declval<A&>().try_expand(std::declval<typename A::pointer>(), std::size_t(), std::size_t()))>>
+: std::true_type {};
+
+// alloc.reallocate(p, old_n, new_n) -> pointer
+template<typename A, typename = void>
+struct allocator_has_reallocate : std::false_type {};
+template<typename A>
+struct allocator_has_reallocate<A, std::void_t<decltype(
+    std::declval<A&>().reallocate(std::declval<typename A::pointer>(), std::size_t(), std::size_t()))>>
+: std::true_type {};
+
 #endif // YXY__STL__ALLOCATOR_H
\ No newline at end of file
@@ -0,0 +1,205 @@
+#ifndef YXY__STL__ARENA_ALLOCATOR_H
+#define YXY__STL__ARENA_ALLOCATOR_H
+
+#include<new>
+#include<cstddef>
+#include<cstdint>
+#include<limits>
+#include<utility>
+
+/*
+--- 单调增长的内存区 (arena)
+--- 分配只是移动指针 释放什么也不做 reset() 时一次性归还全部内存
+--- 当前块用完时申请新块 块大小按 2 倍增长 最多到 max_chunk reset() 后回到初始大小
+--- 适合 "一批容器一起创建 一起销毁" 的场景 (如单个请求内的临时容器)
+--- 非线程安全
+*/
+class MonotonicBuffer
+{
+public:
+    static constexpr std::size_t default_chunk = 4096;
+    // 块大小按 2 倍增长的上限 (更大的单次分配按需申请)
+    static constexpr std::size_t max_chunk = std::size_t(1) << 26;
+
+    explicit MonotonicBuffer(std::size_t initial_chunk = default_chunk)
+    : chunks(nullptr), initial_buffer(nullptr), initial_size(0),
+      cur(nullptr), end(nullptr), first_chunk(initial_chunk ? initial_chunk : default_chunk),
+      next_chunk(first_chunk) {}
+
+    // 先使用外部提供的缓冲区(如栈上数组) 用完再向堆申请
+    MonotonicBuffer(void* buffer, std::size_t size)
+    : chunks(nullptr), initial_buffer(static_cast<char*>(buffer)), initial_size(size),
+      cur(static_cast<char*>(buffer)), end(static_cast<char*>(buffer) + size),
+      first_chunk(size && size <= max_chunk / 2 ? size * 2 : default_chunk), next_chunk(first_chunk) {}
+
+    MonotonicBuffer(const MonotonicBuffer&) = delete;
+    MonotonicBuffer& operator=(const MonotonicBuffer&) = delete;
+    ~MonotonicBuffer()
+    { release_chunks(); }
+
+    void* allocate(std::size_t bytes, std::size_t align)
+    {
+        // bytes + align 与块头加起来不能溢出
+        if(bytes > max_request - align)
+            throw std::bad_alloc();
+        char* p = align_up(cur, align);
+        if(cur == nullptr || p > end || static_cast<std::size_t>(end - p) < bytes)
+        {
+            new_chunk(bytes + align);
+            p = align_up(cur, align);
+        }
+        cur = p + bytes;
+        return p;
+    }
+
+    // p 是最近一次分配且当前块剩余空间足够时 原地扩展
+    bool try_expand(void* p, std::size_t old_bytes, std::size_t new_bytes)
+    {
+        char* q = static_cast<char*>(p);
+        if(q + old_bytes != cur || new_bytes < old_bytes)
+            return false;
+        if(static_cast<std::size_t>(end - q) < new_bytes)
+            return false;
+        cur = q + new_bytes;
+        return true;
+    }
+
+    // 一次性释放全部内存 之前分配出去的指针全部失效
+    void reset()
+    {
+        release_chunks();
+        next_chunk = first_chunk;
+        cur = initial_buffer;
+        end = initial_buffer ? initial_buffer + initial_size : nullptr;
+    }
+
+private:
+    struct Chunk
+    {
+        Chunk* next;
+    };
+    static constexpr std::size_t chunk_header = alignof(std::max_align_t);
+    // 单个块 (不含块头) 的最大字节数
+    static constexpr std::size_t max_request = std::numeric_limits<std::size_t>::max() - chunk_header;
+
+    Chunk* chunks;
+    char* initial_buffer;
+    std::size_t initial_size;
+    char* cur;
+    char* end;
+    std::size_t first_chunk;
+    std::size_t next_chunk;
+
+    static char* align_up(char* p, std::size_t align)
+    {
+        std::uintptr_t v = reinterpret_cast<std::uintptr_t>(p);
+        return reinterpret_cast<char*>((v + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1));
+    }
+
+    void new_chunk(std::size_t min_bytes)
+    {
+        // 放不下时按需申请 不再翻倍 (min_bytes 已保证不超过 max_request)
+        std::size_t size = next_chunk < min_bytes ? min_bytes : next_chunk;
+        char* mem = static_cast<char*>(::operator new(chunk_header + size));
+        Chunk* c = reinterpret_cast<Chunk*>(mem);
+        c->next = chunks;
+        chunks = c;
+        cur = mem + chunk_header;
+        end = cur + size;
+        if(next_chunk < max_chunk)
+            next_chunk = next_chunk <= max_chunk / 2 ? next_chunk * 2 : max_chunk;
+    }
+
+    void release_chunks()
+    {
+        while(chunks)
+        {
+            Chunk* next = chunks->next;
+            ::operator delete(chunks);
+            chunks = next;
+        }
+    }
+};
+
+// arena 分配器 只持有 MonotonicBuffer 的指针 拷贝/rebind 后指向同一个 arena
+// deallocate 为空操作 内存在 arena.reset() 或析构时统一归还
+// 必须显式指定 arena: 容器的生命周期由调用者保证不超过 arena
+template<typename T>
+class ArenaAllocator
+{
+public:
+    // --- STL 契约的类型定义 ---
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<class U>
+    struct rebind
+    {
+        using other = ArenaAllocator<U>;
+    };
+
+public:
+    // --- 构造及析构 ---
+    // 没有默认 arena: 隐式的线程局部 arena 无人 reset 会无限增长 线程退出时还会释放仍在使用的内存
+    ArenaAllocator() = delete;
+    ArenaAllocator(MonotonicBuffer& buffer) noexcept
+    : arena(&buffer) {}
+    ArenaAllocator(const ArenaAllocator&) = default;
+    ArenaAllocator& operator=(const ArenaAllocator&) = default;
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+    : arena(other.resource()) {}
+    ~ArenaAllocator() = default;
+
+    pointer allocate(size_type n)
+    {
+        if(n == 0)
+            return nullptr;
+        if(n > max_size())
+            throw std::bad_alloc();
+        return static_cast<pointer>(arena->allocate(n * sizeof(value_type), alignof(value_type)));
+    }
+    void deallocate(pointer, size_type) {}
+
+    // 扩展: 最近一次分配的块可以原地变长 Vector::reserve 会优先尝试
+    bool try_expand(pointer p, size_type old_n, size_type new_n)
+    {
+        if(p == nullptr || new_n > max_size())
+            return false;
+        return arena->try_expand(p, old_n * sizeof(value_type), new_n * sizeof(value_type));
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+    template<typename U>
+    void destroy(U* p)
+    {
+        p->~U();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    MonotonicBuffer* resource() const noexcept
+    { return arena; }
+
+    template<typename U>
+    friend bool operator==(const ArenaAllocator& a, const ArenaAllocator<U>& b) { return a.arena == b.resource(); }
+    template<typename U>
+    friend bool operator!=(const ArenaAllocator& a, const ArenaAllocator<U>& b) { return a.arena != b.resource(); }
+
+private:
+    MonotonicBuffer* arena;
+};
+
+#endif // YXY__STL__ARENA_ALLOCATOR_H
@@ -0,0 +1,58 @@
+#ifndef YXY__STL__BENCH_H
+#define YXY__STL__BENCH_H
+
+#include<chrono>
+#include<cstdio>
+#include<cstddef>
+
+/*
+--- 自带的简易基准工具 (无第三方依赖)
+--- 结果按 CSV 输出到 stdout 每行一个测量 便于跨提交 diff:
+---     suite,case,variant,n,threads,ns_per_op,mops
+*/
+
+class BenchTimer
+{
+public:
+    BenchTimer() : begin(std::chrono::steady_clock::now()) {}
+
+    void reset()
+    { begin = std::chrono::steady_clock::now(); }
+
+    double elapsed_ns() const
+    {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point begin;
+};
+
+// 防止编译器把被测结果优化掉
+template<typename T>
+inline void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+inline void bench_header()
+{
+    std::printf("suite,case,variant,n,threads,ns_per_op,mops\n");
+}
+
+// ops 为本次测量完成的操作总数
+inline void bench_report(const char* suite, const char* name, const char* variant,
+                         std::size_t n, int threads, double total_ns, double ops)
+{
+    double ns_per_op = ops > 0 ? total_ns / ops : 0.0;
+    double mops = total_ns > 0 ? ops / total_ns * 1e3 : 0.0;
+    std::printf("%s,%s,%s,%zu,%d,%.3f,%.3f\n", suite, name, variant, n, threads, ns_per_op, mops);
+    std::fflush(stdout);
+}
+
+#endif // YXY__STL__BENCH_H
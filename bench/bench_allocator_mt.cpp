@@ -0,0 +1,80 @@
+// 多线程 分配/释放 吞吐量: 全局堆 (Allocator) vs 线程缓存 (ThreadCacheAllocator)
+// 编译: g++ -std=c++17 -O2 -pthread bench/bench_allocator_mt.cpp -o bench_allocator_mt
+// 用法: ./bench_allocator_mt [最大线程数]
+#include "bench.h"
+#include "../allocator.h"
+#include "../thread_cache_allocator.h"
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <cstdint>
+
+// 每个线程: 保持一个 live 个对象的工作集 随机挑一个释放再分配 大小 16~256 字节
+template<template<typename> class Alloc>
+static void worker(std::size_t ops, std::uint32_t seed, std::atomic<bool>& go)
+{
+    constexpr std::size_t live = 1024;
+    Alloc<char> alloc;
+    char* ptrs[live];
+    std::size_t sizes[live];
+    std::uint32_t x = seed;
+    auto next = [&x]() { x ^= x << 13; x ^= x >> 17; x ^= x << 5; return x; };
+
+    for(std::size_t i = 0;i<live;++i)
+    {
+        sizes[i] = 16 + next() % 241;
+        ptrs[i] = alloc.allocate(sizes[i]);
+    }
+    while(!go.load(std::memory_order_acquire)) {}
+
+    for(std::size_t i = 0;i<ops;++i)
+    {
+        std::size_t k = next() % live;
+        alloc.deallocate(ptrs[k], sizes[k]);
+        sizes[k] = 16 + next() % 241;
+        ptrs[k] = alloc.allocate(sizes[k]);
+        ptrs[k][0] = static_cast<char>(i);
+    }
+
+    for(std::size_t i = 0;i<live;++i)
+        alloc.deallocate(ptrs[i], sizes[i]);
+}
+
+template<template<typename> class Alloc>
+static void run(const char* variant, int threads, std::size_t ops_per_thread)
+{
+    std::atomic<bool> go(false);
+    std::vector<std::thread> pool;
+    for(int t = 0;t<threads;++t)
+        pool.emplace_back(worker<Alloc>, ops_per_thread, 2463534242u + t * 7919u, std::ref(go));
+
+    BenchTimer timer;
+    go.store(true, std::memory_order_release);
+    for(auto& th : pool)
+        th.join();
+    double ns = timer.elapsed_ns();
+    // 每次迭代 一次释放 + 一次分配
+    bench_report("allocator_mt", "alloc_free", variant, ops_per_thread, threads, ns,
+                 2.0 * ops_per_thread * threads);
+}
+
+int main(int argc, char** argv)
+{
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+    if(max_threads < 1)
+        max_threads = 1;
+    const std::size_t ops = 2000000;
+
+    bench_header();
+    for(int threads = 1;;threads *= 2)
+    {
+        if(threads > max_threads)
+            threads = max_threads;
+        run<Allocator>("global_heap", threads, ops);
+        run<ThreadCacheAllocator>("thread_cache", threads, ops);
+        if(threads == max_threads)
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+// 并发哈希表读吞吐: 分片 seqlock (ConcurrentUnorderedMap) vs 单把读写锁 + Unordered_map
+// 编译: g++ -std=c++17 -O2 -pthread bench/bench_concurrent_map.cpp -o bench_concurrent_map
+// 用法: ./bench_concurrent_map [最大线程数]
+#include "bench.h"
+#include "../ConcurrentUnorderedMap/ConcurrentUnorderedMap.h"
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <shared_mutex>
+#include <cstdlib>
+#include <cstdint>
+
+static const std::uint64_t keys = 1 << 20;
+
+// 单把读写锁保护整张表 作为对照
+struct LockedMap
+{
+    Unordered_map<std::uint64_t, std::uint64_t> map;
+    mutable std::shared_mutex mutex;
+
+    bool find(std::uint64_t k, std::uint64_t& out) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = map.find(k);
+        if(it == map.end())
+            return false;
+        out = it->second;
+        return true;
+    }
+
+    void assign(std::uint64_t k, std::uint64_t v)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        map[k] = v;
+    }
+};
+
+struct ShardedMap
+{
+    ConcurrentUnorderedMap<std::uint64_t, std::uint64_t> map;
+
+    bool find(std::uint64_t k, std::uint64_t& out) const
+    {
+        auto v = map.find(k);
+        if(!v)
+            return false;
+        out = *v;
+        return true;
+    }
+
+    void assign(std::uint64_t k, std::uint64_t v)
+    {
+        map.insert_or_assign(k, v);
+    }
+};
+
+// 每个线程做 ops 次操作 其中每 write_every 次有一次写 (0 表示只读)
+template<typename Map>
+static void run(const char* name, const char* variant, Map& m, int threads, std::size_t ops, std::size_t write_every)
+{
+    std::atomic<bool> go(false);
+    std::vector<std::thread> pool;
+    for(int t = 0;t<threads;++t)
+    {
+        pool.emplace_back([&, t]()
+        {
+            std::uint64_t x = 88172645463325252ull + t;
+            std::uint64_t sum = 0;
+            while(!go.load(std::memory_order_acquire)) {}
+            for(std::size_t i = 0;i<ops;++i)
+            {
+                x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                std::uint64_t k = x & (keys - 1);
+                if(write_every && i % write_every == 0)
+                    m.assign(k, i);
+                else
+                {
+                    std::uint64_t v = 0;
+                    if(m.find(k, v))
+                        sum += v;
+                }
+            }
+            do_not_optimize(sum);
+        });
+    }
+
+    BenchTimer timer;
+    go.store(true, std::memory_order_release);
+    for(auto& th : pool)
+        th.join();
+    bench_report("concurrent_map", name, variant, keys, threads, timer.elapsed_ns(), double(ops) * threads);
+}
+
+int main(int argc, char** argv)
+{
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+    if(max_threads < 1)
+        max_threads = 1;
+    const std::size_t ops = 2000000;
+
+    LockedMap locked;
+    ShardedMap sharded;
+    for(std::uint64_t k = 0;k<keys;k += 2)
+    {
+        locked.assign(k, k);
+        sharded.assign(k, k);
+    }
+
+    bench_header();
+    for(int threads = 1;;threads *= 2)
+    {
+        if(threads > max_threads)
+            threads = max_threads;
+        run("find", "global_shared_mutex", locked, threads, ops, 0);
+        run("find", "sharded_seqlock", sharded, threads, ops, 0);
+        run("find_10pct_write", "global_shared_mutex", locked, threads, ops, 10);
+        run("find_10pct_write", "sharded_seqlock", sharded, threads, ops, 10);
+        if(threads == max_threads)
+            break;
+    }
+    return 0;
+}
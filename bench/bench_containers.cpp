@@ -0,0 +1,294 @@
+// 容器基准: Vector / Unordered_map 对比 std::vector / std::unordered_map
+// 编译: g++ -std=c++17 -O2 bench/bench_containers.cpp -o bench_containers
+// 用法: ./bench_containers [最大元素个数]   (默认 1000000 规模从 1000 起每次 x10)
+// 每个测量跑若干轮取最快一轮 输出 CSV 可直接 diff 不同提交的结果
+#include "bench.h"
+#include "../Vector/Vector.h"
+#include "../Unordered_map/Unordered_map.h"
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+
+// ------------------------- 测试数据 -------------------------
+template<typename T>
+struct Data;
+
+template<>
+struct Data<int>
+{
+    static const char* name() { return "int"; }
+    static int make(std::size_t i) { return static_cast<int>(i * 2654435761u); }
+    static std::size_t touch(int x) { return static_cast<std::size_t>(x); }
+};
+
+template<>
+struct Data<std::uint64_t>
+{
+    static const char* name() { return "u64"; }
+    // splitmix64: 打散的 64 位键
+    static std::uint64_t make(std::size_t i)
+    {
+        std::uint64_t z = i + 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+    static std::size_t touch(std::uint64_t x) { return static_cast<std::size_t>(x); }
+};
+
+template<>
+struct Data<std::string>
+{
+    static const char* name() { return "string"; }
+    // 长度超过常见 SSO 阈值 拷贝代价接近真实业务字符串
+    static std::string make(std::size_t i) { return "bench_value_" + std::to_string(Data<std::uint64_t>::make(i)); }
+    static std::size_t touch(const std::string& x) { return x.size(); }
+};
+
+// 每轮至少做这么多次操作 小规模时重复多次以保证计时精度
+static const std::size_t min_ops_per_round = 1000000;
+static const int rounds = 3;
+
+static std::size_t repeats_for(std::size_t n)
+{
+    return n >= min_ops_per_round ? 1 : min_ops_per_round / n;
+}
+
+// 跑 rounds 轮 body(timer) 取最快一轮上报
+// body 返回本轮完成的操作数 准备数据后可调用 timer.reset() 把准备时间排除在外
+template<typename Body>
+static void measure(const char* suite, const char* name, const char* variant, std::size_t n, Body body)
+{
+    double best = 0;
+    double best_ns = 0;
+    double best_ops = 0;
+    for(int r = 0;r<rounds;++r)
+    {
+        BenchTimer timer;
+        double ops = body(timer);
+        double ns = timer.elapsed_ns();
+        if(r == 0 || ns / ops < best)
+        {
+            best = ns / ops;
+            best_ns = ns;
+            best_ops = ops;
+        }
+    }
+    bench_report(suite, name, variant, n, 1, best_ns, best_ops);
+}
+
+// ------------------------- 顺序容器 -------------------------
+template<typename Vec, typename T>
+static void bench_vector(const char* variant, std::size_t n)
+{
+    std::string suite = std::string("vector_") + Data<T>::name();
+    std::vector<T> values;
+    values.reserve(n);
+    for(std::size_t i = 0;i<n;++i)
+        values.push_back(Data<T>::make(i));
+    std::size_t repeat = repeats_for(n);
+
+    auto filled = [&]()
+    {
+        Vec v;
+        for(std::size_t i = 0;i<n;++i)
+            v.push_back(values[i]);
+        return v;
+    };
+
+    measure(suite.c_str(), "push_back", variant, n, [&](BenchTimer&)
+    {
+        for(std::size_t r = 0;r<repeat;++r)
+        {
+            Vec v;
+            for(std::size_t i = 0;i<n;++i)
+                v.push_back(values[i]);
+            do_not_optimize(v.data());
+        }
+        return double(repeat * n);
+    });
+
+    measure(suite.c_str(), "push_back_reserved", variant, n, [&](BenchTimer&)
+    {
+        for(std::size_t r = 0;r<repeat;++r)
+        {
+            Vec v;
+            v.reserve(n);
+            for(std::size_t i = 0;i<n;++i)
+                v.push_back(values[i]);
+            do_not_optimize(v.data());
+        }
+        return double(repeat * n);
+    });
+
+    // 满容量时 reserve 翻倍: 每个元素搬运一次的代价 (只计 reserve)
+    measure(suite.c_str(), "reserve_regrow", variant, n, [&](BenchTimer& timer)
+    {
+        std::vector<Vec> vs;
+        vs.reserve(repeat);
+        for(std::size_t r = 0;r<repeat;++r)
+        {
+            vs.emplace_back();
+            vs.back().reserve(n);
+            for(std::size_t i = 0;i<n;++i)
+                vs.back().push_back(values[i]);
+        }
+        timer.reset();
+        for(auto& v : vs)
+        {
+            v.reserve(2 * n);
+            do_not_optimize(v.data());
+        }
+        return double(repeat * n);
+    });
+
+    // 中间插入 / 删除: 每次挪动一半元素 总搬运量控制在 1e7 左右
+    std::size_t moves = n < 1000 ? n : 10000000 / n;
+    if(moves > 1000)
+        moves = 1000;
+    if(moves == 0)
+        moves = 1;
+    measure(suite.c_str(), "insert_middle", variant, n, [&](BenchTimer& timer)
+    {
+        Vec v = filled();
+        v.reserve(n + moves);
+        timer.reset();
+        for(std::size_t i = 0;i<moves;++i)
+            v.insert(v.begin() + v.size() / 2, values[i]);
+        do_not_optimize(v.data());
+        return double(moves);
+    });
+
+    measure(suite.c_str(), "erase_middle", variant, n, [&](BenchTimer& timer)
+    {
+        Vec v = filled();
+        timer.reset();
+        for(std::size_t i = 0;i<moves;++i)
+            v.erase(v.begin() + v.size() / 2);
+        do_not_optimize(v.data());
+        return double(moves);
+    });
+
+    Vec v = filled();
+    measure(suite.c_str(), "iterate", variant, n, [&](BenchTimer&)
+    {
+        std::size_t sum = 0;
+        for(std::size_t r = 0;r<repeat;++r)
+        {
+            for(const auto& x : v)
+                sum += Data<T>::touch(x);
+            do_not_optimize(sum);
+        }
+        return double(repeat * n);
+    });
+}
+
+// ------------------------- 哈希表 -------------------------
+template<typename Map, typename K>
+static void bench_map(const char* variant, std::size_t n)
+{
+    std::string suite = std::string("map_") + Data<K>::name();
+    // 前 n 个键插入 后 n 个键用于未命中查找
+    std::vector<K> keys;
+    keys.reserve(2 * n);
+    for(std::size_t i = 0;i<2 * n;++i)
+        keys.push_back(Data<K>::make(i));
+    std::size_t repeat = repeats_for(n);
+
+    auto filled = [&]()
+    {
+        Map m;
+        for(std::size_t i = 0;i<n;++i)
+            m.insert({keys[i], static_cast<int>(i)});
+        return m;
+    };
+
+    measure(suite.c_str(), "insert", variant, n, [&](BenchTimer&)
+    {
+        for(std::size_t r = 0;r<repeat;++r)
+        {
+            Map m;
+            for(std::size_t i = 0;i<n;++i)
+                m.insert({keys[i], static_cast<int>(i)});
+            do_not_optimize(m.size());
+        }
+        return double(repeat * n);
+    });
+
+    measure(suite.c_str(), "insert_reserved", variant, n, [&](BenchTimer&)
+    {
+        for(std::size_t r = 0;r<repeat;++r)
+        {
+            Map m;
+            m.reserve(n);
+            for(std::size_t i = 0;i<n;++i)
+                m.insert({keys[i], static_cast<int>(i)});
+            do_not_optimize(m.size());
+        }
+        return double(repeat * n);
+    });
+
+    Map m = filled();
+    measure(suite.c_str(), "find_hit", variant, n, [&](BenchTimer&)
+    {
+        std::size_t sum = 0;
+        for(std::size_t r = 0;r<repeat;++r)
+            for(std::size_t i = 0;i<n;++i)
+                sum += m.find(keys[i])->second;
+        do_not_optimize(sum);
+        return double(repeat * n);
+    });
+
+    measure(suite.c_str(), "find_miss", variant, n, [&](BenchTimer&)
+    {
+        std::size_t misses = 0;
+        for(std::size_t r = 0;r<repeat;++r)
+            for(std::size_t i = n;i<2 * n;++i)
+                misses += m.find(keys[i]) == m.end();
+        do_not_optimize(misses);
+        return double(repeat * n);
+    });
+
+    measure(suite.c_str(), "erase", variant, n, [&](BenchTimer& timer)
+    {
+        Map e = filled();
+        timer.reset();
+        for(std::size_t i = 0;i<n;++i)
+            e.erase(keys[i]);
+        do_not_optimize(e.size());
+        return double(n);
+    });
+}
+
+template<typename T>
+static void run_vector(std::size_t n)
+{
+    bench_vector<Vector<T>, T>("Vector", n);
+    bench_vector<std::vector<T>, T>("std::vector", n);
+}
+
+template<typename K>
+static void run_map(std::size_t n)
+{
+    bench_map<Unordered_map<K, int>, K>("Unordered_map", n);
+    bench_map<std::unordered_map<K, int>, K>("std::unordered_map", n);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    if(max_n < 1000)
+        max_n = 1000;
+
+    bench_header();
+    for(std::size_t n = 1000;n<=max_n;n *= 10)
+    {
+        run_vector<int>(n);
+        run_vector<std::string>(n);
+        run_map<std::uint64_t>(n);
+        run_map<std::string>(n);
+    }
+    return 0;
+}
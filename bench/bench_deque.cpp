@@ -0,0 +1,136 @@
+// 双端队列: Deque vs std::deque vs 把 Vector 当队列用 (insert(begin()) / erase(begin()))
+// 编译: g++ -std=c++17 -O2 bench/bench_deque.cpp -o bench_deque
+// 用法: ./bench_deque [元素个数]   (默认 1000000)
+// Vector 头插 / 头删是 O(n) 只在 n <= 65536 时测
+// push_* 每轮新建容器 含块的申请/释放 glibc 在释放时归还堆顶内存 结果随释放顺序波动
+#include "bench.h"
+#include "../Deque/Deque.h"
+#include "../Vector/Vector.h"
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+
+using u64 = std::uint64_t;
+
+template<typename F>
+static void measure(const char* name, const char* variant, std::size_t n, F body)
+{
+    double best = 0;
+    for(int round = 0;round<3;++round)
+    {
+        BenchTimer timer;
+        body();
+        double ns = timer.elapsed_ns();
+        if(round == 0 || ns < best)
+            best = ns;
+    }
+    bench_report("deque", name, variant, n, 1, best, double(n));
+}
+
+template<typename D>
+static void push_front_all(std::size_t n)
+{
+    D d;
+    for(std::size_t i = 0;i<n;++i)
+        d.push_front(i);
+    do_not_optimize(d.front());
+}
+
+// 队列用法: 保持约 1024 个元素 尾进头出
+template<typename D>
+static void fifo(std::size_t n)
+{
+    D d;
+    u64 sum = 0;
+    for(std::size_t i = 0;i<n;++i)
+    {
+        d.push_back(i);
+        if(i >= 1024)
+        {
+            sum += d.front();
+            d.pop_front();
+        }
+    }
+    do_not_optimize(sum);
+}
+
+template<typename D>
+static void index_sum(const D& d, std::size_t n)
+{
+    u64 sum = 0;
+    for(std::size_t i = 0;i<n;++i)
+        sum += d[(i * 7919) % n];
+    do_not_optimize(sum);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const bool small = n <= 65536;
+
+    bench_header();
+
+    measure("push_front", "Deque", n, [&]() { push_front_all<Deque<u64>>(n); });
+    measure("push_front", "std::deque", n, [&]() { push_front_all<std::deque<u64>>(n); });
+    if(small)
+        measure("push_front", "Vector_insert_begin", n, [&]() {
+            Vector<u64> v;
+            for(std::size_t i = 0;i<n;++i)
+                v.insert(v.begin(), i);
+            do_not_optimize(v.front());
+        });
+
+    measure("push_back", "Deque", n, [&]() {
+        Deque<u64> d;
+        for(std::size_t i = 0;i<n;++i)
+            d.push_back(i);
+        do_not_optimize(d.back());
+    });
+    measure("push_back", "std::deque", n, [&]() {
+        std::deque<u64> d;
+        for(std::size_t i = 0;i<n;++i)
+            d.push_back(i);
+        do_not_optimize(d.back());
+    });
+
+    measure("fifo", "Deque", n, [&]() { fifo<Deque<u64>>(n); });
+    measure("fifo", "std::deque", n, [&]() { fifo<std::deque<u64>>(n); });
+    if(small)
+        measure("fifo", "Vector_erase_begin", n, [&]() {
+            Vector<u64> v;
+            u64 sum = 0;
+            for(std::size_t i = 0;i<n;++i)
+            {
+                v.push_back(i);
+                if(i >= 1024)
+                {
+                    sum += v.front();
+                    v.erase(v.begin());
+                }
+            }
+            do_not_optimize(sum);
+        });
+
+    Deque<u64> d;
+    std::deque<u64> sd;
+    for(std::size_t i = 0;i<n;++i)
+    {
+        d.push_back(i);
+        sd.push_back(i);
+    }
+    measure("random_index", "Deque", n, [&]() { index_sum(d, n); });
+    measure("random_index", "std::deque", n, [&]() { index_sum(sd, n); });
+    measure("iterate", "Deque", n, [&]() {
+        u64 sum = 0;
+        for(u64 x : d)
+            sum += x;
+        do_not_optimize(sum);
+    });
+    measure("iterate", "std::deque", n, [&]() {
+        u64 sum = 0;
+        for(u64 x : sd)
+            sum += x;
+        do_not_optimize(sum);
+    });
+    return 0;
+}
@@ -0,0 +1,90 @@
+// 单次查找开销: 不同 Mixer (Fibonacci / Murmur / Identity) 对整数与字符串 key
+// 编译: g++ -std=c++17 -O2 bench/bench_hash_mix.cpp -o bench_hash_mix
+// 用法: ./bench_hash_mix [元素个数]   (默认 1000000)
+// u64_seq 为连续整数 u64_stride 为 4096 步长 (低位全 0) 两者都是 std::hash 恒等哈希最怕的分布
+#include "bench.h"
+#include "../Unordered_map/Unordered_map.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+
+template<typename Key, typename Mixer>
+using MixMap = Unordered_map<Key, std::uint64_t, std::hash<Key>, std::equal_to<Key>,
+                             Allocator<HashNode<Key, std::uint64_t>>, Mixer>;
+
+template<typename Key, typename Mixer>
+static void run(const char* name, const char* variant, const std::vector<Key>& keys, const std::vector<Key>& probes)
+{
+    MixMap<Key, Mixer> m;
+    m.reserve(keys.size());
+    for(std::size_t i = 0;i<keys.size();++i)
+        m[keys[i]] = i;
+
+    // 取 3 轮中最快的一轮
+    double best = 0;
+    std::uint64_t sum = 0;
+    for(int round = 0;round<3;++round)
+    {
+        BenchTimer timer;
+        for(const Key& k : probes)
+        {
+            auto it = m.find(k);
+            if(it != m.end())
+                sum += it->second;
+        }
+        double ns = timer.elapsed_ns();
+        if(round == 0 || ns < best)
+            best = ns;
+    }
+    do_not_optimize(sum);
+    bench_report("hash_mix", name, variant, keys.size(), 1, best, double(probes.size()));
+}
+
+template<typename Key>
+static void run_all(const char* name, const std::vector<Key>& keys, const std::vector<Key>& probes)
+{
+    run<Key, HashMixFibonacci>(name, "fibonacci", keys, probes);
+    run<Key, HashMixMurmur>(name, "murmur", keys, probes);
+    run<Key, HashMixIdentity>(name, "identity", keys, probes);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    if(n < 1000)
+        n = 1000;
+
+    // 探测序列: 乱序访问已有 key
+    std::vector<std::size_t> order(n);
+    std::uint64_t x = 88172645463325252ull;
+    for(auto& i : order)
+    {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        i = x % n;
+    }
+
+    bench_header();
+
+    std::vector<std::uint64_t> seq(n), seq_probes(n);
+    for(std::size_t i = 0;i<n;++i)
+        seq[i] = i;
+    for(std::size_t i = 0;i<n;++i)
+        seq_probes[i] = seq[order[i]];
+    run_all("u64_seq", seq, seq_probes);
+
+    std::vector<std::uint64_t> stride(n), stride_probes(n);
+    for(std::size_t i = 0;i<n;++i)
+        stride[i] = i << 12;
+    for(std::size_t i = 0;i<n;++i)
+        stride_probes[i] = stride[order[i]];
+    run_all("u64_stride", stride, stride_probes);
+
+    std::vector<std::string> str(n), str_probes(n);
+    for(std::size_t i = 0;i<n;++i)
+        str[i] = "user:" + std::to_string(i * 7919);
+    for(std::size_t i = 0;i<n;++i)
+        str_probes[i] = str[order[i]];
+    run_all("string", str, str_probes);
+    return 0;
+}
@@ -0,0 +1,118 @@
+// 文件映射 Vector: 追加写入 / 打开已有数据 / 顺序扫描 与 "读文件到 Vector" 对比
+// 编译: g++ -std=c++17 -O2 bench/bench_mapped_vector.cpp -o bench_mapped_vector
+// 用法: ./bench_mapped_vector [元素个数] [文件路径]   (默认 4194304 个 u64 即 32 MiB, /tmp 下的临时文件)
+// open 行: MappedVector 只 mmap 不读数据 Vector 需要 fread 全部内容
+// open+scan 行: 打开后求和一遍 此时两者都要把数据读进内存 (页缓存命中时差距来自拷贝)
+#include "bench.h"
+#include "../MappedVector/MappedVector.h"
+#include "../Vector/Vector.h"
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+using u64 = std::uint64_t;
+
+// 与 MappedVector 相同的数据 以裸数组形式保存 供 fread 基线使用
+static void write_raw(const std::string& path, const MappedVector<u64>& v)
+{
+    FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite(v.data(), sizeof(u64), v.size(), f);
+    std::fclose(f);
+}
+
+static Vector<u64> read_raw(const std::string& path, std::size_t n)
+{
+    Vector<u64> v(n);
+    FILE* f = std::fopen(path.c_str(), "rb");
+    std::size_t got = std::fread(v.data(), sizeof(u64), n, f);
+    std::fclose(f);
+    v.resize(got);
+    return v;
+}
+
+template<typename F>
+static void measure(const char* name, const char* variant, std::size_t n, F body)
+{
+    double best = 0;
+    for(int round = 0;round<5;++round)
+    {
+        BenchTimer timer;
+        body();
+        double ns = timer.elapsed_ns();
+        if(round == 0 || ns < best)
+            best = ns;
+    }
+    bench_report("mapped_vector", name, variant, n, 1, best, double(n));
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 22);
+    std::string path = argc > 2 ? argv[2] : "/tmp/bench_mapped_vector_" + std::to_string(::getpid()) + ".bin";
+    std::string raw = path + ".raw";
+
+    bench_header();
+
+    measure("push_back", "Vector", n, [&]() {
+        Vector<u64> v;
+        for(std::size_t i = 0;i<n;++i)
+            v.push_back(i);
+        do_not_optimize(v.data());
+    });
+    measure("push_back", "MappedVector", n, [&]() {
+        MappedVector<u64> v(path, MapMode::Truncate);
+        for(std::size_t i = 0;i<n;++i)
+            v.push_back(i);
+        do_not_optimize(v.data());
+    });
+    measure("append", "MappedVector", n, [&]() {
+        Vector<u64> src(n, u64(1));
+        MappedVector<u64> v(path, MapMode::Truncate);
+        v.append(src.data(), n);
+        do_not_optimize(v.data());
+    });
+
+    {
+        MappedVector<u64> v(path, MapMode::Truncate);
+        for(std::size_t i = 0;i<n;++i)
+            v.push_back(i * 2654435761u);
+        write_raw(raw, v);
+    }
+
+    measure("open", "Vector_fread", n, [&]() {
+        Vector<u64> v = read_raw(raw, n);
+        do_not_optimize(v.data());
+    });
+    measure("open", "MappedVector", n, [&]() {
+        MappedVector<u64> v(path, MapMode::ReadOnly);
+        do_not_optimize(v.data());
+    });
+
+    measure("open+scan", "Vector_fread", n, [&]() {
+        Vector<u64> v = read_raw(raw, n);
+        u64 s = 0;
+        for(u64 x : v)
+            s += x;
+        do_not_optimize(s);
+    });
+    measure("open+scan", "MappedVector", n, [&]() {
+        MappedVector<u64> v(path, MapMode::ReadOnly);
+        u64 s = 0;
+        for(u64 x : v)
+            s += x;
+        do_not_optimize(s);
+    });
+    measure("open+scan", "MappedVector_sequential", n, [&]() {
+        MappedVector<u64> v(path, MapMode::ReadOnly);
+        v.advise(MapAdvice::Sequential);
+        u64 s = 0;
+        for(u64 x : v)
+            s += x;
+        do_not_optimize(s);
+    });
+
+    std::remove(path.c_str());
+    std::remove(raw.c_str());
+    return 0;
+}
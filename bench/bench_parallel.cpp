@@ -0,0 +1,112 @@
+// 并行算法扩展性: 1 ~ N 路并行下 parallel_for / reduce / inclusive_scan / sort 的吞吐
+// 编译: g++ -std=c++17 -O2 -pthread bench/bench_parallel.cpp -o bench_parallel
+// 用法: ./bench_parallel [最大线程数] [元素个数] [grain]   (默认 硬件线程数 16777216 自动)
+// variant 为 std 的行是单线程标准库实现 作为加速比的基准
+#include "bench.h"
+#include "../parallel_algorithm.h"
+#include "../Vector/Vector.h"
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+
+using u64 = std::uint64_t;
+
+static void fill_random(Vector<u64>& v)
+{
+    u64 x = 88172645463325252ull;
+    for(auto& e : v)
+    {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        e = x;
+    }
+}
+
+// 每个元素做一点计算 使 parallel_for 不完全受内存带宽限制
+static u64 work(u64 x)
+{
+    double d = static_cast<double>(x & 0xFFFFF);
+    return static_cast<u64>(std::sqrt(d) * 3.0 + std::log(d + 1.0));
+}
+
+static void run_std(Vector<u64>& v, Vector<u64>& out)
+{
+    const std::size_t n = v.size();
+    fill_random(v);
+
+    BenchTimer timer;
+    std::transform(v.begin(), v.end(), out.begin(), work);
+    bench_report("parallel", "transform", "std", n, 1, timer.elapsed_ns(), double(n));
+    do_not_optimize(out[n / 2]);
+
+    timer.reset();
+    u64 sum = std::accumulate(v.begin(), v.end(), u64(0));
+    bench_report("parallel", "reduce", "std", n, 1, timer.elapsed_ns(), double(n));
+    do_not_optimize(sum);
+
+    timer.reset();
+    std::partial_sum(v.begin(), v.end(), out.begin());
+    bench_report("parallel", "inclusive_scan", "std", n, 1, timer.elapsed_ns(), double(n));
+    do_not_optimize(out[n - 1]);
+
+    timer.reset();
+    std::sort(v.begin(), v.end());
+    bench_report("parallel", "sort", "std", n, 1, timer.elapsed_ns(), double(n));
+    do_not_optimize(v[0]);
+}
+
+static void run_parallel(std::size_t threads, Vector<u64>& v, Vector<u64>& out, std::size_t grain)
+{
+    const std::size_t n = v.size();
+    ThreadPool pool(threads);
+    fill_random(v);
+
+    BenchTimer timer;
+    parallel_transform(pool, v.begin(), v.end(), out.begin(), work, grain);
+    bench_report("parallel", "transform", "work_stealing", n, threads, timer.elapsed_ns(), double(n));
+    do_not_optimize(out[n / 2]);
+
+    timer.reset();
+    u64 sum = parallel_reduce(pool, v.begin(), v.end(), u64(0), std::plus<>(), grain);
+    bench_report("parallel", "reduce", "work_stealing", n, threads, timer.elapsed_ns(), double(n));
+    do_not_optimize(sum);
+
+    timer.reset();
+    parallel_inclusive_scan(pool, v.begin(), v.end(), out.begin(), std::plus<>(), grain);
+    bench_report("parallel", "inclusive_scan", "work_stealing", n, threads, timer.elapsed_ns(), double(n));
+    do_not_optimize(out[n - 1]);
+
+    timer.reset();
+    parallel_sort(pool, v.begin(), v.end(), std::less<>(), grain);
+    bench_report("parallel", "sort", "work_stealing", n, threads, timer.elapsed_ns(), double(n));
+    do_not_optimize(v[0]);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : ThreadPool::default_thread_count();
+    std::size_t n = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : (1u << 24);
+    std::size_t grain = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 0;
+    if(max_threads < 1)
+        max_threads = 1;
+    if(n < 1024)
+        n = 1024;
+
+    Vector<u64> v, out;
+    v.resize(n);
+    out.resize(n);
+
+    bench_header();
+    run_std(v, out);
+    for(std::size_t threads = 1;;threads *= 2)
+    {
+        if(threads > max_threads)
+            threads = max_threads;
+        run_parallel(threads, v, out, grain);
+        if(threads == max_threads)
+            break;
+    }
+    return 0;
+}
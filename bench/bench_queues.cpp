@@ -0,0 +1,183 @@
+// 线程间交接队列: SpscRing / MpmcQueue vs 互斥锁 + Vector
+// 编译: g++ -std=c++17 -O2 -pthread bench/bench_queues.cpp -o bench_queues
+// 用法: ./bench_queues [每个生产者的元素个数]   (默认 2000000)
+// throughput 行: 生产者把 n 个 u64 交给消费者 ns_per_op 为每个元素 (所有线程合计)
+// batch 变体用 push_n / pop_n 每批 32 个 (锁版本一次加锁处理一批)
+// latency 行: 两个线程经一对队列来回传递一个值 ns_per_op 为一次往返
+// 队列满 / 空时 yield 单核机器上多线程结果主要反映调度 不反映竞争
+#include "bench.h"
+#include "../SpscRing/SpscRing.h"
+#include "../MpmcQueue/MpmcQueue.h"
+#include "../Vector/Vector.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using u64 = std::uint64_t;
+
+static const std::size_t queue_capacity = 4096;
+static const std::size_t batch = 32;
+
+// 对照: 互斥锁保护的 Vector 作为有界 FIFO (head 之前的元素已取走 取空时清空)
+class LockedVectorQueue
+{
+public:
+    explicit LockedVectorQueue(std::size_t cap) : capacity(cap), head(0) {}
+
+    std::size_t push_n(const u64* first, std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t free = capacity - (items.size() - head);
+        n = free < n ? free : n;
+        for(std::size_t i = 0;i<n;++i)
+            items.push_back(first[i]);
+        return n;
+    }
+
+    std::size_t pop_n(u64* out, std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t avail = items.size() - head;
+        n = avail < n ? avail : n;
+        for(std::size_t i = 0;i<n;++i)
+            out[i] = items[head + i];
+        head += n;
+        if(head == items.size())
+        {
+            items.clear();
+            head = 0;
+        }
+        return n;
+    }
+
+    bool try_push(u64 v)
+    { return push_n(&v, 1) == 1; }
+    bool try_pop(u64& v)
+    { return pop_n(&v, 1) == 1; }
+
+private:
+    std::mutex mutex;
+    Vector<u64> items;
+    std::size_t capacity;
+    std::size_t head;
+};
+
+template<typename Q>
+static void produce(Q& q, u64 n, bool batched)
+{
+    u64 buf[batch];
+    u64 next = 0;
+    while(next < n)
+    {
+        std::size_t k;
+        if(batched)
+        {
+            std::size_t want = n - next < batch ? std::size_t(n - next) : batch;
+            for(std::size_t i = 0;i<want;++i)
+                buf[i] = next + i;
+            k = q.push_n(buf, want);
+        }
+        else
+            k = q.try_push(next) ? 1 : 0;
+        if(k == 0)
+            std::this_thread::yield();
+        next += k;
+    }
+}
+
+// 所有消费者合计取到 total 个后退出
+template<typename Q>
+static void consume(Q& q, std::atomic<u64>& taken, u64 total, bool batched)
+{
+    u64 buf[batch];
+    u64 sum = 0;
+    while(taken.load(std::memory_order_relaxed) < total)
+    {
+        std::size_t k = batched ? q.pop_n(buf, batch) : (q.try_pop(buf[0]) ? 1 : 0);
+        if(k == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        for(std::size_t i = 0;i<k;++i)
+            sum += buf[i];
+        taken.fetch_add(k, std::memory_order_relaxed);
+    }
+    do_not_optimize(sum);
+}
+
+template<typename Q>
+static void throughput(const char* suite, const char* variant, int producers, int consumers, u64 n, bool batched)
+{
+    Q q(queue_capacity);
+    std::atomic<u64> taken{0};
+    u64 total = n * producers;
+    BenchTimer timer;
+    std::vector<std::thread> threads;
+    for(int i = 0;i<producers;++i)
+        threads.emplace_back([&]() { produce(q, n, batched); });
+    for(int i = 0;i<consumers;++i)
+        threads.emplace_back([&]() { consume(q, taken, total, batched); });
+    for(auto& t : threads)
+        t.join();
+    bench_report(suite, batched ? "throughput_batch" : "throughput", variant,
+                 total, producers + consumers, timer.elapsed_ns(), double(total));
+}
+
+// 往返延迟: 主线程发 i 对方收到后原样发回
+template<typename Q>
+static void latency(const char* variant, u64 rounds)
+{
+    Q ping(queue_capacity), pong(queue_capacity);
+    std::thread echo([&]() {
+        u64 v;
+        for(u64 i = 0;i<rounds;++i)
+        {
+            while(!ping.try_pop(v))
+                std::this_thread::yield();
+            while(!pong.try_push(v))
+                std::this_thread::yield();
+        }
+    });
+    BenchTimer timer;
+    u64 v;
+    for(u64 i = 0;i<rounds;++i)
+    {
+        while(!ping.try_push(i))
+            std::this_thread::yield();
+        while(!pong.try_pop(v))
+            std::this_thread::yield();
+    }
+    double ns = timer.elapsed_ns();
+    echo.join();
+    bench_report("queue_spsc", "latency", variant, rounds, 2, ns, double(rounds));
+}
+
+int main(int argc, char** argv)
+{
+    u64 n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    bench_header();
+    for(bool batched : {false, true})
+    {
+        throughput<SpscRing<u64>>("queue_spsc", "SpscRing", 1, 1, n, batched);
+        throughput<MpmcQueue<u64>>("queue_spsc", "MpmcQueue", 1, 1, n, batched);
+        throughput<LockedVectorQueue>("queue_spsc", "mutex_Vector", 1, 1, n, batched);
+    }
+    for(int threads : {2, 4})
+    {
+        for(bool batched : {false, true})
+        {
+            throughput<MpmcQueue<u64>>("queue_mpmc", "MpmcQueue", threads, threads, n / threads, batched);
+            throughput<LockedVectorQueue>("queue_mpmc", "mutex_Vector", threads, threads, n / threads, batched);
+        }
+    }
+    u64 rounds = n / 20 ? n / 20 : 1;
+    latency<SpscRing<u64>>("SpscRing", rounds);
+    latency<MpmcQueue<u64>>("MpmcQueue", rounds);
+    latency<LockedVectorQueue>("mutex_Vector", rounds);
+    return 0;
+}
@@ -0,0 +1,54 @@
+// 插入延迟分布: 一次性扩容 vs 渐进式 rehash
+// 编译: g++ -std=c++17 -O2 bench/bench_rehash_latency.cpp -o bench_rehash_latency
+// 用法: ./bench_rehash_latency [插入个数]   (默认 8000000)
+// 每个分位数输出一行 ns_per_op 列为该分位的单次插入延迟
+#include "bench.h"
+#include "../Unordered_map/Unordered_map.h"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+static void run(const char* variant, bool incremental, std::size_t n)
+{
+    Unordered_map<std::uint64_t, std::uint64_t> m;
+    m.set_incremental_rehash(incremental);
+    std::vector<float> latency(n);
+
+    std::uint64_t x = 88172645463325252ull;
+    BenchTimer total;
+    for(std::size_t i = 0;i<n;++i)
+    {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        BenchTimer timer;
+        m[x] = i;
+        latency[i] = static_cast<float>(timer.elapsed_ns());
+    }
+    double total_ns = total.elapsed_ns();
+    do_not_optimize(m.size());
+
+    std::sort(latency.begin(), latency.end());
+    const struct { const char* name; double q; } quantiles[] = {
+        {"insert_p50", 0.5}, {"insert_p99", 0.99}, {"insert_p999", 0.999},
+        {"insert_p9999", 0.9999}, {"insert_max", 1.0},
+    };
+    for(const auto& q : quantiles)
+    {
+        std::size_t k = static_cast<std::size_t>(q.q * (n - 1));
+        bench_report("rehash_latency", q.name, variant, n, 1, latency[k], 1);
+    }
+    // 平均值包含计时本身的开销 只用于比较两种模式的吞吐
+    bench_report("rehash_latency", "insert_mean", variant, n, 1, total_ns, double(n));
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8000000;
+    if(n < 1000)
+        n = 1000;
+
+    bench_header();
+    run("stop_the_world", false, n);
+    run("incremental", true, n);
+    return 0;
+}
@@ -0,0 +1,74 @@
+// 向量化扫描: 标量 / SSE2 / AVX2 三个级别下 find / count / min / max / equal / sum 的吞吐
+// 编译: g++ -std=c++17 -O2 bench/bench_simd.cpp -o bench_simd
+// 用法: ./bench_simd [元素个数]   (默认 1048576 即 int 4 MiB)
+// Scalar 行是 std::find / std::count 等标准库版本 本机不支持的级别不输出
+#include "bench.h"
+#include "../simd_algorithm.h"
+#include "../Vector/Vector.h"
+#include <cstdint>
+#include <cstdlib>
+
+static const char* level_name(SimdLevel l)
+{
+    return l == SimdLevel::AVX2 ? "avx2" : l == SimdLevel::SSE2 ? "sse2" : "scalar";
+}
+
+// 重复 rounds 次 取最快一次
+template<typename F>
+static void measure(const char* suite, const char* name, SimdLevel level, std::size_t n, F body)
+{
+    double best = 0;
+    for(int round = 0;round<5;++round)
+    {
+        BenchTimer timer;
+        body();
+        double ns = timer.elapsed_ns();
+        if(round == 0 || ns < best)
+            best = ns;
+    }
+    bench_report(suite, name, level_name(level), n, 1, best, double(n));
+}
+
+template<typename T>
+static void run(const char* suite, std::size_t n)
+{
+    Vector<T> a;
+    std::uint32_t x = 2463534242u;
+    for(std::size_t i = 0;i<n;++i)
+    {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        a.push_back(static_cast<T>(x % 100000));
+    }
+    Vector<T> b(a);
+    // 要找的值不在数组中 find / equal 都会扫描整个区间
+    const T missing = static_cast<T>(-1);
+
+    for(SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        if(static_cast<int>(level) > static_cast<int>(simd_detected_level()))
+            continue;
+        set_simd_level(level);
+        const T* first = a.data();
+        const T* last = a.data() + n;
+        measure(suite, "find", level, n, [&]() { do_not_optimize(simd_find(first, last, missing)); });
+        measure(suite, "count", level, n, [&]() { do_not_optimize(simd_count(first, last, T(7))); });
+        measure(suite, "min_element", level, n, [&]() { do_not_optimize(simd_min_element(first, last)); });
+        measure(suite, "max_element", level, n, [&]() { do_not_optimize(simd_max_element(first, last)); });
+        measure(suite, "equal", level, n, [&]() { do_not_optimize(simd_equal(first, last, b.data())); });
+        measure(suite, "sum", level, n, [&]() { do_not_optimize(simd_sum(first, last)); });
+    }
+    set_simd_level(simd_detected_level());
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 20);
+    if(n < 64)
+        n = 64;
+
+    bench_header();
+    run<std::int32_t>("simd_int32", n);
+    run<float>("simd_float", n);
+    run<double>("simd_double", n);
+    return 0;
+}
@@ -0,0 +1,105 @@
+// 快照重启: 从快照恢复 Vector / Unordered_map 与 "逐个读出再重新插入" 对比
+// 编译: g++ -std=c++17 -O2 bench/bench_snapshot.cpp -o bench_snapshot
+// 用法: ./bench_snapshot [元素个数]   (默认 4194304)
+// push_back / reinsert 行: 没有快照时的做法 逐个读出元素再 push_back / insert
+// load 行: load_snapshot 整块读入 不重新哈希 (文件在页缓存中 测的是 CPU 开销)
+#include "bench.h"
+#include "../Vector/Vector.h"
+#include "../Unordered_map/Unordered_map.h"
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+using u64 = std::uint64_t;
+
+struct KeyValue
+{
+    u64 key;
+    u64 value;
+};
+
+static void write_raw(const std::string& path, const void* p, std::size_t bytes)
+{
+    FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite(p, 1, bytes, f);
+    std::fclose(f);
+}
+
+template<typename F>
+static void measure(const char* suite, const char* name, const char* variant, std::size_t n, F body)
+{
+    double best = 0;
+    for(int round = 0;round<3;++round)
+    {
+        BenchTimer timer;
+        body();
+        double ns = timer.elapsed_ns();
+        if(round == 0 || ns < best)
+            best = ns;
+    }
+    bench_report(suite, name, variant, n, 1, best, double(n));
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 22);
+    std::string base = "/tmp/bench_snapshot_" + std::to_string(::getpid());
+    std::string snap = base + ".snap";
+    std::string raw = base + ".raw";
+
+    bench_header();
+
+    // ---- Vector<u64> ----
+    Vector<u64> v;
+    for(std::size_t i = 0;i<n;++i)
+        v.push_back(i * 0x9E3779B97F4A7C15ull);
+    write_raw(raw, v.data(), n * sizeof(u64));
+    measure("snapshot_vector", "save", "snapshot", n, [&]() { v.save_snapshot(snap); });
+    measure("snapshot_vector", "load", "push_back", n, [&]() {
+        FILE* f = std::fopen(raw.c_str(), "rb");
+        Vector<u64> w;
+        u64 x;
+        while(w.size() < n && std::fread(&x, sizeof(x), 1, f) == 1)
+            w.push_back(x);
+        std::fclose(f);
+        do_not_optimize(w.data());
+    });
+    measure("snapshot_vector", "load", "snapshot", n, [&]() {
+        Vector<u64> w;
+        w.load_snapshot(snap);
+        do_not_optimize(w.data());
+    });
+
+    // ---- Unordered_map<u64, u64> ----
+    Unordered_map<u64, u64> m;
+    Vector<KeyValue> kv;
+    for(std::size_t i = 0;i<n;++i)
+    {
+        u64 k = i * 0x9E3779B97F4A7C15ull;
+        m.insert({k, i});
+        kv.push_back({k, i});
+    }
+    write_raw(raw, kv.data(), n * sizeof(KeyValue));
+
+    measure("snapshot_map", "save", "snapshot", n, [&]() { m.save_snapshot(snap); });
+    measure("snapshot_map", "load", "reinsert", n, [&]() {
+        FILE* f = std::fopen(raw.c_str(), "rb");
+        Unordered_map<u64, u64> r;
+        r.reserve(n);
+        KeyValue p;
+        while(std::fread(&p, sizeof(p), 1, f) == 1)
+            r.insert({p.key, p.value});
+        std::fclose(f);
+        do_not_optimize(r.size());
+    });
+    measure("snapshot_map", "load", "snapshot", n, [&]() {
+        Unordered_map<u64, u64> r;
+        r.load_snapshot(snap);
+        do_not_optimize(r.size());
+    });
+
+    std::remove(snap.c_str());
+    std::remove(raw.c_str());
+    return 0;
+}
@@ -0,0 +1,117 @@
+// 行式 vs 列式: Vector<Record> 与 SoaVector<...> 上只读一个字段的扫描 / 按条件统计 / 建表
+// 编译: g++ -std=c++17 -O2 bench/bench_soa.cpp -o bench_soa
+// 用法: ./bench_soa [记录条数]   (默认 4000000 记录 64 字节 共 256 MiB 远大于缓存)
+// Record 有 8 个字段 扫描只用 price (int32): 行式每条读一整行 列式只读 4 字节
+// soa_simd 行把 price 列交给 simd_sum / simd_count
+// build 含扩容: Vector 的大块可以 mremap 原地扩展 SoaVector 每列各自拷贝 build_reserved 先 reserve(n)
+#include "bench.h"
+#include "../SoaVector/SoaVector.h"
+#include "../Vector/Vector.h"
+#include "../simd_algorithm.h"
+#include <cstdint>
+#include <cstdlib>
+
+using i32 = std::int32_t;
+using u64 = std::uint64_t;
+
+struct Record
+{
+    u64 id;
+    u64 timestamp;
+    double weight;
+    double score;
+    i32 price;
+    i32 quantity;
+    u64 owner;
+    u64 flags;
+};
+
+using RecordColumns = SoaVector<u64, u64, double, double, i32, i32, u64, u64>;
+static const std::size_t price_column = 4;
+
+template<typename F>
+static void measure(const char* name, const char* variant, std::size_t n, F body)
+{
+    double best = 0;
+    for(int round = 0;round<5;++round)
+    {
+        BenchTimer timer;
+        body();
+        double ns = timer.elapsed_ns();
+        if(round == 0 || ns < best)
+            best = ns;
+    }
+    bench_report("soa", name, variant, n, 1, best, double(n));
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+
+    bench_header();
+
+    Vector<Record> rows;
+    RecordColumns cols;
+    measure("build", "aos", n, [&]() {
+        rows = Vector<Record>();
+        for(std::size_t i = 0;i<n;++i)
+            rows.push_back(Record{i, i * 7, 1.0, 0.5, i32(i % 1000), i32(i % 7), i % 97, 0});
+        do_not_optimize(rows.data());
+    });
+    measure("build", "soa", n, [&]() {
+        cols = RecordColumns();
+        for(std::size_t i = 0;i<n;++i)
+            cols.push_back(i, i * 7, 1.0, 0.5, i32(i % 1000), i32(i % 7), i % 97, 0);
+        do_not_optimize(cols.data<0>());
+    });
+
+    measure("build_reserved", "aos", n, [&]() {
+        Vector<Record> v;
+        v.reserve(n);
+        for(std::size_t i = 0;i<n;++i)
+            v.push_back(Record{i, i * 7, 1.0, 0.5, i32(i % 1000), i32(i % 7), i % 97, 0});
+        do_not_optimize(v.data());
+    });
+    measure("build_reserved", "soa", n, [&]() {
+        RecordColumns c;
+        c.reserve(n);
+        for(std::size_t i = 0;i<n;++i)
+            c.push_back(i, i * 7, 1.0, 0.5, i32(i % 1000), i32(i % 7), i % 97, 0);
+        do_not_optimize(c.data<0>());
+    });
+
+    measure("sum_field", "aos", n, [&]() {
+        long long sum = 0;
+        for(const Record& r : rows)
+            sum += r.price;
+        do_not_optimize(sum);
+    });
+    measure("sum_field", "soa", n, [&]() {
+        long long sum = 0;
+        for(i32 price : cols.column<price_column>())
+            sum += price;
+        do_not_optimize(sum);
+    });
+    measure("sum_field", "soa_simd", n, [&]() {
+        auto prices = cols.column<price_column>();
+        do_not_optimize(simd_sum(prices.begin(), prices.end()));
+    });
+
+    measure("count_field", "aos", n, [&]() {
+        std::size_t hits = 0;
+        for(const Record& r : rows)
+            hits += r.price == 500;
+        do_not_optimize(hits);
+    });
+    measure("count_field", "soa", n, [&]() {
+        std::size_t hits = 0;
+        for(i32 price : cols.column<price_column>())
+            hits += price == 500;
+        do_not_optimize(hits);
+    });
+    measure("count_field", "soa_simd", n, [&]() {
+        auto prices = cols.column<price_column>();
+        do_not_optimize(simd_count(prices.begin(), prices.end(), 500));
+    });
+    return 0;
+}
@@ -0,0 +1,312 @@
+#ifndef YXY__STL__PARALLEL_ALGORITHM_H
+#define YXY__STL__PARALLEL_ALGORITHM_H
+
+#include "thread_pool.h"
+#include "allocator.h"
+#include "relocate.h"
+#include<algorithm>
+#include<functional>
+#include<iterator>
+#include<type_traits>
+#include<utility>
+#include<vector>
+
+/*
+--- 基于 ThreadPool 的并行算法 作用于随机访问区间 (Vector<T>::iterator / data() 指针等)
+--- 区间按 grain 个元素切块 每块是一个任务 空闲线程互相窃取 块数多于线程数时负载自然均衡
+--- grain = 0 时自动选取: 每路约 8 块 且每块不少于 1024 个元素
+--- 不传线程池时使用 ThreadPool::global()
+--- op / comp 须可以被多个线程同时调用 reduce / scan 的 op 须满足结合律
+*/
+
+namespace parallel_detail
+{
+    inline std::size_t pick_grain(std::size_t n, std::size_t threads, std::size_t grain)
+    {
+        if(grain)
+            return grain;
+        std::size_t g = n / (threads * 8);
+        return g < 1024 ? 1024 : g;
+    }
+
+    // 把 [0, n) 按 grain 切块 对每块调用 body(块号, 起点, 终点) 块号从 0 连续编号
+    // 最后一块由当前线程直接执行 其余交给线程池
+    template<typename F>
+    void for_each_chunk(ThreadPool& pool, std::size_t n, std::size_t grain, F&& body)
+    {
+        if(n == 0)
+            return;
+        std::size_t chunks = (n + grain - 1) / grain;
+        if(chunks == 1 || pool.thread_count() == 1)
+        {
+            for(std::size_t c = 0;c<chunks;++c)
+                body(c, c * grain, c + 1 == chunks ? n : (c + 1) * grain);
+            return;
+        }
+        TaskGroup group(pool);
+        for(std::size_t c = 0;c + 1<chunks;++c)
+            group.run([&body, c, grain]() { body(c, c * grain, (c + 1) * grain); });
+        body(chunks - 1, (chunks - 1) * grain, n);
+        group.wait();
+    }
+
+    inline std::size_t chunk_count(std::size_t n, std::size_t grain)
+    { return (n + grain - 1) / grain; }
+
+    // 把有序的 [first1, last1) 与 [first2, last2) 移动归并到 out
+    // 两段都大于 grain 时按较长一段的中点切开 另一段二分找到对应位置 两半独立归并
+    template<typename It, typename Out, typename Compare>
+    void merge_move(TaskGroup& group, It first1, It last1, It first2, It last2, Out out, Compare comp, std::size_t grain)
+    {
+        while(static_cast<std::size_t>((last1 - first1) + (last2 - first2)) > grain)
+        {
+            It split1, split2;
+            if(last1 - first1 >= last2 - first2)
+            {
+                split1 = first1 + (last1 - first1) / 2;
+                split2 = std::lower_bound(first2, last2, *split1, comp);
+            }
+            else
+            {
+                split2 = first2 + (last2 - first2) / 2;
+                split1 = std::upper_bound(first1, last1, *split2, comp);
+            }
+            Out split_out = out + ((split1 - first1) + (split2 - first2));
+            group.run([&group, split1, last1, split2, last2, split_out, comp, grain]()
+            {
+                merge_move(group, split1, last1, split2, last2, split_out, comp, grain);
+            });
+            last1 = split1;
+            last2 = split2;
+        }
+        std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1),
+                   std::make_move_iterator(first2), std::make_move_iterator(last2), out, comp);
+    }
+}
+
+// ------------------------------ parallel_for ------------------------------
+// 对 [first, last) 的每个元素调用 f(元素引用)
+template<typename RandomIt, typename F>
+void parallel_for(ThreadPool& pool, RandomIt first, RandomIt last, F f, std::size_t grain = 0)
+{
+    std::size_t n = last - first;
+    grain = parallel_detail::pick_grain(n, pool.thread_count(), grain);
+    parallel_detail::for_each_chunk(pool, n, grain, [&](std::size_t, std::size_t lo, std::size_t hi)
+    {
+        for(RandomIt it = first + lo, end = first + hi;it != end;++it)
+            f(*it);
+    });
+}
+
+template<typename RandomIt, typename F>
+void parallel_for(RandomIt first, RandomIt last, F f, std::size_t grain = 0)
+{ parallel_for(ThreadPool::global(), first, last, std::move(f), grain); }
+
+// 下标版本: 对 [begin, end) 的每块调用 f(块起点, 块终点) 适合需要下标或整块处理的场景
+template<typename F>
+void parallel_for_range(ThreadPool& pool, std::size_t begin, std::size_t end, F f, std::size_t grain = 0)
+{
+    std::size_t n = end > begin ? end - begin : 0;
+    grain = parallel_detail::pick_grain(n, pool.thread_count(), grain);
+    parallel_detail::for_each_chunk(pool, n, grain, [&](std::size_t, std::size_t lo, std::size_t hi)
+    {
+        f(begin + lo, begin + hi);
+    });
+}
+
+template<typename F>
+void parallel_for_range(std::size_t begin, std::size_t end, F f, std::size_t grain = 0)
+{ parallel_for_range(ThreadPool::global(), begin, end, std::move(f), grain); }
+
+// ---------------------------- parallel_transform ---------------------------
+// out[i] = op(first[i]) out 可以与 first 相同 (原地变换)
+template<typename RandomIt, typename OutIt, typename UnaryOp>
+OutIt parallel_transform(ThreadPool& pool, RandomIt first, RandomIt last, OutIt out, UnaryOp op, std::size_t grain = 0)
+{
+    std::size_t n = last - first;
+    grain = parallel_detail::pick_grain(n, pool.thread_count(), grain);
+    parallel_detail::for_each_chunk(pool, n, grain, [&](std::size_t, std::size_t lo, std::size_t hi)
+    {
+        std::transform(first + lo, first + hi, out + lo, op);
+    });
+    return out + n;
+}
+
+template<typename RandomIt, typename OutIt, typename UnaryOp>
+OutIt parallel_transform(RandomIt first, RandomIt last, OutIt out, UnaryOp op, std::size_t grain = 0)
+{ return parallel_transform(ThreadPool::global(), first, last, out, std::move(op), grain); }
+
+// ----------------------------- parallel_reduce -----------------------------
+// 每块各自从块首元素开始归约 块结果再按顺序与 init 归约 (op 不必满足交换律)
+template<typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+T parallel_reduce(ThreadPool& pool, RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp(), std::size_t grain = 0)
+{
+    std::size_t n = last - first;
+    if(n == 0)
+        return init;
+    grain = parallel_detail::pick_grain(n, pool.thread_count(), grain);
+    std::vector<T> partial(parallel_detail::chunk_count(n, grain), init);
+    parallel_detail::for_each_chunk(pool, n, grain, [&](std::size_t c, std::size_t lo, std::size_t hi)
+    {
+        T acc = first[lo];
+        for(std::size_t i = lo + 1;i<hi;++i)
+            acc = op(std::move(acc), first[i]);
+        partial[c] = std::move(acc);
+    });
+    for(auto& p : partial)
+        init = op(std::move(init), std::move(p));
+    return init;
+}
+
+template<typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+T parallel_reduce(RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp(), std::size_t grain = 0)
+{ return parallel_reduce(ThreadPool::global(), first, last, std::move(init), std::move(op), grain); }
+
+// ------------------------- parallel_inclusive_scan -------------------------
+// out[i] = first[0] op ... op first[i] out 可以与 first 相同
+// 两遍: 先并行求每块的和 顺序算出每块的前缀 再并行在块内带前缀扫描
+template<typename RandomIt, typename OutIt, typename BinaryOp = std::plus<>>
+OutIt parallel_inclusive_scan(ThreadPool& pool, RandomIt first, RandomIt last, OutIt out,
+                              BinaryOp op = BinaryOp(), std::size_t grain = 0)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    std::size_t n = last - first;
+    if(n == 0)
+        return out;
+    grain = parallel_detail::pick_grain(n, pool.thread_count(), grain);
+    std::size_t chunks = parallel_detail::chunk_count(n, grain);
+    if(chunks == 1 || pool.thread_count() == 1)
+    {
+        T acc = first[0];
+        out[0] = acc;
+        for(std::size_t i = 1;i<n;++i)
+        {
+            acc = op(std::move(acc), first[i]);
+            out[i] = acc;
+        }
+        return out + n;
+    }
+
+    // 第一遍: 前 chunks-1 块各自的和 (最后一块的和用不到)
+    std::vector<T> carry(chunks, first[0]);
+    parallel_detail::for_each_chunk(pool, (chunks - 1) * grain, grain, [&](std::size_t c, std::size_t lo, std::size_t hi)
+    {
+        T acc = first[lo];
+        for(std::size_t i = lo + 1;i<hi;++i)
+            acc = op(std::move(acc), first[i]);
+        carry[c + 1] = std::move(acc);
+    });
+    // carry[c] 改为前 c 块所有元素的和 (c >= 1)
+    for(std::size_t c = 2;c<chunks;++c)
+        carry[c] = op(carry[c - 1], std::move(carry[c]));
+
+    // 第二遍: 块内扫描 从前缀开始累加
+    parallel_detail::for_each_chunk(pool, n, grain, [&](std::size_t c, std::size_t lo, std::size_t hi)
+    {
+        T acc = c == 0 ? first[lo] : op(carry[c], first[lo]);
+        out[lo] = acc;
+        for(std::size_t i = lo + 1;i<hi;++i)
+        {
+            acc = op(std::move(acc), first[i]);
+            out[i] = acc;
+        }
+    });
+    return out + n;
+}
+
+template<typename RandomIt, typename OutIt, typename BinaryOp = std::plus<>>
+OutIt parallel_inclusive_scan(RandomIt first, RandomIt last, OutIt out, BinaryOp op = BinaryOp(), std::size_t grain = 0)
+{ return parallel_inclusive_scan(ThreadPool::global(), first, last, out, std::move(op), grain); }
+
+// ------------------------------ parallel_sort ------------------------------
+// 不稳定排序: 各块并行 std::sort 再逐轮两两归并 每次归并本身也按 grain 切开并行
+// 需要与区间等长的临时缓冲区 元素在原区间与缓冲区之间移动赋值
+template<typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(ThreadPool& pool, RandomIt first, RandomIt last, Compare comp = Compare(), std::size_t grain = 0)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    std::size_t n = last - first;
+    grain = parallel_detail::pick_grain(n, pool.thread_count(), grain);
+    std::size_t chunks = parallel_detail::chunk_count(n, grain);
+    if(chunks <= 1 || pool.thread_count() == 1)
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    parallel_detail::for_each_chunk(pool, n, grain, [&](std::size_t, std::size_t lo, std::size_t hi)
+    {
+        std::sort(first + lo, first + hi, comp);
+    });
+
+    // 缓冲区按块并行地从原区间移动构造 原区间留下已移走的对象 两边都可以移动赋值
+    Allocator<T> alloc;
+    T* buffer = alloc.allocate(n);
+    std::vector<char> built(chunks, 0);
+    auto release_buffer = [&]()
+    {
+        for(std::size_t c = 0;c<chunks;++c)
+            if(built[c])
+                destroy_range(alloc, buffer + c * grain, buffer + std::min((c + 1) * grain, n));
+        alloc.deallocate(buffer, n);
+    };
+    try
+    {
+        parallel_detail::for_each_chunk(pool, n, grain, [&](std::size_t c, std::size_t lo, std::size_t hi)
+        {
+            std::size_t i = lo;
+            try
+            {
+                for(;i<hi;++i)
+                    alloc.construct(buffer + i, std::move_if_noexcept(first[i]));
+            }
+            catch(...)
+            {
+                destroy_range(alloc, buffer + lo, buffer + i);
+                throw;
+            }
+            built[c] = 1;
+        });
+
+        // 有序段此时都在缓冲区 每轮把相邻两段归并到另一侧 段长翻倍
+        bool in_buffer = true;
+        for(std::size_t width = grain;width<n;width *= 2)
+        {
+            TaskGroup group(pool);
+            for(std::size_t lo = 0;lo<n;lo += 2 * width)
+            {
+                std::size_t mid = std::min(lo + width, n), hi = std::min(lo + 2 * width, n);
+                group.run([&, lo, mid, hi]()
+                {
+                    if(in_buffer)
+                        parallel_detail::merge_move(group, buffer + lo, buffer + mid, buffer + mid, buffer + hi,
+                                                    first + lo, comp, grain);
+                    else
+                        parallel_detail::merge_move(group, first + lo, first + mid, first + mid, first + hi,
+                                                    buffer + lo, comp, grain);
+                });
+            }
+            group.wait();
+            in_buffer = !in_buffer;
+        }
+        if(in_buffer)
+        {
+            parallel_detail::for_each_chunk(pool, n, grain, [&](std::size_t, std::size_t lo, std::size_t hi)
+            {
+                std::move(buffer + lo, buffer + hi, first + lo);
+            });
+        }
+    }
+    catch(...)
+    {
+        release_buffer();
+        throw;
+    }
+    release_buffer();
+}
+
+template<typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp = Compare(), std::size_t grain = 0)
+{ parallel_sort(ThreadPool::global(), first, last, std::move(comp), grain); }
+
+#endif // YXY__STL__PARALLEL_ALGORITHM_H
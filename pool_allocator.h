@@ -0,0 +1,227 @@
+#ifndef YXY__STL__POOL_ALLOCATOR_H
+#define YXY__STL__POOL_ALLOCATOR_H
+
+#include<new>
+#include<cstddef>
+#include<limits>
+#include<memory>        // std::shared_ptr
+#include<utility>
+#include "allocator.h"      // AllocationResult
+
+/*
+--- 固定大小块内存池
+--- 请求按 16 字节粒度归入大小类 每个大小类一条空闲链表
+--- 空闲表为空时向系统申请一块 slab 按地址顺序切成等大小块串起来
+--- 同一个内存池连续分配得到的块在地址上相邻 释放只是挂回链表
+--- 超过 max_block 的请求直接走 ::operator new
+--- 非线程安全 与容器本身一致
+*/
+class PoolResource
+{
+public:
+    static constexpr std::size_t granularity = alignof(std::max_align_t);
+    static constexpr std::size_t max_block = 1024;
+    static constexpr std::size_t class_count = max_block / granularity;
+
+    // slab 从 32 块起步 每次翻倍 单个 slab 不超过 64 KiB
+    static constexpr std::size_t min_slab_blocks = 32;
+    static constexpr std::size_t max_slab_bytes = 64 * 1024;
+
+    PoolResource()
+    : slabs(nullptr)
+    {
+        for(std::size_t i = 0;i<class_count;++i)
+        {
+            free_lists[i] = nullptr;
+            slab_blocks[i] = min_slab_blocks;
+        }
+    }
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+    ~PoolResource()
+    { release(); }
+
+    // 该字节数是否由内存池管理
+    static bool fits(std::size_t bytes, std::size_t align)
+    { return bytes != 0 && bytes <= max_block && align <= granularity; }
+
+    // 实际分配出去的块大小 (向上取整到大小类)
+    static std::size_t rounded_size(std::size_t bytes)
+    { return (class_of(bytes) + 1) * granularity; }
+
+    void* allocate(std::size_t bytes)
+    {
+        std::size_t c = class_of(bytes);
+        if(free_lists[c] == nullptr)
+            refill(c);
+        Block* b = free_lists[c];
+        free_lists[c] = b->next;
+        return b;
+    }
+
+    void deallocate(void* p, std::size_t bytes)
+    {
+        std::size_t c = class_of(bytes);
+        Block* b = static_cast<Block*>(p);
+        b->next = free_lists[c];
+        free_lists[c] = b;
+    }
+
+    // 一次性归还所有 slab 之前分配出去的块全部失效
+    void release()
+    {
+        while(slabs)
+        {
+            Slab* next = slabs->next;
+            ::operator delete(slabs);
+            slabs = next;
+        }
+        for(std::size_t i = 0;i<class_count;++i)
+        {
+            free_lists[i] = nullptr;
+            slab_blocks[i] = min_slab_blocks;
+        }
+    }
+
+private:
+    struct Block { Block* next; };
+    struct Slab  { Slab* next; };
+
+    // slab 头部占用一个粒度 保证后面的块按粒度对齐
+    static constexpr std::size_t slab_header = granularity;
+    static_assert(sizeof(Slab) <= slab_header, "slab header too large");
+
+    Block* free_lists[class_count];
+    std::size_t slab_blocks[class_count];
+    Slab* slabs;
+
+    static std::size_t class_of(std::size_t bytes)
+    { return (bytes + granularity - 1) / granularity - 1; }
+
+    void refill(std::size_t c)
+    {
+        const std::size_t block = (c + 1) * granularity;
+        const std::size_t count = slab_blocks[c];
+        char* mem = static_cast<char*>(::operator new(slab_header + block * count));
+
+        Slab* slab = reinterpret_cast<Slab*>(mem);
+        slab->next = slabs;
+        slabs = slab;
+
+        // 按地址顺序串成空闲表 连续分配得到相邻的块
+        char* first = mem + slab_header;
+        for(std::size_t i = 0;i<count;++i)
+        {
+            Block* b = reinterpret_cast<Block*>(first + i * block);
+            b->next = i + 1 < count ? reinterpret_cast<Block*>(first + (i + 1) * block) : nullptr;
+        }
+        free_lists[c] = reinterpret_cast<Block*>(first);
+
+        if(block * count * 2 <= max_slab_bytes)
+            slab_blocks[c] = count * 2;
+    }
+};
+
+// 内存池分配器 拷贝/rebind 得到的分配器共享同一个内存池
+// 默认构造时新建一个内存池 容器内部需要的其他分配器 (如控制字节 / map) 都由主分配器 rebind 得到
+// 因此每个容器的结点和辅助数组集中在自己的 slab 中
+template<typename T>
+class PoolAllocator
+{
+    template<typename U>
+    friend class PoolAllocator;
+
+public:
+    // --- STL 契约的类型定义 ---
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<class U>
+    struct rebind
+    {
+        using other = PoolAllocator<U>;
+    };
+
+public:
+    // --- 构造及析构 ---
+    PoolAllocator()
+    : pool(std::make_shared<PoolResource>()) {}
+    // 共享外部内存池 (多个容器共用)
+    explicit PoolAllocator(std::shared_ptr<PoolResource> resource)
+    : pool(std::move(resource)) {}
+    // 只提供拷贝 移动也按拷贝处理 被移动的容器仍持有可用的内存池
+    PoolAllocator(const PoolAllocator&) = default;
+    PoolAllocator& operator=(const PoolAllocator&) = default;
+    template<class U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept
+    : pool(other.pool) {}
+    ~PoolAllocator() = default;
+
+    pointer allocate(size_type n)
+    {
+        if(n == 0)
+            return nullptr;
+        if(n > max_size())
+            throw std::bad_alloc();
+        size_type bytes = n * sizeof(value_type);
+        if(PoolResource::fits(bytes, alignof(value_type)))
+            return static_cast<pointer>(pool->allocate(bytes));
+        return static_cast<pointer>(::operator new(bytes));
+    }
+
+    // 扩展: 大小类取整后多出的空间也交给容器使用
+    AllocationResult<pointer> allocate_at_least(size_type n)
+    {
+        pointer p = allocate(n);
+        size_type bytes = n * sizeof(value_type);
+        if(PoolResource::fits(bytes, alignof(value_type)))
+            return {p, PoolResource::rounded_size(bytes) / sizeof(value_type)};
+        return {p, n};
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        if(p == nullptr)
+            return;
+        size_type bytes = n * sizeof(value_type);
+        if(PoolResource::fits(bytes, alignof(value_type)))
+            pool->deallocate(p, bytes);
+        else
+            ::operator delete(p);
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+    template<typename U>
+    void destroy(U* p)
+    {
+        p->~U();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    const std::shared_ptr<PoolResource>& resource() const noexcept
+    { return pool; }
+
+    // 共享同一个内存池才可以互相释放
+    template<typename U>
+    friend bool operator==(const PoolAllocator& a, const PoolAllocator<U>& b) { return a.pool == b.resource(); }
+    template<typename U>
+    friend bool operator!=(const PoolAllocator& a, const PoolAllocator<U>& b) { return a.pool != b.resource(); }
+
+private:
+    std::shared_ptr<PoolResource> pool;
+};
+
+#endif // YXY__STL__POOL_ALLOCATOR_H
@@ -0,0 +1,141 @@
+#ifndef YXY__STL__RELOCATE_H
+#define YXY__STL__RELOCATE_H
+
+#include<algorithm>
+#include<cstring>
+#include<iterator>
+#include<type_traits>
+#include<utility>
+
+/*
+--- 搬运(relocate) = 在新地址移动构造 + 析构旧对象
+--- 对于 is_trivially_relocatable 的类型 这两步等价于按字节拷贝
+--- 容器扩容/中间插入删除时可直接 memcpy/memmove 整段内存
+*/
+
+// 定制点: 默认取 std::is_trivially_copyable
+// 自定义类型若按字节搬运安全 (如只持有指针的 unique_ptr 式句柄) 可特化为 true_type
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// std::pair 的赋值运算符不是平凡的 (pair<const K, V> 不可赋值) is_trivially_copyable 总是 false
+// 两个成员都可平凡搬运时整个 pair 也可以 (哈希表的 pair<const Key, Value> 结点因此能整块 memcpy)
+template<typename A, typename B>
+struct is_trivially_relocatable<std::pair<A, B>>
+: std::integral_constant<bool, is_trivially_relocatable<A>::value && is_trivially_relocatable<B>::value> {};
+
+// 析构 [first, last)
+template<typename Alloc, typename T>
+void destroy_range(Alloc& alloc, T* first, T* last)
+{
+    if(std::is_trivially_destructible<T>::value)
+        return;
+    for(;first != last;++first)
+        alloc.destroy(first);
+}
+
+// 把 [first, last) 移动(noexcept 时)/拷贝 构造到未初始化内存 dest 返回构造结束位置
+// 中途抛异常时已构造的部分会被析构 原区间保持不变
+template<typename Alloc, typename T>
+T* uninitialized_move_if_noexcept(Alloc& alloc, T* first, T* last, T* dest)
+{
+    T* cur = dest;
+    try
+    {
+        for(;first != last;++first, ++cur)
+            alloc.construct(cur, std::move_if_noexcept(*first));
+    }
+    catch(...)
+    {
+        destroy_range(alloc, dest, cur);
+        throw;
+    }
+    return cur;
+}
+
+// 把任意输入区间 [first, last) 拷贝构造到未初始化内存 dest 返回构造结束位置
+// 源是指向同类型可平凡拷贝元素的指针时直接 memcpy 中途抛异常时已构造的部分会被析构
+template<typename Alloc, typename InputIt, typename T>
+T* uninitialized_copy_range(Alloc& alloc, InputIt first, InputIt last, T* dest)
+{
+    using source_type = typename std::iterator_traits<InputIt>::value_type;
+    if constexpr(std::is_pointer<InputIt>::value && std::is_same<typename std::remove_cv<source_type>::type, T>::value
+                 && std::is_trivially_copyable<T>::value)
+    {
+        std::size_t n = last - first;
+        if(n)
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+        return dest + n;
+    }
+    else
+    {
+        T* cur = dest;
+        try
+        {
+            for(;first != last;++first, ++cur)
+                alloc.construct(cur, *first);
+        }
+        catch(...)
+        {
+            destroy_range(alloc, dest, cur);
+            throw;
+        }
+        return cur;
+    }
+}
+
+// 把 [first, last) 搬到未初始化内存 dest (两者不重叠) 返回搬运结束位置
+// 完成后原区间视为未初始化内存
+template<typename Alloc, typename T>
+T* uninitialized_relocate(Alloc& alloc, T* first, T* last, T* dest)
+{
+    if(is_trivially_relocatable<T>::value)
+    {
+        if(first != last)
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+        return dest + (last - first);
+    }
+
+    T* result = uninitialized_move_if_noexcept(alloc, first, last, dest);
+    destroy_range(alloc, first, last);
+    return result;
+}
+
+// 容量足够时在 pos 处插入 value: [pos, last) 整体后移一位 last 处为未初始化内存 返回新的结束位置
+// 可平凡搬运的类型 memmove 后直接在空位构造; 否则末尾移动构造一个 其余移动赋值 (复用已有对象的资源)
+template<typename Alloc, typename T>
+T* relocate_insert(Alloc& alloc, T* pos, T* last, T&& value)
+{
+    if(pos == last)
+        alloc.construct(last, std::move(value));
+    else if(is_trivially_relocatable<T>::value)
+    {
+        std::memmove(static_cast<void*>(pos + 1), static_cast<const void*>(pos), (last - pos) * sizeof(T));
+        alloc.construct(pos, std::move(value));
+    }
+    else
+    {
+        alloc.construct(last, std::move(*(last - 1)));
+        std::move_backward(pos, last - 1, last);
+        *pos = std::move(value);
+    }
+    return last + 1;
+}
+
+// 删除 [first, last) 后一段 [last, end) 前移补位 返回新的结束位置
+template<typename Alloc, typename T>
+T* relocate_erase(Alloc& alloc, T* first, T* last, T* end)
+{
+    if(is_trivially_relocatable<T>::value)
+    {
+        destroy_range(alloc, first, last);
+        std::memmove(static_cast<void*>(first), static_cast<const void*>(last), (end - last) * sizeof(T));
+        return end - (last - first);
+    }
+
+    T* new_end = std::move(last, end, first);
+    destroy_range(alloc, new_end, end);
+    return new_end;
+}
+
+#endif // YXY__STL__RELOCATE_H
@@ -0,0 +1,477 @@
+#ifndef YXY__STL__SIMD_ALGORITHM_H
+#define YXY__STL__SIMD_ALGORITHM_H
+
+#include<algorithm>
+#include<atomic>
+#include<cstddef>
+#include<cstdint>
+#include<type_traits>
+
+/*
+--- 向量化的扫描算法: find / count / min_element / max_element / equal / sum
+--- 作用于连续内存 [first, last) (Vector<T>::data() 或 Vector<T>::iterator)
+--- int32 / float / double 走 SIMD 其他类型退回标准库 (sum 退回逐个累加)
+--- 运行时按 CPU 选择 AVX2 / SSE2 / 标量 三种实现 同一个二进制可以在不支持 AVX2 的机器上运行
+--- AVX2 内核用 target 属性单独编译 不需要 -mavx2
+--- sum: 整数累加到 64 位 float 累加到 double 浮点的相加顺序与逐个累加不同 末位可能有差异
+--- 浮点数据含 NaN 时 min_element / max_element 的结果可能与 std 版本不同
+*/
+
+enum class SimdLevel
+{
+    Scalar = 0,
+    SSE2   = 1,
+    AVX2   = 2,
+};
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define YXY_SIMD_X86 1
+#include<immintrin.h>
+#else
+#define YXY_SIMD_X86 0
+#endif
+
+// 本机支持的最高级别
+inline SimdLevel simd_detected_level()
+{
+#if YXY_SIMD_X86
+    static const SimdLevel level = []()
+    {
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+            return SimdLevel::AVX2;
+        if(__builtin_cpu_supports("sse2"))
+            return SimdLevel::SSE2;
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+namespace simd_detail
+{
+    inline std::atomic<int>& level_storage()
+    {
+        static std::atomic<int> level(static_cast<int>(simd_detected_level()));
+        return level;
+    }
+
+    // sum 的返回类型
+    template<typename T>
+    using sum_type = typename std::conditional<std::is_floating_point<T>::value, double,
+                     typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type>::type;
+
+    template<typename T>
+    struct is_simd_type : std::integral_constant<bool,
+        std::is_same<T, std::int32_t>::value || std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+    template<typename T>
+    struct type_tag { using type = T; };
+}
+
+// 当前使用的级别
+inline SimdLevel simd_level()
+{ return static_cast<SimdLevel>(simd_detail::level_storage().load(std::memory_order_relaxed)); }
+
+// 限制使用的级别 (测试 / 对比基准用) 高于本机支持的级别会被降到本机级别
+inline void set_simd_level(SimdLevel level)
+{
+    if(static_cast<int>(level) > static_cast<int>(simd_detected_level()))
+        level = simd_detected_level();
+    simd_detail::level_storage().store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+#if YXY_SIMD_X86
+
+// ---------------------------------- SSE2 ----------------------------------
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+namespace simd_detail { namespace sse2
+{
+    struct I32
+    {
+        using value_type = std::int32_t;
+        using sum_type = long long;
+        using reg = __m128i;
+        using acc = __m128i;                // 两个 64 位累加器
+        static constexpr int lanes = 4;
+
+        static reg load(const value_type* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static reg set1(value_type v) { return _mm_set1_epi32(v); }
+        static unsigned eq_mask(reg a, reg b)
+        { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+        // SSE2 没有 32 位 min/max 用比较结果选择
+        static reg min(reg a, reg b)
+        {
+            reg gt = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+        }
+        static reg max(reg a, reg b)
+        {
+            reg gt = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+        }
+        static value_type hmin(reg a)
+        {
+            alignas(16) value_type v[lanes];
+            _mm_store_si128(reinterpret_cast<__m128i*>(v), a);
+            return std::min(std::min(v[0], v[1]), std::min(v[2], v[3]));
+        }
+        static value_type hmax(reg a)
+        {
+            alignas(16) value_type v[lanes];
+            _mm_store_si128(reinterpret_cast<__m128i*>(v), a);
+            return std::max(std::max(v[0], v[1]), std::max(v[2], v[3]));
+        }
+        static acc acc_zero() { return _mm_setzero_si128(); }
+        // 符号扩展到 64 位再累加
+        static acc accumulate(acc s, reg v)
+        {
+            reg sign = _mm_cmpgt_epi32(_mm_setzero_si128(), v);
+            s = _mm_add_epi64(s, _mm_unpacklo_epi32(v, sign));
+            return _mm_add_epi64(s, _mm_unpackhi_epi32(v, sign));
+        }
+        static acc acc_add(acc a, acc b) { return _mm_add_epi64(a, b); }
+        static sum_type acc_reduce(acc s)
+        {
+            alignas(16) long long v[2];
+            _mm_store_si128(reinterpret_cast<__m128i*>(v), s);
+            return v[0] + v[1];
+        }
+    };
+
+    struct F32
+    {
+        using value_type = float;
+        using sum_type = double;
+        using reg = __m128;
+        using acc = __m128d;
+        static constexpr int lanes = 4;
+
+        static reg load(const value_type* p) { return _mm_loadu_ps(p); }
+        static reg set1(value_type v) { return _mm_set1_ps(v); }
+        static unsigned eq_mask(reg a, reg b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+        static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+        static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+        static value_type hmin(reg a)
+        {
+            alignas(16) value_type v[lanes];
+            _mm_store_ps(v, a);
+            return std::min(std::min(v[0], v[1]), std::min(v[2], v[3]));
+        }
+        static value_type hmax(reg a)
+        {
+            alignas(16) value_type v[lanes];
+            _mm_store_ps(v, a);
+            return std::max(std::max(v[0], v[1]), std::max(v[2], v[3]));
+        }
+        static acc acc_zero() { return _mm_setzero_pd(); }
+        static acc accumulate(acc s, reg v)
+        {
+            s = _mm_add_pd(s, _mm_cvtps_pd(v));
+            return _mm_add_pd(s, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+        }
+        static acc acc_add(acc a, acc b) { return _mm_add_pd(a, b); }
+        static sum_type acc_reduce(acc s)
+        {
+            alignas(16) double v[2];
+            _mm_store_pd(v, s);
+            return v[0] + v[1];
+        }
+    };
+
+    struct F64
+    {
+        using value_type = double;
+        using sum_type = double;
+        using reg = __m128d;
+        using acc = __m128d;
+        static constexpr int lanes = 2;
+
+        static reg load(const value_type* p) { return _mm_loadu_pd(p); }
+        static reg set1(value_type v) { return _mm_set1_pd(v); }
+        static unsigned eq_mask(reg a, reg b) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+        static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+        static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+        static value_type hmin(reg a)
+        {
+            alignas(16) value_type v[lanes];
+            _mm_store_pd(v, a);
+            return std::min(v[0], v[1]);
+        }
+        static value_type hmax(reg a)
+        {
+            alignas(16) value_type v[lanes];
+            _mm_store_pd(v, a);
+            return std::max(v[0], v[1]);
+        }
+        static acc acc_zero() { return _mm_setzero_pd(); }
+        static acc accumulate(acc s, reg v) { return _mm_add_pd(s, v); }
+        static acc acc_add(acc a, acc b) { return _mm_add_pd(a, b); }
+        static sum_type acc_reduce(acc s)
+        {
+            alignas(16) double v[2];
+            _mm_store_pd(v, s);
+            return v[0] + v[1];
+        }
+    };
+
+#include "simd_kernels.inc"
+}}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+// ---------------------------------- AVX2 ----------------------------------
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace simd_detail { namespace avx2
+{
+    struct I32
+    {
+        using value_type = std::int32_t;
+        using sum_type = long long;
+        using reg = __m256i;
+        using acc = __m256i;                // 四个 64 位累加器
+        static constexpr int lanes = 8;
+
+        static reg load(const value_type* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static reg set1(value_type v) { return _mm256_set1_epi32(v); }
+        static unsigned eq_mask(reg a, reg b)
+        { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+        static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+        static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+        static value_type hmin(reg a)
+        {
+            __m128i m = _mm_min_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+            m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+            m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtsi128_si32(m);
+        }
+        static value_type hmax(reg a)
+        {
+            __m128i m = _mm_max_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+            m = _mm_max_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+            m = _mm_max_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtsi128_si32(m);
+        }
+        static acc acc_zero() { return _mm256_setzero_si256(); }
+        static acc accumulate(acc s, reg v)
+        {
+            s = _mm256_add_epi64(s, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            return _mm256_add_epi64(s, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        static acc acc_add(acc a, acc b) { return _mm256_add_epi64(a, b); }
+        static sum_type acc_reduce(acc s)
+        {
+            alignas(32) long long v[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(v), s);
+            return v[0] + v[1] + v[2] + v[3];
+        }
+    };
+
+    struct F32
+    {
+        using value_type = float;
+        using sum_type = double;
+        using reg = __m256;
+        using acc = __m256d;
+        static constexpr int lanes = 8;
+
+        static reg load(const value_type* p) { return _mm256_loadu_ps(p); }
+        static reg set1(value_type v) { return _mm256_set1_ps(v); }
+        static unsigned eq_mask(reg a, reg b)
+        { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+        static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+        static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+        static value_type hmin(reg a)
+        {
+            __m128 m = _mm_min_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+            m = _mm_min_ss(m, _mm_shuffle_ps(m, m, 1));
+            return _mm_cvtss_f32(m);
+        }
+        static value_type hmax(reg a)
+        {
+            __m128 m = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+            m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+            return _mm_cvtss_f32(m);
+        }
+        static acc acc_zero() { return _mm256_setzero_pd(); }
+        static acc accumulate(acc s, reg v)
+        {
+            s = _mm256_add_pd(s, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+            return _mm256_add_pd(s, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+        }
+        static acc acc_add(acc a, acc b) { return _mm256_add_pd(a, b); }
+        static sum_type acc_reduce(acc s)
+        {
+            alignas(32) double v[4];
+            _mm256_store_pd(v, s);
+            return (v[0] + v[1]) + (v[2] + v[3]);
+        }
+    };
+
+    struct F64
+    {
+        using value_type = double;
+        using sum_type = double;
+        using reg = __m256d;
+        using acc = __m256d;
+        static constexpr int lanes = 4;
+
+        static reg load(const value_type* p) { return _mm256_loadu_pd(p); }
+        static reg set1(value_type v) { return _mm256_set1_pd(v); }
+        static unsigned eq_mask(reg a, reg b)
+        { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+        static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+        static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+        static value_type hmin(reg a)
+        {
+            __m128d m = _mm_min_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+            return _mm_cvtsd_f64(_mm_min_sd(m, _mm_unpackhi_pd(m, m)));
+        }
+        static value_type hmax(reg a)
+        {
+            __m128d m = _mm_max_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+            return _mm_cvtsd_f64(_mm_max_sd(m, _mm_unpackhi_pd(m, m)));
+        }
+        static acc acc_zero() { return _mm256_setzero_pd(); }
+        static acc accumulate(acc s, reg v) { return _mm256_add_pd(s, v); }
+        static acc acc_add(acc a, acc b) { return _mm256_add_pd(a, b); }
+        static sum_type acc_reduce(acc s)
+        {
+            alignas(32) double v[4];
+            _mm256_store_pd(v, s);
+            return (v[0] + v[1]) + (v[2] + v[3]);
+        }
+    };
+
+#include "simd_kernels.inc"
+}}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+namespace simd_detail
+{
+    // 元素类型 -> 某个 ISA 下的向量操作
+    template<typename T> struct sse2_ops;
+    template<> struct sse2_ops<std::int32_t> { using type = sse2::I32; };
+    template<> struct sse2_ops<float> { using type = sse2::F32; };
+    template<> struct sse2_ops<double> { using type = sse2::F64; };
+    template<typename T> struct avx2_ops;
+    template<> struct avx2_ops<std::int32_t> { using type = avx2::I32; };
+    template<> struct avx2_ops<float> { using type = avx2::F32; };
+    template<> struct avx2_ops<double> { using type = avx2::F64; };
+}
+
+#endif // YXY_SIMD_X86
+
+namespace simd_detail
+{
+    // 按当前级别调用 kernel(type_tag<Kernels<V>>) 类型不支持或标量级别时调用 fallback()
+    template<typename T, typename Kernel, typename Fallback>
+    auto dispatch(Kernel kernel, Fallback fallback) -> decltype(fallback())
+    {
+#if YXY_SIMD_X86
+        if constexpr(is_simd_type<T>::value)
+        {
+            SimdLevel level = simd_level();
+            if(level == SimdLevel::AVX2)
+                return kernel(type_tag<avx2::Kernels<typename avx2_ops<T>::type>>());
+            if(level == SimdLevel::SSE2)
+                return kernel(type_tag<sse2::Kernels<typename sse2_ops<T>::type>>());
+        }
+#else
+        (void)kernel;
+#endif
+        return fallback();
+    }
+}
+
+// ------------------------------- 对外接口 -------------------------------
+// T 可以带 const 返回的指针与传入的同样带/不带 const
+
+template<typename T>
+T* simd_find(T* first, T* last, const typename std::remove_const<T>::type& value)
+{
+    using U = typename std::remove_const<T>::type;
+    const U* p = simd_detail::dispatch<U>(
+        [&](auto k) { return decltype(k)::type::find(first, last, value); },
+        [&]() -> const U* { return std::find(first, last, value); });
+    return const_cast<T*>(p);
+}
+
+template<typename T>
+std::size_t simd_count(const T* first, const T* last, const typename std::remove_const<T>::type& value)
+{
+    return simd_detail::dispatch<T>(
+        [&](auto k) { return decltype(k)::type::count(first, last, value); },
+        [&]() { return static_cast<std::size_t>(std::count(first, last, value)); });
+}
+
+template<typename T>
+T* simd_min_element(T* first, T* last)
+{
+    using U = typename std::remove_const<T>::type;
+    const U* p = simd_detail::dispatch<U>(
+        [&](auto k) { return decltype(k)::type::min_element(first, last); },
+        [&]() -> const U* { return std::min_element(first, last); });
+    return const_cast<T*>(p);
+}
+
+template<typename T>
+T* simd_max_element(T* first, T* last)
+{
+    using U = typename std::remove_const<T>::type;
+    const U* p = simd_detail::dispatch<U>(
+        [&](auto k) { return decltype(k)::type::max_element(first, last); },
+        [&]() -> const U* { return std::max_element(first, last); });
+    return const_cast<T*>(p);
+}
+
+template<typename T>
+bool simd_equal(const T* first1, const T* last1, const T* first2)
+{
+    return simd_detail::dispatch<T>(
+        [&](auto k) { return decltype(k)::type::equal(first1, last1, first2); },
+        [&]() { return std::equal(first1, last1, first2); });
+}
+
+template<typename T>
+simd_detail::sum_type<T> simd_sum(const T* first, const T* last)
+{
+    static_assert(std::is_arithmetic<T>::value, "simd_sum requires an arithmetic type");
+    using S = simd_detail::sum_type<T>;
+    return simd_detail::dispatch<T>(
+        [&](auto k) -> S { return decltype(k)::type::sum(first, last); },
+        [&]()
+        {
+            S s = 0;
+            for(;first != last;++first)
+                s += static_cast<S>(*first);
+            return s;
+        });
+}
+
+#endif // YXY__STL__SIMD_ALGORITHM_H
@@ -0,0 +1,206 @@
+#ifndef YXY__STL__SNAPSHOT_H
+#define YXY__STL__SNAPSHOT_H
+
+#include<cerrno>
+#include<cstddef>
+#include<cstdint>
+#include<cstdio>
+#include<cstring>
+#include<string>
+#include<stdexcept>
+#include<system_error>
+
+/*
+--- 容器二进制快照格式 (Vector::save_snapshot / Unordered_map::save_snapshot 共用)
+--- 文件 = SnapshotHeader + 若干数据段 每段起点按 snapshot_alignment 对齐 (相对文件开头)
+--- 数据段就是容器内存的原样字节: Vector 为 data() 数组 Unordered_map 为控制字节数组 + 槽位数组
+--- 读取时不解析元素 不重新哈希 每段一次整块读入; 整个文件 mmap 后各段也可以直接当数组用
+--- 只支持可平凡拷贝的元素 快照与机器字节序 / 元素布局相关 不用于跨平台交换
+--- 格式不符抛出 std::runtime_error 读写失败抛出 std::system_error
+*/
+
+enum class SnapshotKind : std::uint32_t
+{
+    Vector          = 1,
+    UnorderedMap    = 2,
+};
+
+struct SnapshotHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t kind;             // SnapshotKind
+    std::uint32_t endian;           // 写入 0x01020304 读出不同说明字节序不同
+    std::uint32_t elem_size;        // Vector: sizeof(T)  Unordered_map: 槽位结点大小
+    std::uint32_t elem_align;
+    std::uint32_t key_size;         // 以下仅 Unordered_map 使用
+    std::uint32_t value_size;
+    std::uint32_t group_width;
+    std::uint32_t flags;
+    std::uint32_t reserved;
+    std::uint64_t count;            // 元素个数
+    std::uint64_t capacity;         // Unordered_map: 槽位数
+    std::uint64_t growth_left;
+    std::uint64_t old_capacity;     // 渐进式 rehash 中的旧表 (没有时为 0)
+    std::uint64_t old_size;
+    std::uint64_t migrate_pos;
+};
+
+namespace snapshot_detail
+{
+    constexpr char magic[8] = {'Y', 'X', 'Y', 'S', 'N', 'A', 'P', '\0'};
+    constexpr std::uint32_t version = 1;
+    constexpr std::uint32_t endian_tag = 0x01020304u;
+    // 数据段对齐 元素对齐要求不能超过它
+    constexpr std::size_t alignment = 64;
+
+    [[noreturn]] inline void throw_errno(const char* what)
+    {
+        throw std::system_error(errno ? errno : EIO, std::generic_category(), what);
+    }
+
+    inline SnapshotHeader make_header(SnapshotKind kind, std::size_t elem_size, std::size_t elem_align)
+    {
+        SnapshotHeader h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, magic, sizeof(h.magic));
+        h.version = version;
+        h.kind = static_cast<std::uint32_t>(kind);
+        h.endian = endian_tag;
+        h.elem_size = static_cast<std::uint32_t>(elem_size);
+        h.elem_align = static_cast<std::uint32_t>(elem_align);
+        return h;
+    }
+
+    inline void write_bytes(std::FILE* f, const void* p, std::size_t n)
+    {
+        errno = 0;
+        if(n && std::fwrite(p, 1, n, f) != n)
+            throw_errno("snapshot:: write failed!");
+    }
+
+    inline void read_bytes(std::FILE* f, void* p, std::size_t n)
+    {
+        errno = 0;
+        if(n && std::fread(p, 1, n, f) != n)
+        {
+            if(std::feof(f))
+                throw std::runtime_error("snapshot:: unexpected end of file!");
+            throw_errno("snapshot:: read failed!");
+        }
+    }
+
+    // 当前位置到下一个对齐点的字节数
+    inline std::size_t padding(std::FILE* f)
+    {
+        long pos = std::ftell(f);
+        if(pos < 0)
+            throw_errno("snapshot:: stream not seekable!");
+        return (alignment - static_cast<std::size_t>(pos) % alignment) % alignment;
+    }
+
+    // 补零到下一个对齐点 (数据段的起点)
+    inline void write_padding(std::FILE* f)
+    {
+        static const char zeros[alignment] = {};
+        write_bytes(f, zeros, padding(f));
+    }
+
+    // 写入一个数据段 先补零到对齐点
+    inline void write_section(std::FILE* f, const void* p, std::size_t n)
+    {
+        write_padding(f);
+        write_bytes(f, p, n);
+    }
+
+    // 当前位置之后剩余的字节数
+    inline std::uint64_t remaining(std::FILE* f)
+    {
+        long pos = std::ftell(f);
+        if(pos < 0 || std::fseek(f, 0, SEEK_END) != 0)
+            throw_errno("snapshot:: stream not seekable!");
+        long end = std::ftell(f);
+        if(end < 0 || std::fseek(f, pos, SEEK_SET) != 0)
+            throw_errno("snapshot:: seek failed!");
+        return end > pos ? static_cast<std::uint64_t>(end - pos) : 0;
+    }
+
+    inline void read_section(std::FILE* f, void* p, std::size_t n)
+    {
+        std::size_t pad = padding(f);
+        if(pad && std::fseek(f, static_cast<long>(pad), SEEK_CUR) != 0)
+            throw_errno("snapshot:: seek failed!");
+        read_bytes(f, p, n);
+    }
+
+    // 检查文件头与期望的类型 / 布局一致
+    inline void check_header(const SnapshotHeader& h, SnapshotKind kind, std::size_t elem_size, std::size_t elem_align)
+    {
+        if(std::memcmp(h.magic, magic, sizeof(h.magic)) != 0)
+            throw std::runtime_error("snapshot:: not a snapshot file!");
+        if(h.version != version)
+            throw std::runtime_error("snapshot:: unsupported version!");
+        if(h.endian != endian_tag)
+            throw std::runtime_error("snapshot:: byte order mismatch!");
+        if(h.kind != static_cast<std::uint32_t>(kind))
+            throw std::runtime_error("snapshot:: container kind mismatch!");
+        if(h.elem_size != elem_size || h.elem_align != elem_align)
+            throw std::runtime_error("snapshot:: element layout mismatch!");
+    }
+
+    // 按路径读写快照的文件句柄
+    // 写入先写到 path.tmp 提交时再改名 中途失败不会破坏原有快照
+    class SnapshotFile
+    {
+    public:
+        SnapshotFile(const std::string& path, bool write)
+        : target(path), temp(write ? path + ".tmp" : std::string()), file(nullptr)
+        {
+            file = std::fopen(write ? temp.c_str() : path.c_str(), write ? "wb" : "rb");
+            if(!file)
+                throw_errno("snapshot:: open failed!");
+        }
+        SnapshotFile(const SnapshotFile&) = delete;
+        SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+        ~SnapshotFile()
+        {
+            if(file)
+            {
+                std::fclose(file);
+                if(!temp.empty())
+                    std::remove(temp.c_str());
+            }
+        }
+
+        std::FILE* get() const
+        { return file; }
+
+        // 写入方: 刷新并把临时文件改名为目标文件
+        void commit()
+        {
+            errno = 0;
+            int r = std::fclose(file);
+            file = nullptr;
+            if(r != 0)
+            {
+                std::remove(temp.c_str());
+                throw_errno("snapshot:: write failed!");
+            }
+            if(std::rename(temp.c_str(), target.c_str()) != 0)
+            {
+                int e = errno;
+                std::remove(temp.c_str());
+                errno = e;
+                throw_errno("snapshot:: rename failed!");
+            }
+        }
+
+    private:
+        std::string target;
+        std::string temp;
+        std::FILE* file;
+    };
+}
+
+#endif // YXY__STL__SNAPSHOT_H
@@ -0,0 +1,309 @@
+#include "pool_allocator.h"
+#include "arena_allocator.h"
+#include "thread_cache_allocator.h"
+#include "alloc_stats.h"
+#include "Vector/Vector.h"
+#include "Unordered_map/Unordered_map.h"
+#include "Deque/Deque.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+
+// =========================================================
+// 1. 内存池分配器
+// =========================================================
+struct Node {
+    Node* next;
+    long payload[3];
+};
+
+void test_pool_allocator() {
+    std::cout << "\n=== 1. Testing PoolAllocator ===" << std::endl;
+
+    PoolAllocator<Node> a;
+    Node* n1 = a.allocate(1);
+    Node* n2 = a.allocate(1);
+    assert(reinterpret_cast<char*>(n2) - reinterpret_cast<char*>(n1) == static_cast<long>(sizeof(Node)));
+    std::cout << "PASS: Consecutive nodes are adjacent" << std::endl;
+
+    a.deallocate(n2, 1);
+    Node* n3 = a.allocate(1);
+    assert(n3 == n2);
+    a.deallocate(n1, 1);
+    a.deallocate(n3, 1);
+    std::cout << "PASS: Freed block is reused" << std::endl;
+
+    // rebind 共享同一个内存池
+    PoolAllocator<Node>::rebind<int>::other b(a);
+    assert(b.resource() == a.resource());
+    assert(a == b);
+    assert(a != PoolAllocator<Node>());
+    int* big = b.allocate(10000);             // 超过 max_block 走 operator new
+    big[9999] = 1;
+    b.deallocate(big, 10000);
+    std::cout << "PASS: rebind shares pool" << std::endl;
+
+    // 大小类取整后的空间计入 Vector 容量
+    Vector<char, PoolAllocator<char>> small;
+    small.push_back('x');
+    assert(small.capacity() == PoolResource::granularity);
+    std::cout << "PASS: allocate_at_least rounds to size class" << std::endl;
+}
+
+// =========================================================
+// 2. 作为容器的分配器
+// =========================================================
+void test_pool_containers() {
+    std::cout << "\n=== 2. Testing Containers with PoolAllocator ===" << std::endl;
+
+    Vector<std::string, PoolAllocator<std::string>> v;
+    for (int i = 0; i < 100; ++i)
+        v.push_back(std::to_string(i));
+    Vector<std::string, PoolAllocator<std::string>> w(std::move(v));
+    v.push_back("reused after move");
+    assert(w.size() == 100 && w[99] == "99" && v.size() == 1);
+    std::cout << "PASS: Vector<std::string, PoolAllocator>" << std::endl;
+
+    using PoolMap = Unordered_map<int, std::string, std::hash<int>, std::equal_to<int>,
+                                  PoolAllocator<HashNode<int, std::string>>>;
+    PoolMap m;
+    for (int i = 0; i < 1000; ++i)
+        m[i] = std::to_string(i);
+    for (int i = 0; i < 1000; i += 2)
+        m.erase(i);
+    PoolMap copy(m);
+    assert(copy.size() == 500 && copy.at(999) == "999" && !copy.contains(998));
+    std::cout << "PASS: Unordered_map with PoolAllocator" << std::endl;
+
+    // 默认构造的容器: 结点分配器与 rebind 出的控制字节 / map 分配器共用一个内存池
+    // 持有者: 容器内两个分配器 + get_allocator() 返回的副本
+    PoolMap fresh;
+    assert(fresh.get_allocator().resource().use_count() == 3);
+    Deque<int, PoolAllocator<int>> dq;
+    assert(dq.get_allocator().resource().use_count() == 3);
+    std::cout << "PASS: Rebound internal allocators share the container's pool" << std::endl;
+}
+
+// =========================================================
+// 3. arena 分配器
+// =========================================================
+void test_arena_allocator() {
+    std::cout << "\n=== 3. Testing ArenaAllocator ===" << std::endl;
+
+    MonotonicBuffer arena;
+    ArenaAllocator<int> a(arena);
+    int* p = a.allocate(4);
+    int* q = a.allocate(4);
+    assert(q == p + 4);
+    assert(a.try_expand(q, 4, 64));       // 最后一次分配可以原地变长
+    assert(!a.try_expand(p, 4, 8));       // 中间的块不行
+    std::cout << "PASS: Bump allocation / try_expand" << std::endl;
+
+    // 没有隐式的默认 arena 必须显式指定
+    static_assert(!std::is_default_constructible<ArenaAllocator<int>>::value,
+                  "ArenaAllocator must be bound to an explicit arena");
+    std::cout << "PASS: No default-constructed ArenaAllocator" << std::endl;
+
+    // Vector 扩容时原地变长 地址不变
+    MonotonicBuffer arena2(1 << 16);
+    Vector<int, ArenaAllocator<int>> v{ArenaAllocator<int>(arena2)};
+    v.push_back(0);
+    int* first = v.data();
+    for (int i = 1; i < 1000; ++i)
+        v.push_back(i);
+    assert(v.data() == first);
+    for (int i = 0; i < 1000; ++i)
+        assert(v[i] == i);
+    std::cout << "PASS: Vector grows in place inside the arena" << std::endl;
+
+    using ArenaMap = Unordered_map<std::string, int, std::hash<std::string>, std::equal_to<std::string>,
+                                   ArenaAllocator<HashNode<std::string, int>>>;
+    {
+        ArenaMap m{ArenaAllocator<HashNode<std::string, int>>(arena2)};
+        for (int i = 0; i < 1000; ++i)
+            m[std::to_string(i)] = i;
+        assert(m.size() == 1000 && m.at("500") == 500);
+        assert(m.get_allocator().resource() == &arena2);
+
+        // 未命中 / 空句柄得到的句柄也绑定到同一个 arena (分配器没有默认构造)
+        auto miss = m.extract("missing");
+        assert(miss.empty() && miss.get_allocator().resource() == &arena2);
+        auto nh = m.extract("7");
+        assert(!nh.empty() && nh.mapped() == 7);
+        auto res = m.insert(std::move(nh));
+        assert(res.inserted && res.node.empty() && res.node.get_allocator().resource() == &arena2);
+        res = m.insert(std::move(miss));
+        assert(!res.inserted && res.node.get_allocator().resource() == &arena2);
+    }
+    std::cout << "PASS: Unordered_map in arena" << std::endl;
+
+    // 外部缓冲区用完后再向堆申请
+    alignas(16) char buf[256];
+    MonotonicBuffer small(buf, sizeof(buf));
+    ArenaAllocator<long> b(small);
+    long* in_buf = b.allocate(8);
+    assert(reinterpret_cast<char*>(in_buf) >= buf && reinterpret_cast<char*>(in_buf) < buf + sizeof(buf));
+    long* on_heap = b.allocate(1000);
+    on_heap[999] = 1;
+    small.reset();
+    assert(b.allocate(8) == in_buf);
+    std::cout << "PASS: Initial buffer / reset" << std::endl;
+
+    // 每个请求一次 reset: 块大小回到初始值 不会越滚越大
+    MonotonicBuffer per_request(1024);
+    for (int request = 0; request < 100; ++request) {
+        char* head = static_cast<char*>(per_request.allocate(16, 8));
+        head[0] = 'x';
+        assert(!per_request.try_expand(head, 16, 2048));
+        per_request.reset();
+    }
+    std::cout << "PASS: Chunk size restored by reset" << std::endl;
+
+    // 字节数加对齐 / 块头会溢出的请求
+    bool thrown = false;
+    try { per_request.allocate(std::size_t(-1) - 8, 16); } catch (const std::bad_alloc&) { thrown = true; }
+    assert(thrown);
+    std::cout << "PASS: Oversized request throws std::bad_alloc" << std::endl;
+}
+
+// =========================================================
+// 4. 线程缓存分配器
+// =========================================================
+void test_thread_cache_allocator() {
+    std::cout << "\n=== 4. Testing ThreadCacheAllocator ===" << std::endl;
+
+    // 各线程独立使用容器
+    auto work = [](int seed) {
+        Vector<int, ThreadCacheAllocator<int>> v;
+        Unordered_map<int, int, std::hash<int>, std::equal_to<int>,
+                      ThreadCacheAllocator<HashNode<int, int>>> m;
+        for (int i = 0; i < 20000; ++i) {
+            v.push_back(i + seed);
+            m[i] = seed;
+        }
+        assert(v[19999] == 19999 + seed && m.size() == 20000 && m.at(123) == seed);
+    };
+    std::thread t1(work, 1), t2(work, 2), t3(work, 3);
+    t1.join(); t2.join(); t3.join();
+    std::cout << "PASS: Containers on several threads" << std::endl;
+
+    // 一个线程分配 另一个线程释放
+    ThreadCacheAllocator<long> a;
+    const int count = 5000;
+    long* ptrs[count];
+    std::thread producer([&]() {
+        for (int i = 0; i < count; ++i) {
+            ptrs[i] = a.allocate(1 + i % 100);
+            ptrs[i][0] = i;
+        }
+    });
+    producer.join();
+    std::thread consumer([&]() {
+        for (int i = 0; i < count; ++i) {
+            assert(ptrs[i][0] == i);
+            a.deallocate(ptrs[i], 1 + i % 100);
+        }
+    });
+    consumer.join();
+    std::cout << "PASS: Cross-thread free" << std::endl;
+}
+
+// =========================================================
+// 5. 分配统计 / 扩容计数
+// =========================================================
+struct VecTag;
+struct MapTag;
+static std::size_t hook_calls = 0;
+
+void test_alloc_stats() {
+    std::cout << "\n=== 5. Testing Allocation Stats ===" << std::endl;
+
+    AllocStats& vs = alloc_stats<VecTag>();
+    {
+        Vector<int, InstrumentedAllocator<int, VecTag>, CountingGrowth<GrowDouble, VecTag>> v;
+        for (int i = 0; i < 100; ++i)
+            v.push_back(i);
+        // 容量 1 2 4 ... 128 共 8 次分配 最后只剩 128 个 int
+        assert(vs.allocations == 8 && vs.deallocations == 7);
+        assert(vs.live_bytes == 128 * sizeof(int));
+        assert(vs.peak_bytes == (128 + 64) * sizeof(int));
+        assert(vs.histogram[AllocStats::bucket_of(512)] == 1);
+    }
+    assert(vs.live_bytes == 0 && vs.deallocations == 8);
+    std::cout << "PASS: Vector allocations / live / peak / histogram" << std::endl;
+
+    // 扩容计数: reserve 过的容器不计数
+    using Growth = CountingGrowth<GrowDouble, VecTag>;
+    Growth::stats().hook = [](std::size_t, std::size_t, std::size_t) { ++hook_calls; };
+    assert(Growth::stats().regrows == 8);
+    Growth::stats().reset();
+    {
+        Vector<int, Allocator<int>, Growth> v;
+        v.reserve(100);
+        for (int i = 0; i < 100; ++i)
+            v.push_back(i);
+        assert(Growth::stats().regrows == 0);
+        v.push_back(100);
+        assert(Growth::stats().regrows == 1 && hook_calls == 1);
+        assert(Growth::stats().relocated_bytes == 100 * sizeof(int));
+    }
+    Growth::stats().hook = nullptr;
+    std::cout << "PASS: Regrow counter and hook" << std::endl;
+
+    // rebind 后 (结点 + 控制字节) 仍记在同一个 Tag 下
+    AllocStats& ms = alloc_stats<MapTag>();
+    {
+        Unordered_map<int, int, std::hash<int>, std::equal_to<int>,
+                      InstrumentedAllocator<HashNode<int, int>, MapTag>> m;
+        for (int i = 0; i < 1000; ++i)
+            m[i] = i;
+        assert(ms.allocations > 0 && ms.live_bytes > 0);
+        assert(ms.peak_bytes >= ms.live_bytes);
+    }
+    assert(ms.live_bytes == 0 && ms.allocations == ms.deallocations);
+    std::cout << "PASS: Unordered_map stats through rebind" << std::endl;
+
+    // 扩展接口照常转发: arena 原地扩展计入 expansions
+    MonotonicBuffer arena;
+    alloc_stats<void>().reset();
+    {
+        Vector<char, InstrumentedAllocator<char, void, ArenaAllocator<char>>> v{
+            InstrumentedAllocator<char, void, ArenaAllocator<char>>(ArenaAllocator<char>(arena))};
+        for (int i = 0; i < 1000; ++i)
+            v.push_back('a');
+        assert(alloc_stats<void>().expansions > 0);
+        assert(alloc_stats<void>().live_bytes == v.capacity());
+    }
+    std::cout << "PASS: try_expand forwarded and counted" << std::endl;
+
+    // 未定义 YXY_STL_ALLOC_STATS 时别名就是原类型
+#if !defined(YXY_STL_ALLOC_STATS)
+    static_assert(std::is_same<StatsAllocator<int>, Allocator<int>>::value, "StatsAllocator disabled");
+    static_assert(std::is_same<StatsGrowth<>, GrowDouble>::value, "StatsGrowth disabled");
+    std::cout << "PASS: Disabled aliases are the plain types" << std::endl;
+#endif
+}
+
+int main() {
+    try {
+        test_pool_allocator();
+        test_pool_containers();
+        test_arena_allocator();
+        test_thread_cache_allocator();
+        test_alloc_stats();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,318 @@
+#include "ConcurrentUnorderedMap/ConcurrentUnorderedMap.h"
+#include "alloc_stats.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <random>
+
+// =========================================================
+// 1. 单线程基本操作
+// =========================================================
+void test_basic() {
+    std::cout << "\n=== 1. Testing Basic Operations ===" << std::endl;
+
+    ConcurrentUnorderedMap<int, int> m(8);
+    static_assert(ConcurrentUnorderedMap<int, int>::optimistic_reads, "int/int reads are optimistic");
+    assert(m.shards_count() == 8 && m.empty());
+
+    for (int i = 0; i < 1000; ++i)
+        assert(m.insert_or_assign(i, i * 2));
+    assert(m.size() == 1000);
+    assert(!m.insert_or_assign(7, 70));
+    assert(*m.find(7) == 70 && *m.find(999) == 1998);
+    assert(!m.find(1000) && !m.contains(-1) && m.contains(0));
+    std::cout << "PASS: insert_or_assign / find / contains" << std::endl;
+
+    assert(m.erase(7) == 1 && m.erase(7) == 0);
+    assert(!m.contains(7) && m.size() == 999);
+    std::cout << "PASS: erase" << std::endl;
+
+    assert(m.visit(8, [](std::pair<const int, int>& kv) { kv.second += 1; }));
+    assert(*m.find(8) == 17);
+    assert(!m.visit(7, [](std::pair<const int, int>&) { assert(false); }));
+    long long sum = 0;
+    m.cvisit_all([&](const std::pair<const int, int>& kv) { sum += kv.first; });
+    assert(sum == 999LL * 1000 / 2 - 7);
+    std::cout << "PASS: visit / cvisit_all" << std::endl;
+
+    m.clear();
+    assert(m.empty() && !m.contains(8));
+    m.insert_or_assign(8, 1);
+    m.reclaim();
+    assert(*m.find(8) == 1);
+    std::cout << "PASS: clear / reclaim" << std::endl;
+}
+
+// =========================================================
+// 2. 非平凡类型 (共享锁读)
+// =========================================================
+void test_locked_reads() {
+    std::cout << "\n=== 2. Testing Non-Trivial Types ===" << std::endl;
+
+    ConcurrentUnorderedMap<std::string, std::string> m(4);
+    static_assert(!ConcurrentUnorderedMap<std::string, std::string>::optimistic_reads, "strings take the shared lock");
+    for (int i = 0; i < 500; ++i)
+        m.insert_or_assign("key_" + std::to_string(i), std::string(20, 'a' + i % 26));
+    assert(*m.find("key_1") == std::string(20, 'b'));
+    std::string k = "key_2";
+    m.insert_or_assign(std::move(k), std::string("moved"));
+    assert(*m.find("key_2") == "moved");
+    assert(m.erase("key_3") == 1 && !m.contains("key_3") && m.size() == 499);
+    bool seen = false;
+    m.cvisit("key_2", [&](const std::pair<const std::string, std::string>& kv) { seen = kv.second == "moved"; });
+    assert(seen);
+    std::cout << "PASS: std::string keys and values" << std::endl;
+}
+
+// =========================================================
+// 3. 并发读写 读者不会看到撕裂的值
+// =========================================================
+struct Pair64 {
+    std::uint64_t a;
+    std::uint64_t b;
+};
+
+void test_concurrent() {
+    std::cout << "\n=== 3. Testing Concurrent Readers / Writers ===" << std::endl;
+
+    // 值的两半总是相同 读到不同说明读到了写了一半的数据
+    ConcurrentUnorderedMap<std::uint64_t, Pair64> m(16);
+    const std::uint64_t keys = 20000;
+    std::atomic<bool> done(false);
+    std::atomic<std::uint64_t> bad(0), hits(0);
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 2; ++w) {
+        threads.emplace_back([&, w]() {
+            // 写者各自负责一半键 反复插入/改写/删除 表会不断扩容
+            for (std::uint64_t round = 1; round <= 3; ++round) {
+                for (std::uint64_t k = w; k < keys; k += 2)
+                    m.insert_or_assign(k, Pair64{k * round, k * round});
+                for (std::uint64_t k = w; k < keys; k += 6)
+                    m.erase(k);
+            }
+        });
+    }
+    for (int r = 0; r < 3; ++r) {
+        threads.emplace_back([&]() {
+            std::uint64_t k = 0;
+            while (!done.load()) {
+                if (auto v = m.find(k)) {
+                    if (v->a != v->b || v->a % (k ? k : 1) != 0)
+                        bad.fetch_add(1);
+                    hits.fetch_add(1);
+                }
+                k = (k + 7) % keys;
+            }
+        });
+    }
+    threads[0].join();
+    threads[1].join();
+    done.store(true);
+    for (std::size_t i = 2; i < threads.size(); ++i)
+        threads[i].join();
+
+    assert(bad.load() == 0);
+    for (std::uint64_t k = 0; k < keys; ++k) {
+        auto v = m.find(k);
+        if (k % 6 == 0 || k % 6 == 1)
+            assert(!v);
+        else
+            assert(v && v->a == k * 3 && v->b == k * 3);
+    }
+    std::cout << "PASS: " << hits.load() << " concurrent hits, no torn reads" << std::endl;
+
+    // 非平凡类型在共享锁下并发
+    ConcurrentUnorderedMap<std::string, int> s(8);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < 2000; ++i) {
+                s.insert_or_assign("k" + std::to_string(t * 10000 + i), i);
+                s.contains("k" + std::to_string(i));
+                s.visit("k" + std::to_string(t * 10000), [](std::pair<const std::string, int>& kv) { ++kv.second; });
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    assert(s.size() == 8000 && *s.find("k10000") == 2000);
+    std::cout << "PASS: Concurrent std::string map" << std::endl;
+}
+
+// =========================================================
+// 4. 增删交替 内存有界
+// =========================================================
+struct ChurnTag;
+
+void test_churn() {
+    std::cout << "\n=== 4. Testing Insert / Erase Churn ===" << std::endl;
+
+    using ChurnAlloc = InstrumentedAllocator<HashNode<int, int>, ChurnTag>;
+    AllocStats& stats = alloc_stats<ChurnTag>();
+    {
+        // 单分片 存活元素保持 100 个 每次随机删掉一个再插入一个新 key
+        // 删除留下的墓碑反复触发原容量重建
+        ConcurrentUnorderedMap<int, int, std::hash<int>, std::equal_to<int>, ChurnAlloc> m(1);
+        std::mt19937 rng(42);
+        std::vector<int> keys(100);
+        int next = 0;
+        for (int& k : keys) {
+            k = next++;
+            m.insert_or_assign(k, k);
+        }
+        auto churn = [&](int rounds, std::size_t limit) {
+            for (int i = 0; i < rounds; ++i) {
+                int& k = keys[rng() % keys.size()];
+                assert(m.erase(k) == 1);
+                k = next++;
+                m.insert_or_assign(k, k);
+                assert(stats.live_bytes.load() <= limit);
+            }
+        };
+
+        // 先让容量稳定下来 (期间可能翻倍一次) 再以 reclaim() 后的占用为基准
+        churn(10000, SIZE_MAX);
+        m.reclaim();
+        const std::size_t baseline = stats.live_bytes.load();
+        churn(1000000, 2 * baseline);
+        assert(m.size() == 100 && *m.find(keys[0]) == keys[0]);
+        std::cout << "PASS: Live bytes stay within 2x of reclaimed size without reclaim()" << std::endl;
+    }
+    assert(stats.live_bytes.load() == 0);
+    std::cout << "PASS: All tables released" << std::endl;
+}
+
+// =========================================================
+// 5. 扩容时抛异常
+// =========================================================
+
+// 再成功调用 calls_left 次后 下一次抛异常 (-1 表示不抛)
+static int calls_left = -1;
+
+static void countdown() {
+    if (calls_left == 0)
+        throw std::runtime_error("countdown");
+    if (calls_left > 0)
+        --calls_left;
+}
+
+struct ThrowingHash
+{
+    template<typename K>
+    std::size_t operator()(const K& key) const { countdown(); return std::hash<K>()(key); }
+};
+
+// 只能拷贝 (没有移动构造) 扩容时走拷贝
+struct CopyOnly
+{
+    std::string value;
+    CopyOnly(const std::string& v = "") : value(v) {}
+    CopyOnly(const CopyOnly& other) : value(other.value) { countdown(); }
+    CopyOnly& operator=(const CopyOnly&) = default;
+    bool operator==(const CopyOnly& other) const { return value == other.value; }
+};
+
+struct GrowTag;
+
+// 单分片 插满 14 个 (16 槽位的装载上限) 第 15 个触发扩容 扩容中途抛异常
+template<typename Map, typename MakeKey, typename MakeValue>
+void check_grow_throw(MakeKey make_key, MakeValue make_value, const char* msg) {
+    {
+        Map m(1);
+        for (int i = 0; i < 14; ++i)
+            m.insert_or_assign(make_key(i), make_value(i));
+        calls_left = 5;
+        bool thrown = false;
+        try { m.insert_or_assign(make_key(14), make_value(14)); } catch (const std::runtime_error&) { thrown = true; }
+        calls_left = -1;
+        assert(thrown && m.size() == 14 && !m.contains(make_key(14)));
+        for (int i = 0; i < 14; ++i)
+            assert(*m.find(make_key(i)) == make_value(i));
+        for (int i = 14; i < 100; ++i)
+            m.insert_or_assign(make_key(i), make_value(i));
+        assert(m.size() == 100 && *m.find(make_key(99)) == make_value(99));
+    }
+    assert(alloc_stats<GrowTag>().live_bytes.load() == 0);
+    std::cout << "PASS: " << msg << std::endl;
+}
+
+void test_grow_exception_safety() {
+    std::cout << "\n=== 5. Testing Exceptions During Growth ===" << std::endl;
+
+    using IntMap = ConcurrentUnorderedMap<int, int, ThrowingHash, std::equal_to<int>,
+                                          InstrumentedAllocator<HashNode<int, int>, GrowTag>>;
+    check_grow_throw<IntMap>([](int i) { return i; }, [](int i) { return -i; }, "Hash throws (optimistic reads)");
+
+    using StringMap = ConcurrentUnorderedMap<std::string, std::string, ThrowingHash, std::equal_to<std::string>,
+                                             InstrumentedAllocator<HashNode<std::string, std::string>, GrowTag>>;
+    auto key = [](int i) { return "key_" + std::to_string(i); };
+    check_grow_throw<StringMap>(key, key, "Hash throws (locked reads)");
+
+    using CopyMap = ConcurrentUnorderedMap<std::string, CopyOnly, std::hash<std::string>, std::equal_to<std::string>,
+                                           InstrumentedAllocator<HashNode<std::string, CopyOnly>, GrowTag>>;
+    check_grow_throw<CopyMap>(key, [](int i) { return CopyOnly(std::to_string(i)); }, "Copy throws (copy-only value)");
+
+    // 墓碑触发的原容量就地重建
+    {
+        ConcurrentUnorderedMap<int, int, ThrowingHash, std::equal_to<int>,
+                               InstrumentedAllocator<HashNode<int, int>, GrowTag>> m(1);
+        std::mt19937 rng(7);
+        std::vector<int> keys(100);
+        int next = 0;
+        for (int& k : keys) {
+            k = next++;
+            m.insert_or_assign(k, k);
+        }
+        int failures = 0;
+        for (int round = 0; round < 20000; ++round) {
+            int& k = keys[rng() % keys.size()];
+            m.erase(k);
+            int fresh = next++;
+            calls_left = 2;
+            try {
+                m.insert_or_assign(fresh, fresh);
+                k = fresh;
+            }
+            catch (const std::runtime_error&) {
+                ++failures;
+                calls_left = -1;
+                m.insert_or_assign(k, k);
+            }
+            calls_left = -1;
+            assert(m.size() == 100);
+        }
+        assert(failures > 0);
+        for (int k : keys)
+            assert(*m.find(k) == k);
+    }
+    assert(alloc_stats<GrowTag>().live_bytes.load() == 0);
+    std::cout << "PASS: Hash throws (in-place rebuild)" << std::endl;
+}
+
+int main() {
+    try {
+        test_basic();
+        test_locked_reads();
+        test_concurrent();
+        test_churn();
+        test_grow_exception_safety();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
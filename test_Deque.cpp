@@ -0,0 +1,295 @@
+#include "Deque/Deque.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <deque>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+
+// =========================================================
+// 辅助工具
+// =========================================================
+
+// 与 std::deque 逐项对比 (下标 / 正反向迭代 / 迭代器算术)
+template<typename D, typename Ref>
+void check_deque(const D& d, const Ref& ref, const std::string& msg) {
+    if (d.size() != ref.size()) {
+        std::cerr << "FAIL: " << msg << " - Size mismatch! Expected " << ref.size() << ", got " << d.size() << std::endl;
+        exit(1);
+    }
+    for (size_t i = 0; i < ref.size(); ++i) {
+        if (!(d[i] == ref[i])) {
+            std::cerr << "FAIL: " << msg << " - Content mismatch at index " << i << std::endl;
+            exit(1);
+        }
+    }
+    if (!std::equal(d.begin(), d.end(), ref.begin()) || !std::equal(ref.rbegin(), ref.rend(),
+            std::reverse_iterator<typename D::const_iterator>(d.end()))) {
+        std::cerr << "FAIL: " << msg << " - Iteration mismatch" << std::endl;
+        exit(1);
+    }
+    if (d.end() - d.begin() != static_cast<std::ptrdiff_t>(ref.size())) {
+        std::cerr << "FAIL: " << msg << " - Iterator distance mismatch" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASS: " << msg << std::endl;
+}
+
+// 记录申请 / 释放次数的分配器 (经 rebind 同时用于块和 map)
+static int live_blocks = 0;
+
+template<typename T>
+struct CountingAllocator : Allocator<T>
+{
+    template<class U>
+    struct rebind { using other = CountingAllocator<U>; };
+
+    CountingAllocator() = default;
+    template<class U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        ++live_blocks;
+        return Allocator<T>::allocate(n);
+    }
+    void deallocate(T* p, size_t n)
+    {
+        --live_blocks;
+        Allocator<T>::deallocate(p, n);
+    }
+};
+
+// =========================================================
+// 1. 头尾插入 / 删除
+// =========================================================
+void test_push_pop() {
+    std::cout << "\n=== 1. Testing Push / Pop at Both Ends ===" << std::endl;
+
+    Deque<int> d;
+    std::deque<int> ref;
+    assert(d.empty() && d.begin() == d.end() && d.size() == 0);
+    for (int i = 0; i < 5000; ++i) {
+        d.push_back(i);
+        ref.push_back(i);
+        d.push_front(-i);
+        ref.push_front(-i);
+    }
+    check_deque(d, ref, "push_back / push_front across many blocks");
+
+    for (int i = 0; i < 3000; ++i) {
+        d.pop_front();
+        ref.pop_front();
+        d.pop_back();
+        ref.pop_back();
+    }
+    check_deque(d, ref, "pop_front / pop_back");
+
+    // 只从头部插入 (第一个元素也由 push_front 放入)
+    Deque<int> f;
+    std::deque<int> fref;
+    for (int i = 0; i < 3000; ++i) {
+        f.emplace_front(i);
+        fref.emplace_front(i);
+    }
+    check_deque(f, fref, "emplace_front only");
+
+    // 当队列用: 尾进头出 长期运行 map 不会无限增长
+    Deque<int> q;
+    std::deque<int> qref;
+    for (int i = 0; i < 200000; ++i) {
+        q.push_back(i);
+        qref.push_back(i);
+        if (i % 3 != 0) {
+            q.pop_front();
+            qref.pop_front();
+        }
+    }
+    check_deque(q, qref, "FIFO usage");
+    while (!q.empty()) {
+        assert(q.front() == qref.front());
+        q.pop_front();
+        qref.pop_front();
+    }
+    assert(q.begin() == q.end());
+    std::cout << "PASS: Drain to empty" << std::endl;
+}
+
+// =========================================================
+// 2. 引用稳定性
+// =========================================================
+void test_stable_references() {
+    std::cout << "\n=== 2. Testing Reference Stability ===" << std::endl;
+
+    Deque<std::string> d;
+    d.push_back("anchor");
+    std::string* anchor = &d.front();
+    std::vector<std::string*> ptrs;
+    for (int i = 0; i < 20000; ++i) {
+        d.push_back(std::to_string(i));
+        d.push_front(std::to_string(-i));
+        if (i % 1000 == 0)
+            ptrs.push_back(&d.back());
+    }
+    assert(*anchor == "anchor");
+    for (size_t k = 0; k < ptrs.size(); ++k)
+        assert(*ptrs[k] == std::to_string(k * 1000));
+    // 删除另一端不影响
+    for (int i = 0; i < 15000; ++i)
+        d.pop_front();
+    assert(*anchor == "anchor" && *ptrs.back() == "19000");
+    std::cout << "PASS: References survive growth at both ends" << std::endl;
+
+    // 引用自身元素插入 (可能触发新块 / 换 map)
+    Deque<std::string> s;
+    for (int i = 0; i < 1000; ++i)
+        s.push_back(s.empty() ? std::string("x") : s.front());
+    for (int i = 0; i < 1000; ++i)
+        s.push_front(s.back());
+    assert(s.size() == 2000 && s.front() == "x" && s.back() == "x");
+    std::cout << "PASS: push with reference to own element" << std::endl;
+}
+
+// =========================================================
+// 3. 随机访问迭代器
+// =========================================================
+void test_iterators() {
+    std::cout << "\n=== 3. Testing Random-Access Iterators ===" << std::endl;
+
+    Deque<int> d;
+    for (int i = 0; i < 10000; ++i)
+        d.push_back(i);
+    for (int i = 1; i <= 3000; ++i)
+        d.push_front(-i);
+
+    auto it = d.begin();
+    it += 5000;
+    assert(*it == 2000 && it - d.begin() == 5000);
+    it -= 4500;
+    assert(*it == -2500);
+    assert(*(d.end() - 1) == 9999 && d.end()[-2] == 9998 && d.begin()[2999] == -1);
+    assert(d.begin() < it && it <= it && d.end() > it && it >= d.begin());
+    auto c = d.cbegin();
+    c = it;
+    assert(c == it);
+    std::cout << "PASS: Arithmetic / comparison across blocks" << std::endl;
+
+    // 标准算法
+    std::reverse(d.begin(), d.end());
+    assert(d.front() == 9999 && d.back() == -3000);
+    std::sort(d.begin(), d.end());
+    assert(std::is_sorted(d.begin(), d.end()) && d.front() == -3000);
+    assert(*std::lower_bound(d.begin(), d.end(), 42) == 42);
+    std::cout << "PASS: std::reverse / std::sort / std::lower_bound" << std::endl;
+
+    bool thrown = false;
+    try { d.at(d.size()); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown && d.at(3000) == 0);
+    std::cout << "PASS: at() bounds check" << std::endl;
+}
+
+// =========================================================
+// 4. 中间插入 / 删除 拷贝 / 移动 / resize
+// =========================================================
+void test_modifiers() {
+    std::cout << "\n=== 4. Testing insert / erase / copy / resize ===" << std::endl;
+
+    Deque<std::string> d;
+    std::deque<std::string> ref;
+    for (int i = 0; i < 3000; ++i) {
+        d.push_back(std::to_string(i));
+        ref.push_back(std::to_string(i));
+    }
+    for (size_t pos : {size_t(0), size_t(1), size_t(10), size_t(1500), size_t(2990), size_t(3003)}) {
+        d.insert(d.begin() + pos, "ins" + std::to_string(pos));
+        ref.insert(ref.begin() + pos, "ins" + std::to_string(pos));
+    }
+    // 参数引用自身元素
+    d.insert(d.begin() + 5, d[2000]);
+    ref.insert(ref.begin() + 5, ref[2000]);
+    d.emplace(d.begin() + 2500, 3, 'z');
+    ref.emplace(ref.begin() + 2500, 3, 'z');
+    check_deque(d, ref, "insert / emplace at various positions");
+
+    for (size_t pos : {size_t(0), size_t(7), size_t(1400), size_t(2900), size_t(3000)}) {
+        auto it = d.erase(d.begin() + pos);
+        auto rit = ref.erase(ref.begin() + pos);
+        assert((it == d.end()) == (rit == ref.end()));
+        if (it != d.end())
+            assert(*it == *rit);
+    }
+    check_deque(d, ref, "erase at various positions");
+
+    Deque<std::string> copy(d);
+    check_deque(copy, ref, "Copy constructor");
+    Deque<std::string> moved(std::move(copy));
+    assert(copy.empty() && copy.begin() == copy.end());
+    check_deque(moved, ref, "Move constructor");
+    copy = moved;
+    moved = Deque<std::string>{"a", "b"};
+    check_deque(copy, ref, "Copy assignment");
+    check_deque(moved, std::deque<std::string>{"a", "b"}, "Move assignment from temporary");
+
+    Deque<int> r(5, 7);
+    r.resize(10);
+    r.resize(3);
+    r.resize(6, 1);
+    check_deque(r, std::deque<int>{7, 7, 7, 1, 1, 1}, "resize");
+    r.clear();
+    assert(r.empty());
+    r.push_front(1);
+    check_deque(r, std::deque<int>{1}, "Reuse after clear");
+}
+
+// =========================================================
+// 5. 分配器 rebind / 块回收
+// =========================================================
+void test_allocator() {
+    std::cout << "\n=== 5. Testing Allocator Rebind / Block Reuse ===" << std::endl;
+    {
+        Deque<std::uint64_t, CountingAllocator<std::uint64_t>> d;
+        const size_t bs = Deque<std::uint64_t>::block_size;
+        for (size_t i = 0; i < bs * 10; ++i)
+            d.push_back(i);
+        // 10 个满块 + finish 所在的空块 + map
+        assert(live_blocks == 12);
+
+        // 在块边界上反复 push / pop 只用缓存块 不再申请
+        int before = live_blocks;
+        for (int i = 0; i < 1000; ++i) {
+            d.pop_back();
+            d.push_back(1);
+        }
+        assert(live_blocks == before);
+        d.clear();
+        d.shrink_to_fit();
+        // 只剩首块 + map
+        assert(live_blocks == 2);
+    }
+    assert(live_blocks == 0);
+    std::cout << "PASS: Blocks and map allocated via rebind, all released" << std::endl;
+}
+
+int main() {
+    try {
+        test_push_pop();
+        test_stable_references();
+        test_iterators();
+        test_modifiers();
+        test_allocator();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include "MappedVector/MappedVector.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <unistd.h>
+
+// =========================================================
+// 辅助工具
+// =========================================================
+static std::string temp_path(const char* name) {
+    return std::string("/tmp/yxy_mapped_") + name + "_" + std::to_string(::getpid()) + ".bin";
+}
+
+static long file_size(const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return -1;
+    std::fseek(f, 0, SEEK_END);
+    long n = std::ftell(f);
+    std::fclose(f);
+    return n;
+}
+
+struct Point {
+    int x;
+    int y;
+    double w;
+    Point() : x(0), y(0), w(0) {}
+    Point(int x_, int y_, double w_) : x(x_), y(y_), w(w_) {}
+};
+
+// =========================================================
+// 1. 基本操作与扩容
+// =========================================================
+void test_basic() {
+    std::cout << "\n=== 1. Testing Basic Operations ===" << std::endl;
+    std::string path = temp_path("basic");
+
+    MappedVector<int> v(path, MapMode::Truncate);
+    assert(v.is_open() && v.empty() && v.capacity() == 0);
+    for (int i = 0; i < 100000; ++i)
+        v.push_back(i);
+    assert(v.size() == 100000 && v.capacity() >= 100000);
+    for (int i = 0; i < 100000; ++i)
+        assert(v[i] == i);
+    assert(v.front() == 0 && v.back() == 99999);
+    std::cout << "PASS: push_back grows file and mapping" << std::endl;
+
+    v.pop_back();
+    v.emplace_back(-1);
+    assert(v.back() == -1 && v.size() == 100000);
+    v.resize(10);
+    assert(v.size() == 10 && v[9] == 9);
+    v.resize(20, 7);
+    assert(v.size() == 20 && v[10] == 7 && v[19] == 7);
+    v.resize(25);
+    assert(v[24] == 0);
+    std::cout << "PASS: pop_back / emplace_back / resize" << std::endl;
+
+    // 源区间在自身内部 扩容后仍要读到正确数据
+    v.shrink_to_fit();
+    assert(v.capacity() == 25);
+    v.append(v.data(), 25);
+    assert(v.size() == 50);
+    for (int i = 0; i < 25; ++i)
+        assert(v[i] == v[i + 25]);
+    v.push_back(v[0]);
+    assert(v.back() == v[0]);
+    std::cout << "PASS: append / push_back aliasing own elements" << std::endl;
+
+    bool thrown = false;
+    try { v.at(v.size()); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+    std::cout << "PASS: at() bounds check" << std::endl;
+
+    v.reserve(1 << 20);
+    assert(v.capacity() == (1 << 20) && v.size() == 51);
+    v.close();
+    assert(!v.is_open());
+    // close 时截到实际大小
+    assert(file_size(path) == long(MappedVector<int>::header_bytes + 51 * sizeof(int)));
+    std::cout << "PASS: close() truncates unused capacity" << std::endl;
+    std::remove(path.c_str());
+}
+
+// =========================================================
+// 2. 重新打开 数据持久化
+// =========================================================
+void test_reopen() {
+    std::cout << "\n=== 2. Testing Reopen ===" << std::endl;
+    std::string path = temp_path("reopen");
+    {
+        MappedVector<Point> v(path, MapMode::Truncate);
+        for (int i = 0; i < 5000; ++i)
+            v.emplace_back(i, -i, i * 0.5);
+    }
+    {
+        MappedVector<Point> v(path);
+        assert(v.size() == 5000 && v.capacity() == 5000);
+        for (int i = 0; i < 5000; ++i)
+            assert(v[i].x == i && v[i].y == -i && v[i].w == i * 0.5);
+        v.push_back(Point(1, 2, 3));
+        v.sync();
+    }
+    {
+        MappedVector<Point> v(path, MapMode::ReadOnly);
+        assert(v.read_only() && v.size() == 5001 && v.back().w == 3);
+        bool thrown = false;
+        try { v.push_back(Point()); } catch (const std::logic_error&) { thrown = true; }
+        assert(thrown);
+        long sum = 0;
+        for (const Point& p : v)
+            sum += p.x;
+        assert(sum == 4999L * 5000 / 2 + 1);
+    }
+    std::cout << "PASS: Data survives close / reopen" << std::endl;
+
+    // Truncate 清空已有文件
+    {
+        MappedVector<Point> v(path, MapMode::Truncate);
+        assert(v.empty());
+    }
+    assert(file_size(path) == long(MappedVector<Point>::header_bytes));
+    std::cout << "PASS: Truncate mode" << std::endl;
+    std::remove(path.c_str());
+}
+
+// =========================================================
+// 3. 错误处理
+// =========================================================
+void test_errors() {
+    std::cout << "\n=== 3. Testing Error Handling ===" << std::endl;
+    std::string path = temp_path("errors");
+
+    bool thrown = false;
+    try { MappedVector<int> v(path, MapMode::ReadOnly); } catch (const std::system_error&) { thrown = true; }
+    assert(thrown);
+    std::cout << "PASS: ReadOnly on missing file" << std::endl;
+
+    {
+        MappedVector<std::int64_t> v(path, MapMode::Truncate);
+        v.push_back(1);
+    }
+    thrown = false;
+    try { MappedVector<std::int32_t> v(path); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+    // 打开失败不改动文件
+    assert(file_size(path) == long(MappedVector<std::int64_t>::header_bytes + sizeof(std::int64_t)));
+    std::cout << "PASS: Element size mismatch" << std::endl;
+
+    FILE* f = std::fopen(path.c_str(), "wb");
+    for (int i = 0; i < 5000; ++i)
+        std::fputc('x', f);
+    std::fclose(f);
+    thrown = false;
+    try { MappedVector<char> v(path); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+    std::cout << "PASS: Bad magic" << std::endl;
+
+    MappedVector<int> closed;
+    thrown = false;
+    try { closed.push_back(1); } catch (const std::logic_error&) { thrown = true; }
+    assert(thrown && !closed.advise(MapAdvice::Sequential));
+    std::cout << "PASS: Operations on closed vector" << std::endl;
+
+    // 字节数溢出 size_t 的容量 (以前会回绕成很小的文件长度)
+    {
+        MappedVector<std::int64_t> v(path, MapMode::Truncate);
+        v.push_back(7);
+        const std::size_t huge = SIZE_MAX / sizeof(std::int64_t) + 1;
+        std::size_t cap = v.capacity();
+        int errors = 0;
+        try { v.reserve(huge); } catch (const std::length_error&) { ++errors; }
+        try { v.resize(SIZE_MAX); } catch (const std::length_error&) { ++errors; }
+        try { v.reserve(MappedVector<std::int64_t>::max_size() + 1); } catch (const std::length_error&) { ++errors; }
+        try { v.append(v.data(), MappedVector<std::int64_t>::max_size()); } catch (const std::length_error&) { ++errors; }
+        assert(errors == 4 && v.size() == 1 && v.capacity() == cap && v[0] == 7);
+    }
+    std::cout << "PASS: Oversized capacity throws std::length_error" << std::endl;
+    std::remove(path.c_str());
+}
+
+// =========================================================
+// 4. 移动与 madvise
+// =========================================================
+void test_move_advise() {
+    std::cout << "\n=== 4. Testing Move / Advise ===" << std::endl;
+    std::string path = temp_path("move");
+
+    MappedVector<double> a(path, MapMode::Truncate);
+    for (int i = 0; i < 1000; ++i)
+        a.push_back(i);
+    MappedVector<double> b(std::move(a));
+    assert(!a.is_open() && b.size() == 1000);
+    MappedVector<double> c;
+    c = std::move(b);
+    assert(!b.is_open() && c.size() == 1000 && c[999] == 999);
+    std::cout << "PASS: Move construct / assign" << std::endl;
+
+    assert(c.advise(MapAdvice::Sequential));
+    assert(c.advise(MapAdvice::WillNeed));
+    assert(c.advise(MapAdvice::Random));
+    assert(c.advise(MapAdvice::Normal));
+    c.advise(MapAdvice::HugePage);      // 依赖文件系统 只要求不出错
+    assert(c[500] == 500);
+    std::cout << "PASS: madvise hints" << std::endl;
+    c.close();
+    std::remove(path.c_str());
+}
+
+int main() {
+    try {
+        test_basic();
+        test_reopen();
+        test_errors();
+        test_move_advise();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include "MpmcQueue/MpmcQueue.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+// =========================================================
+// 1. 单线程: 槽位序号
+// =========================================================
+void test_sequence() {
+    std::cout << "\n=== 1. Testing Cell Sequence Numbers ===" << std::endl;
+
+    MpmcQueue<int> q(6);
+    assert(q.capacity() == 8);
+    // 每圈写满再读空 槽位序号每圈前进 capacity 满 / 空都要靠序号判断
+    int out = 0;
+    for (int lap = 0; lap < 100; ++lap) {
+        for (int i = 0; i < 8; ++i)
+            assert(q.try_push(lap * 8 + i));
+        assert(!q.try_push(-1));
+        for (int i = 0; i < 8; ++i)
+            assert(q.try_pop(out) && out == lap * 8 + i);
+        assert(!q.try_pop(out) && q.empty_approx());
+    }
+    std::cout << "PASS: Full / empty detected on every lap" << std::endl;
+
+    // claim 只抢到连续可用的那一段
+    int src[10], buf[16];
+    for (int i = 0; i < 10; ++i)
+        src[i] = i;
+    assert(q.push_n(src, 10) == 8 && q.push_n(src, 10) == 0);
+    assert(q.pop_n(buf, 3) == 3 && buf[2] == 2);
+    assert(q.push_n(src, 10) == 3);
+    assert(q.pop_n(buf, 16) == 8);
+    for (int i = 0; i < 5; ++i)
+        assert(buf[i] == 3 + i);
+    for (int i = 0; i < 3; ++i)
+        assert(buf[5 + i] == i);
+    std::cout << "PASS: push_n / pop_n claim partial ranges" << std::endl;
+
+    bool thrown = false;
+    try { MpmcQueue<char> huge(~std::size_t(0)); } catch (const std::length_error&) { thrown = true; }
+    assert(thrown);
+    std::cout << "PASS: Oversized capacity throws std::length_error" << std::endl;
+}
+
+// =========================================================
+// 2. 非平凡类型
+// =========================================================
+void test_non_trivial() {
+    std::cout << "\n=== 2. Testing Non-trivial Types ===" << std::endl;
+
+    MpmcQueue<std::string> q(4);
+    std::string s = "moved";
+    assert(q.try_push(std::move(s)) && s.empty());
+    std::string kept = "kept";
+    assert(q.try_push(kept) && kept == "kept");
+    assert(q.try_emplace(3, 'x'));
+    std::string batch[2] = {"b0", "b1"};
+    assert(q.push_n(batch, 2) == 1);
+    std::string out[4];
+    assert(q.pop_n(out, 4) == 4);
+    assert(out[0] == "moved" && out[1] == "kept" && out[2] == "xxx" && out[3] == "b0");
+    std::cout << "PASS: std::string push / emplace / batches" << std::endl;
+
+    // 每个元素持有 token 的一份引用 析构后只剩 token 自己
+    auto token = std::make_shared<int>(0);
+    {
+        MpmcQueue<std::shared_ptr<int>> t(16);
+        for (int i = 0; i < 10; ++i)
+            t.try_push(token);
+        std::shared_ptr<int> sink;
+        for (int i = 0; i < 4; ++i)
+            t.try_pop(sink);
+        assert(token.use_count() == 1 + 6 + 1);
+    }
+    assert(token.use_count() == 1);
+    std::cout << "PASS: Remaining elements destroyed" << std::endl;
+}
+
+// =========================================================
+// 3. 多生产者 多消费者
+// =========================================================
+void test_many_threads() {
+    std::cout << "\n=== 3. Testing Multiple Producers / Consumers ===" << std::endl;
+    const int producers = 4, consumers = 4;
+    const std::uint64_t per_producer = 200000;
+
+    for (bool batched : {false, true}) {
+        MpmcQueue<std::uint64_t> q(256);
+        std::atomic<std::uint64_t> consumed{0};
+        // 每个消费者记录各生产者的上一个序号 同一生产者的元素必须按序出现
+        std::vector<std::vector<std::uint64_t>> sums(consumers, std::vector<std::uint64_t>(producers, 0));
+        std::vector<std::thread> threads;
+
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p]() {
+                std::uint64_t next = 0;
+                std::uint64_t buf[16];
+                while (next < per_producer) {
+                    // 高 16 位是生产者编号
+                    if (batched) {
+                        std::uint64_t k = per_producer - next < 16 ? per_producer - next : 16;
+                        for (std::uint64_t i = 0; i < k; ++i)
+                            buf[i] = (std::uint64_t(p) << 48) | (next + i);
+                        next += q.push_n(buf, k);
+                    }
+                    else if (q.try_push((std::uint64_t(p) << 48) | next))
+                        ++next;
+                }
+            });
+        }
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, c]() {
+                std::vector<std::int64_t> last(producers, -1);
+                std::uint64_t buf[16];
+                while (consumed.load() < producers * per_producer) {
+                    std::size_t k = batched ? q.pop_n(buf, 16) : (q.try_pop(buf[0]) ? 1 : 0);
+                    for (std::size_t i = 0; i < k; ++i) {
+                        int p = static_cast<int>(buf[i] >> 48);
+                        std::int64_t seq = static_cast<std::int64_t>(buf[i] & ((std::uint64_t(1) << 48) - 1));
+                        assert(seq > last[p]);
+                        last[p] = seq;
+                        sums[c][p] += static_cast<std::uint64_t>(seq);
+                    }
+                    if (k)
+                        consumed.fetch_add(k);
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        assert(consumed.load() == producers * per_producer && q.empty_approx());
+        for (int p = 0; p < producers; ++p) {
+            std::uint64_t total = 0;
+            for (int c = 0; c < consumers; ++c)
+                total += sums[c][p];
+            assert(total == per_producer * (per_producer - 1) / 2);
+        }
+        std::cout << "PASS: " << producers << "x" << consumers << " threads, every item exactly once"
+                  << (batched ? " (batched)" : "") << std::endl;
+    }
+}
+
+int main() {
+    try {
+        test_sequence();
+        test_non_trivial();
+        test_many_threads();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
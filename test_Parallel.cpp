@@ -0,0 +1,218 @@
+#include "parallel_algorithm.h"
+#include "Vector/Vector.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <atomic>
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+
+// =========================================================
+// 辅助工具
+// =========================================================
+static std::uint32_t next_random(std::uint32_t& x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// =========================================================
+// 1. 线程池与任务组
+// =========================================================
+void test_thread_pool() {
+    std::cout << "\n=== 1. Testing ThreadPool / TaskGroup ===" << std::endl;
+
+    for (size_t threads : {1, 2, 4}) {
+        ThreadPool pool(threads);
+        assert(pool.thread_count() == threads);
+        std::atomic<int> sum(0);
+        TaskGroup group(pool);
+        for (int i = 1; i <= 1000; ++i)
+            group.run([&sum, i]() { sum += i; });
+        group.wait();
+        assert(sum == 500500);
+    }
+    std::cout << "PASS: 1000 tasks on 1 / 2 / 4 threads" << std::endl;
+
+    // 任务内嵌套 fork/join 等待的线程帮忙执行 不会死锁
+    ThreadPool pool(3);
+    std::atomic<int> leaves(0);
+    TaskGroup outer(pool);
+    for (int i = 0; i < 8; ++i) {
+        outer.run([&]() {
+            TaskGroup inner(pool);
+            for (int j = 0; j < 8; ++j)
+                inner.run([&]() { ++leaves; });
+            inner.wait();
+        });
+    }
+    outer.wait();
+    assert(leaves == 64);
+    std::cout << "PASS: Nested task groups" << std::endl;
+
+    TaskGroup failing(pool);
+    std::atomic<int> done(0);
+    for (int i = 0; i < 10; ++i)
+        failing.run([&, i]() {
+            if (i == 3)
+                throw std::runtime_error("task failed");
+            ++done;
+        });
+    bool caught = false;
+    try {
+        failing.wait();
+    }
+    catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught && done == 9);
+    std::cout << "PASS: Exception rethrown by wait" << std::endl;
+}
+
+// =========================================================
+// 2. parallel_for / parallel_transform
+// =========================================================
+void test_for_transform() {
+    std::cout << "\n=== 2. Testing parallel_for / parallel_transform ===" << std::endl;
+
+    ThreadPool pool(4);
+    Vector<int> v;
+    for (int i = 0; i < 100000; ++i)
+        v.push_back(i);
+
+    parallel_for(pool, v.begin(), v.end(), [](int& x) { x *= 2; }, 1000);
+    for (int i = 0; i < 100000; ++i)
+        assert(v[i] == 2 * i);
+    std::cout << "PASS: parallel_for over Vector iterators" << std::endl;
+
+    Vector<long long> out;
+    out.resize(v.size());
+    parallel_transform(pool, v.data(), v.data() + v.size(), out.data(), [](int x) { return (long long)x * x; });
+    for (int i = 0; i < 100000; ++i)
+        assert(out[i] == 4LL * i * i);
+    parallel_transform(pool, v.begin(), v.end(), v.begin(), [](int x) { return x + 1; }, 7);
+    assert(v[0] == 1 && v[99999] == 199999);
+    std::cout << "PASS: parallel_transform (out-of-place / in-place)" << std::endl;
+
+    std::atomic<size_t> covered(0);
+    parallel_for_range(pool, 10, 5010, [&](size_t lo, size_t hi) {
+        assert(lo >= 10 && hi <= 5010 && lo < hi);
+        covered += hi - lo;
+    }, 64);
+    assert(covered == 5000);
+    parallel_for_range(pool, 5, 5, [](size_t, size_t) { assert(false); });
+    std::cout << "PASS: parallel_for_range" << std::endl;
+}
+
+// =========================================================
+// 3. parallel_reduce / parallel_inclusive_scan
+// =========================================================
+void test_reduce_scan() {
+    std::cout << "\n=== 3. Testing parallel_reduce / parallel_inclusive_scan ===" << std::endl;
+
+    ThreadPool pool(4);
+    Vector<std::uint64_t> v;
+    for (std::uint64_t i = 1; i <= 1000000; ++i)
+        v.push_back(i);
+    assert(parallel_reduce(pool, v.begin(), v.end(), std::uint64_t(0)) == 500000500000ull);
+    assert(parallel_reduce(pool, v.begin(), v.begin(), std::uint64_t(7)) == 7);
+    auto mx = parallel_reduce(pool, v.begin(), v.end(), std::uint64_t(0),
+                              [](std::uint64_t a, std::uint64_t b) { return a > b ? a : b; }, 333);
+    assert(mx == 1000000);
+
+    // 只满足结合律 不满足交换律的 op: 结果必须保持顺序
+    Vector<std::string> letters;
+    for (int i = 0; i < 2000; ++i)
+        letters.push_back(std::string(1, 'a' + i % 26));
+    std::string joined = parallel_reduce(pool, letters.begin(), letters.end(), std::string(">"), std::plus<>(), 37);
+    std::string expect = ">";
+    for (auto& s : letters)
+        expect += s;
+    assert(joined == expect);
+    std::cout << "PASS: parallel_reduce (sum / max / ordered concat)" << std::endl;
+
+    for (size_t grain : {0, 1, 7, 1000, 5000000}) {
+        Vector<std::uint64_t> out;
+        out.resize(v.size());
+        parallel_inclusive_scan(pool, v.begin(), v.end(), out.begin(), std::plus<>(), grain);
+        for (std::uint64_t i = 1; i <= 1000000; i += 997)
+            assert(out[i - 1] == i * (i + 1) / 2);
+        assert(out[999999] == 500000500000ull);
+    }
+    Vector<int> inplace;
+    for (int i = 0; i < 10001; ++i)
+        inplace.push_back(1);
+    parallel_inclusive_scan(pool, inplace.begin(), inplace.end(), inplace.begin(), std::plus<>(), 100);
+    for (int i = 0; i < 10001; ++i)
+        assert(inplace[i] == i + 1);
+
+    Vector<std::string> scanned;
+    scanned.resize(letters.size());
+    parallel_inclusive_scan(pool, letters.begin(), letters.end(), scanned.begin(), std::plus<>(), 64);
+    assert(scanned[1999] == expect.substr(1) && scanned[25] == expect.substr(1, 26));
+    std::cout << "PASS: parallel_inclusive_scan (grains / in-place / strings)" << std::endl;
+}
+
+// =========================================================
+// 4. parallel_sort
+// =========================================================
+void test_sort() {
+    std::cout << "\n=== 4. Testing parallel_sort ===" << std::endl;
+
+    std::uint32_t x = 2463534242u;
+    for (size_t threads : {1, 2, 3, 4}) {
+        ThreadPool pool(threads);
+        for (size_t n : {0, 1, 1000, 4097, 300000}) {
+            Vector<int> v;
+            for (size_t i = 0; i < n; ++i)
+                v.push_back(static_cast<int>(next_random(x) % 1000));   // 大量重复
+            Vector<int> expect = v;
+            std::sort(expect.begin(), expect.end());
+            parallel_sort(pool, v.begin(), v.end(), std::less<>(), 512);
+            assert(std::equal(v.begin(), v.end(), expect.begin(), expect.end()));
+        }
+    }
+    std::cout << "PASS: int sort, 1-4 threads, with duplicates" << std::endl;
+
+    ThreadPool pool(4);
+    Vector<std::string> s;
+    for (int i = 0; i < 50000; ++i)
+        s.push_back("item_" + std::to_string(next_random(x) % 100000));
+    Vector<std::string> expect = s;
+    std::sort(expect.begin(), expect.end(), std::greater<>());
+    parallel_sort(pool, s.begin(), s.end(), std::greater<>(), 1000);
+    assert(std::equal(s.begin(), s.end(), expect.begin(), expect.end()));
+    std::cout << "PASS: std::string sort with custom comparator" << std::endl;
+
+    Vector<double> d;
+    for (int i = 0; i < 200000; ++i)
+        d.push_back(200000 - i);
+    parallel_sort(d.begin(), d.end());
+    assert(std::is_sorted(d.begin(), d.end()) && d[0] == 1);
+    std::cout << "PASS: Global pool and default grain" << std::endl;
+}
+
+int main() {
+    try {
+        test_thread_pool();
+        test_for_transform();
+        test_reduce_scan();
+        test_sort();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include "simd_algorithm.h"
+#include "Vector/Vector.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+// =========================================================
+// 辅助工具
+// =========================================================
+static const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2};
+
+static const char* level_name(SimdLevel l) {
+    return l == SimdLevel::AVX2 ? "AVX2" : l == SimdLevel::SSE2 ? "SSE2" : "Scalar";
+}
+
+static std::uint32_t next_random(std::uint32_t& x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// 取值范围小 保证有重复和命中
+template<typename T>
+Vector<T> make_data(size_t n, std::uint32_t seed) {
+    Vector<T> v;
+    for (size_t i = 0; i < n; ++i)
+        v.push_back(static_cast<T>(static_cast<int>(next_random(seed) % 2001) - 1000) / T(4));
+    return v;
+}
+
+// 各种长度 (覆盖尾部处理) 与各种起始偏移 (非对齐读取)
+template<typename F>
+void for_each_case(F f) {
+    for (size_t n : {0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 64, 100, 10007})
+        for (size_t offset : {0, 1, 3})
+            f(n, offset);
+}
+
+// =========================================================
+// 1. find / count
+// =========================================================
+template<typename T>
+void check_find_count() {
+    for_each_case([](size_t n, size_t offset) {
+        Vector<T> v = make_data<T>(n + offset, static_cast<std::uint32_t>(n * 31 + offset + 1));
+        const T* first = v.data() + offset;
+        const T* last = v.data() + v.size();
+        for (T value : {T(0), T(1) / T(4), T(-250), T(12345)}) {
+            assert(simd_find(first, last, value) == std::find(first, last, value));
+            assert(simd_count(first, last, value) == static_cast<size_t>(std::count(first, last, value)));
+        }
+        if (n) {
+            T tail = *(last - 1);
+            assert(simd_find(first, last, tail) == std::find(first, last, tail));
+        }
+    });
+}
+
+void test_find_count() {
+    std::cout << "\n=== 1. Testing find / count ===" << std::endl;
+    for (SimdLevel l : levels) {
+        set_simd_level(l);
+        check_find_count<int>();
+        check_find_count<float>();
+        check_find_count<double>();
+        check_find_count<long long>();      // 不支持的类型走标准库
+        std::cout << "PASS: " << level_name(simd_level()) << std::endl;
+    }
+
+    // 非 const 指针返回非 const 指针
+    Vector<int> v = make_data<int>(100, 7);
+    v[42] = 99999;
+    int* p = simd_find(v.begin(), v.end(), 99999);
+    *p = 5;
+    assert(p == v.begin() + 42 && v[42] == 5);
+    std::cout << "PASS: Mutable pointer result" << std::endl;
+}
+
+// =========================================================
+// 2. min_element / max_element
+// =========================================================
+template<typename T>
+void check_min_max() {
+    for_each_case([](size_t n, size_t offset) {
+        Vector<T> v = make_data<T>(n + offset, static_cast<std::uint32_t>(n * 17 + offset + 3));
+        const T* first = v.data() + offset;
+        const T* last = v.data() + v.size();
+        assert(simd_min_element(first, last) == std::min_element(first, last));
+        assert(simd_max_element(first, last) == std::max_element(first, last));
+    });
+}
+
+void test_min_max() {
+    std::cout << "\n=== 2. Testing min_element / max_element ===" << std::endl;
+    for (SimdLevel l : levels) {
+        set_simd_level(l);
+        check_min_max<int>();
+        check_min_max<float>();
+        check_min_max<double>();
+        std::cout << "PASS: " << level_name(simd_level()) << std::endl;
+    }
+
+    // 极值出现多次时返回第一次出现的位置
+    Vector<int> v;
+    for (int i = 0; i < 1000; ++i)
+        v.push_back(i % 10);
+    assert(simd_min_element(v.begin(), v.end()) == v.begin());
+    assert(simd_max_element(v.begin(), v.end()) == v.begin() + 9);
+    Vector<int> extremes;
+    extremes.push_back(INT32_MAX);
+    for (int i = 0; i < 40; ++i)
+        extremes.push_back(INT32_MIN + i);
+    assert(*simd_min_element(extremes.begin(), extremes.end()) == INT32_MIN);
+    assert(simd_max_element(extremes.begin(), extremes.end()) == extremes.begin());
+    std::cout << "PASS: First occurrence / INT32 limits" << std::endl;
+}
+
+// =========================================================
+// 3. equal
+// =========================================================
+template<typename T>
+void check_equal() {
+    for_each_case([](size_t n, size_t offset) {
+        Vector<T> a = make_data<T>(n, 11);
+        Vector<T> b;
+        for (size_t i = 0; i < offset; ++i)
+            b.push_back(T(0));
+        for (size_t i = 0; i < n; ++i)
+            b.push_back(a[i]);
+        const T* bf = b.data() + offset;
+        assert(simd_equal(a.data(), a.data() + n, bf));
+        for (size_t pos : {size_t(0), n / 2, n ? n - 1 : 0}) {
+            if (!n)
+                break;
+            T saved = b[offset + pos];
+            b[offset + pos] = T(7777);
+            assert(!simd_equal(a.data(), a.data() + n, bf));
+            b[offset + pos] = saved;
+        }
+    });
+}
+
+void test_equal() {
+    std::cout << "\n=== 3. Testing equal ===" << std::endl;
+    for (SimdLevel l : levels) {
+        set_simd_level(l);
+        check_equal<int>();
+        check_equal<float>();
+        check_equal<double>();
+
+        // 按 == 比较而不是按字节: +0 == -0 NaN != NaN
+        Vector<double> z, nz, nan;
+        for (int i = 0; i < 9; ++i) {
+            z.push_back(0.0);
+            nz.push_back(-0.0);
+            nan.push_back(std::nan(""));
+        }
+        assert(simd_equal(z.begin(), z.end(), nz.begin()));
+        assert(!simd_equal(nan.begin(), nan.end(), nan.begin()));
+        std::cout << "PASS: " << level_name(simd_level()) << std::endl;
+    }
+}
+
+// =========================================================
+// 4. sum
+// =========================================================
+void test_sum() {
+    std::cout << "\n=== 4. Testing sum ===" << std::endl;
+    for (SimdLevel l : levels) {
+        set_simd_level(l);
+        for_each_case([](size_t n, size_t offset) {
+            Vector<int> v = make_data<int>(n + offset, 5);
+            long long expect = 0;
+            for (size_t i = offset; i < v.size(); ++i)
+                expect += v[i];
+            assert(simd_sum(v.data() + offset, v.data() + v.size()) == expect);
+
+            Vector<float> f = make_data<float>(n + offset, 9);
+            double fexpect = 0;
+            for (size_t i = offset; i < f.size(); ++i)
+                fexpect += f[i];
+            // 输入都是 0.25 的倍数 累加到 double 没有舍入误差
+            assert(simd_sum(f.data() + offset, f.data() + f.size()) == fexpect);
+
+            Vector<double> d = make_data<double>(n + offset, 13);
+            double dexpect = 0;
+            for (size_t i = offset; i < d.size(); ++i)
+                dexpect += d[i];
+            assert(simd_sum(d.data() + offset, d.data() + d.size()) == dexpect);
+        });
+
+        // int32 累加不会溢出
+        Vector<int> big;
+        for (int i = 0; i < 1000; ++i)
+            big.push_back(i % 2 ? INT32_MAX : INT32_MIN);
+        assert(simd_sum(big.begin(), big.end()) == 500LL * INT32_MAX + 500LL * INT32_MIN);
+        std::cout << "PASS: " << level_name(simd_level()) << std::endl;
+    }
+
+    Vector<unsigned char> bytes;
+    for (int i = 0; i < 300; ++i)
+        bytes.push_back(255);
+    assert(simd_sum(bytes.begin(), bytes.end()) == 300ull * 255);
+    std::cout << "PASS: Fallback for unsupported types" << std::endl;
+    set_simd_level(SimdLevel::AVX2);
+}
+
+int main() {
+    try {
+        std::cout << "Detected SIMD level: " << level_name(simd_detected_level()) << std::endl;
+        test_find_count();
+        test_min_max();
+        test_equal();
+        test_sum();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include "SmallVector/SmallVector.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+
+// =========================================================
+// 辅助工具
+// =========================================================
+
+// 记录堆分配次数的分配器
+static int heap_allocations = 0;
+
+template<typename T>
+struct CountingAllocator : Allocator<T>
+{
+    template<class U>
+    struct rebind { using other = CountingAllocator<U>; };
+
+    CountingAllocator() = default;
+    template<class U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        ++heap_allocations;
+        return Allocator<T>::allocate(n);
+    }
+
+    AllocationResult<T*> allocate_at_least(size_t n)
+    {
+        return {allocate(n), n};
+    }
+};
+
+// allocate_at_least 多给一个元素的分配器 (模拟分配器按块取整)
+template<typename T>
+struct SlackAllocator : Allocator<T>
+{
+    template<class U>
+    struct rebind { using other = SlackAllocator<U>; };
+
+    SlackAllocator() = default;
+    template<class U>
+    SlackAllocator(const SlackAllocator<U>&) noexcept {}
+
+    AllocationResult<T*> allocate_at_least(size_t n)
+    {
+        return {Allocator<T>::allocate(n + 1), n + 1};
+    }
+};
+
+struct GrowthTag {};
+
+template<typename V, typename T>
+void check_vec(const V& v, std::initializer_list<T> expected, const std::string& msg) {
+    if (v.size() != expected.size()) {
+        std::cerr << "FAIL: " << msg << " - Size mismatch! Expected " << expected.size() << ", got " << v.size() << std::endl;
+        exit(1);
+    }
+    size_t i = 0;
+    for (const auto& val : expected) {
+        if (v[i] != val) {
+            std::cerr << "FAIL: " << msg << " - Content mismatch at index " << i << ". Expected " << val << ", got " << v[i] << std::endl;
+            exit(1);
+        }
+        i++;
+    }
+    std::cout << "PASS: " << msg << std::endl;
+}
+
+// =========================================================
+// 1. 内部缓冲区 不申请堆内存
+// =========================================================
+void test_inline() {
+    std::cout << "\n=== 1. Testing Inline Storage ===" << std::endl;
+
+    heap_allocations = 0;
+    SmallVector<int, 8, CountingAllocator<int>> v;
+    for (int i = 0; i < 7; ++i)
+        v.push_back(i);
+    v.insert(v.begin(), 100);
+    v.erase(v.begin());
+    v.emplace(v.begin() + 3, 42);
+    v.erase(v.begin() + 3);
+    v.push_back(7);
+    assert(v.is_inline() && v.capacity() == 8);
+    assert(heap_allocations == 0);
+    check_vec(v, {0, 1, 2, 3, 4, 5, 6, 7}, "8 elements, no heap allocation");
+}
+
+// =========================================================
+// 2. 溢出到堆
+// =========================================================
+void test_spill() {
+    std::cout << "\n=== 2. Testing Spill To Heap ===" << std::endl;
+
+    heap_allocations = 0;
+    SmallVector<int, 4, CountingAllocator<int>> v = {1, 2, 3, 4};
+    assert(v.is_inline());
+    v.push_back(5);
+    assert(!v.is_inline() && heap_allocations == 1 && v.capacity() == 8);
+    check_vec(v, {1, 2, 3, 4, 5}, "Spill on push_back");
+
+    v.insert(v.begin() + 1, 9);
+    v.erase(v.begin() + 2, v.begin() + 4);
+    check_vec(v, {1, 9, 4, 5}, "Insert / erase range on heap");
+
+    bool thrown = false;
+    try { v.at(10); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+    std::cout << "PASS: at() throws" << std::endl;
+}
+
+// =========================================================
+// 3. 复杂对象 + 拷贝/移动
+// =========================================================
+void test_copy_move() {
+    std::cout << "\n=== 3. Testing Copy / Move ===" << std::endl;
+
+    SmallVector<std::string, 2> a = {"a", "b"};
+    SmallVector<std::string, 2> b(a);
+    check_vec(b, {std::string("a"), std::string("b")}, "Copy inline");
+
+    SmallVector<std::string, 2> c(std::move(a));
+    assert(a.empty() && a.is_inline());
+    check_vec(c, {std::string("a"), std::string("b")}, "Move inline");
+
+    c.push_back("c");
+    c.insert(c.begin(), c[2]);
+    check_vec(c, {std::string("c"), std::string("a"), std::string("b"), std::string("c")}, "Spill with self-reference");
+
+    const std::string* heap_data = c.data();
+    SmallVector<std::string, 2> d(std::move(c));
+    assert(d.data() == heap_data && c.empty() && c.is_inline());
+    std::cout << "PASS: Move steals heap buffer" << std::endl;
+
+    c = d;
+    check_vec(c, {std::string("c"), std::string("a"), std::string("b"), std::string("c")}, "Copy assignment");
+    d = SmallVector<std::string, 2>{"x"};
+    check_vec(d, {std::string("x")}, "Move assignment back to inline");
+}
+
+// =========================================================
+// 4. 扩容策略 + allocate_at_least
+// =========================================================
+void test_growth_policy() {
+    std::cout << "\n=== 4. Testing Growth Policy ===" << std::endl;
+
+    heap_allocations = 0;
+    SmallVector<int, 2, CountingAllocator<int>, GrowFixedStep<3>> v;
+    for (int i = 0; i < 8; ++i)
+        v.push_back(i);
+    assert(v.capacity() == 8 && heap_allocations == 2);
+    v.emplace(v.begin(), 100);
+    assert(v.capacity() == 11 && heap_allocations == 3);
+    check_vec(v, {100, 0, 1, 2, 3, 4, 5, 6, 7}, "Spills sized by GrowFixedStep");
+
+    using Counting = CountingGrowth<GrowDouble, GrowthTag>;
+    Counting::stats().reset();
+    SmallVector<std::string, 2, Allocator<std::string>, Counting> s;
+    for (int i = 0; i < 9; ++i)
+        s.push_back(std::to_string(i));
+    s.reserve(64);
+    assert(s.capacity() == 64 && Counting::stats().regrows == 3);
+    std::cout << "PASS: Spills counted by CountingGrowth, reserve() bypasses policy" << std::endl;
+
+    SmallVector<int, 2, SlackAllocator<int>> w = {1, 2};
+    w.push_back(3);
+    assert(w.capacity() == 5);
+    for (int i = 4; i <= 5; ++i)
+        w.push_back(i);
+    assert(w.capacity() == 5);
+    check_vec(w, {1, 2, 3, 4, 5}, "Capacity from allocate_at_least");
+}
+
+int main() {
+    try {
+        test_inline();
+        test_spill();
+        test_copy_move();
+        test_growth_policy();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+#include "SoaVector/SoaVector.h"
+#include "simd_algorithm.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+// =========================================================
+// 辅助工具
+// =========================================================
+
+// 记录申请 / 释放次数的分配器 (经 rebind 用于每一列)
+static int live_columns = 0;
+
+template<typename T>
+struct CountingAllocator : Allocator<T>
+{
+    template<class U>
+    struct rebind { using other = CountingAllocator<U>; };
+
+    CountingAllocator() = default;
+    template<class U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        ++live_columns;
+        return Allocator<T>::allocate(n);
+    }
+    void deallocate(T* p, size_t n)
+    {
+        --live_columns;
+        Allocator<T>::deallocate(p, n);
+    }
+};
+
+// 再成功拷贝 copies_left 次后 下一次拷贝抛异常 (-1 表示不抛)
+static int copies_left = -1;
+
+struct Fragile
+{
+    int value;
+    Fragile(int v = 0) : value(v) {}
+    Fragile(const Fragile& other) : value(other.value)
+    {
+        if(copies_left == 0)
+            throw std::runtime_error("Fragile copy");
+        if(copies_left > 0)
+            --copies_left;
+    }
+    Fragile& operator=(const Fragile&) = default;
+};
+
+// =========================================================
+// 1. 尾插 / 访问
+// =========================================================
+void test_push_access() {
+    std::cout << "\n=== 1. Testing push_back / Access ===" << std::endl;
+
+    SoaVector<int, double, std::string> v;
+    assert(v.empty() && v.size() == 0 && v.data<0>() == nullptr);
+    for (int i = 0; i < 1000; ++i)
+        v.push_back(i, i * 0.5, std::to_string(i));
+    v.emplace_back(-1, 2.5, "xxx");
+    v.push_back(std::make_tuple(7, 7.0, std::string("seven")));
+    assert(v.size() == 1002 && v.capacity() >= 1002);
+    for (int i = 0; i < 1000; ++i)
+        assert(v.get<0>(i) == i && v.get<1>(i) == i * 0.5 && v.get<2>(i) == std::to_string(i));
+    assert(v.get<2>(1000) == "xxx" && std::get<2>(v.back()) == "seven");
+    std::cout << "PASS: push_back / emplace_back / get<I>" << std::endl;
+
+    // 行引用可以写回
+    std::get<0>(v[3]) = 42;
+    std::get<2>(v.front()) = "zero";
+    assert(v.get<0>(3) == 42 && v.get<2>(0) == "zero");
+    auto [a, b, c] = v[10];
+    assert(a == 10 && b == 5.0 && c == "10");
+    std::cout << "PASS: Row references" << std::endl;
+
+    // 参数引用本容器的元素 (会触发扩容)
+    SoaVector<std::string> s;
+    s.push_back(std::string("self"));
+    for (int i = 0; i < 100; ++i)
+        s.push_back(s.get<0>(0));
+    assert(s.size() == 101 && s.get<0>(100) == "self");
+    std::cout << "PASS: push_back with reference to own element" << std::endl;
+
+    v.pop_back();
+    assert(v.size() == 1001 && v.get<2>(1000) == "xxx");
+    bool thrown = false;
+    try { v.at(v.size()); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown && std::get<0>(v.at(5)) == 5);
+    std::cout << "PASS: pop_back / at() bounds check" << std::endl;
+}
+
+// =========================================================
+// 2. 列区间 / SIMD
+// =========================================================
+void test_columns() {
+    std::cout << "\n=== 2. Testing Column Spans ===" << std::endl;
+
+    SoaVector<std::int32_t, float, std::uint64_t> v;
+    for (int i = 0; i < 10000; ++i)
+        v.push_back(i % 100, float(i), std::uint64_t(i) * 3);
+
+    auto ids = v.column<0>();
+    assert(ids.size() == v.size() && ids.data() == v.data<0>());
+    long long expect = 0;
+    for (std::int32_t x : ids)
+        expect += x;
+    assert(simd_sum(ids.begin(), ids.end()) == expect);
+    assert(simd_count(ids.begin(), ids.end(), 42) == 100);
+    assert(*simd_max_element(v.column<1>().begin(), v.column<1>().end()) == 9999.0f);
+    std::cout << "PASS: simd_sum / simd_count / simd_max_element on columns" << std::endl;
+
+    // 各列连续 互不重叠
+    auto c2 = v.column<2>();
+    assert(c2[9999] == 29997);
+    std::sort(c2.begin(), c2.end(), [](std::uint64_t x, std::uint64_t y) { return x > y; });
+    assert(v.get<2>(0) == 29997 && v.get<0>(0) == 0);
+    const auto& cv = v;
+    assert(cv.column<1>()[1] == 1.0f && cv.column<1>().size() == 10000);
+    std::cout << "PASS: Columns are independent contiguous arrays" << std::endl;
+}
+
+// =========================================================
+// 3. 拷贝 / 移动 / 容量
+// =========================================================
+void test_copy_capacity() {
+    std::cout << "\n=== 3. Testing Copy / Move / Capacity ===" << std::endl;
+
+    SoaVector<int, std::string> v;
+    for (int i = 0; i < 100; ++i)
+        v.push_back(i, std::to_string(i));
+
+    SoaVector<int, std::string> copy(v);
+    assert(copy.size() == 100 && copy.get<1>(99) == "99" && copy.data<0>() != v.data<0>());
+    SoaVector<int, std::string> moved(std::move(copy));
+    assert(copy.empty() && moved.get<0>(50) == 50);
+    copy = moved;
+    moved = SoaVector<int, std::string>();
+    assert(copy.size() == 100 && copy.get<1>(0) == "0" && moved.empty());
+    std::cout << "PASS: Copy / move construct and assign" << std::endl;
+
+    v.reserve(1000);
+    assert(v.capacity() == 1000 && v.get<1>(42) == "42");
+    v.resize(10);
+    assert(v.size() == 10 && v.get<1>(9) == "9");
+    v.resize(20);
+    assert(v.size() == 20 && v.get<0>(19) == 0 && v.get<1>(19).empty());
+    v.shrink_to_fit();
+    assert(v.capacity() == 20 && v.get<1>(5) == "5");
+    v.clear();
+    assert(v.empty() && v.capacity() == 20);
+    v.shrink_to_fit();
+    assert(v.capacity() == 0);
+    v.push_back(1, "one");
+    assert(v.size() == 1 && v.get<1>(0) == "one");
+    std::cout << "PASS: reserve / resize / shrink_to_fit / clear" << std::endl;
+}
+
+// =========================================================
+// 4. 异常安全
+// =========================================================
+void test_exception_safety() {
+    std::cout << "\n=== 4. Testing Exception Safety ===" << std::endl;
+
+    SoaVector<std::string, Fragile> v;
+    for (int i = 0; i < 8; ++i)
+        v.emplace_back(std::to_string(i), i);
+    assert(v.capacity() == 8);
+
+    // 扩容时第二列的搬运中途抛异常 (Fragile 只能拷贝) 容器不变
+    copies_left = 3;
+    bool thrown = false;
+    try { v.emplace_back("8", 8); } catch (const std::runtime_error&) { thrown = true; }
+    copies_left = -1;
+    assert(thrown && v.size() == 8 && v.capacity() == 8);
+    for (int i = 0; i < 8; ++i)
+        assert(v.get<0>(i) == std::to_string(i) && v.get<1>(i).value == i);
+    std::cout << "PASS: Throw during relocation leaves container unchanged" << std::endl;
+
+    // 构造新行时第二列抛异常 第一列已构造的元素被析构
+    v.reserve(16);
+    Fragile f(99);
+    copies_left = 0;
+    thrown = false;
+    try { v.push_back(std::string(100, 'a'), f); } catch (const std::runtime_error&) { thrown = true; }
+    copies_left = -1;
+    assert(thrown && v.size() == 8);
+    v.push_back(std::string("ok"), f);
+    assert(v.size() == 9 && v.get<0>(8) == "ok" && v.get<1>(8).value == 99);
+    std::cout << "PASS: Throw while constructing a row" << std::endl;
+}
+
+// =========================================================
+// 5. 分配器 rebind
+// =========================================================
+void test_allocator() {
+    std::cout << "\n=== 5. Testing Allocator Rebind ===" << std::endl;
+    {
+        BasicSoaVector<CountingAllocator<char>, GrowDouble, int, double, std::string> v;
+        for (int i = 0; i < 100; ++i)
+            v.push_back(i, double(i), std::to_string(i));
+        // 每列一块
+        assert(live_columns == 3);
+        auto copy = v;
+        assert(live_columns == 6);
+        v.clear();
+        v.shrink_to_fit();
+        assert(live_columns == 3);
+    }
+    assert(live_columns == 0);
+    std::cout << "PASS: Each column allocated via rebind, all released" << std::endl;
+}
+
+// =========================================================
+// 6. 只能移动的列
+// =========================================================
+void test_move_only() {
+    std::cout << "\n=== 6. Testing Move-only Column ===" << std::endl;
+
+    // 扩容只移动 不会实例化 std::unique_ptr 的拷贝
+    SoaVector<int, std::unique_ptr<int>> v;
+    for (int i = 0; i < 100; ++i) {
+        // push_back(Fields&&...) 要求每列都是右值
+        if (i % 2)
+            v.push_back(int(i), std::make_unique<int>(i));
+        else
+            v.emplace_back(i, new int(i));
+    }
+    v.reserve(1000);
+    assert(v.size() == 100 && v.capacity() == 1000);
+    for (int i = 0; i < 100; ++i)
+        assert(v.get<0>(i) == i && *v.get<1>(i) == i);
+    v.resize(120);
+    v.shrink_to_fit();
+    assert(v.capacity() == 120 && v.get<1>(119) == nullptr && *v.get<1>(99) == 99);
+    std::cout << "PASS: push_back / emplace_back / reserve / shrink_to_fit" << std::endl;
+
+    int* first = v.get<1>(0).get();
+    SoaVector<int, std::unique_ptr<int>> moved(std::move(v));
+    assert(v.empty() && moved.get<1>(0).get() == first);
+    v = std::move(moved);
+    assert(moved.empty() && v.size() == 120 && v.get<1>(0).get() == first);
+    std::cout << "PASS: Move construct and assign" << std::endl;
+}
+
+int main() {
+    try {
+        test_push_access();
+        test_columns();
+        test_copy_capacity();
+        test_exception_safety();
+        test_allocator();
+        test_move_only();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
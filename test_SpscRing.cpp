@@ -0,0 +1,150 @@
+#include "SpscRing/SpscRing.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+// =========================================================
+// 1. 单线程基本操作
+// =========================================================
+void test_basic() {
+    std::cout << "\n=== 1. Testing Basic Operations ===" << std::endl;
+
+    SpscRing<int> q(5);
+    assert(q.capacity() == 8 && q.empty_approx());
+    int out = 0;
+    assert(!q.try_pop(out));
+    for (int i = 0; i < 8; ++i)
+        assert(q.try_push(i));
+    assert(!q.try_push(100) && q.size_approx() == 8);
+    std::cout << "PASS: Capacity rounding / full" << std::endl;
+
+    // 多次绕圈 保持先进先出
+    int next_in = 8, next_out = 0;
+    for (int round = 0; round < 100; ++round) {
+        for (int k = 0; k < 3; ++k) {
+            assert(q.try_pop(out) && out == next_out++);
+        }
+        for (int k = 0; k < 3; ++k)
+            assert(q.try_emplace(next_in++));
+    }
+    assert(q.size_approx() == 8);
+    std::cout << "PASS: FIFO across wrap-around" << std::endl;
+
+    // 批量: 放不下 / 取不够时处理部分
+    int buf[16];
+    assert(q.pop_n(buf, 5) == 5 && buf[0] == next_out && buf[4] == next_out + 4);
+    next_out += 5;
+    int src[10];
+    for (int i = 0; i < 10; ++i)
+        src[i] = next_in + i;
+    assert(q.push_n(src, 10) == 5);
+    next_in += 5;
+    assert(q.push_n(src, 10) == 0);
+    assert(q.pop_n(buf, 16) == 8);
+    for (int i = 0; i < 8; ++i)
+        assert(buf[i] == next_out + i);
+    assert(q.pop_n(buf, 16) == 0 && q.empty_approx());
+    std::cout << "PASS: push_n / pop_n partial batches" << std::endl;
+
+    // 没有能容纳的 2 的幂
+    bool thrown = false;
+    try { SpscRing<char> huge(~std::size_t(0)); } catch (const std::length_error&) { thrown = true; }
+    assert(thrown);
+    std::cout << "PASS: Oversized capacity throws std::length_error" << std::endl;
+}
+
+// =========================================================
+// 2. 非平凡类型
+// =========================================================
+void test_non_trivial() {
+    std::cout << "\n=== 2. Testing Non-trivial Types ===" << std::endl;
+
+    SpscRing<std::string> q(4);
+    std::string s = "moved";
+    assert(q.try_push(std::move(s)) && s.empty());
+    std::string kept = "kept";
+    assert(q.try_push(kept) && kept == "kept");
+    assert(q.try_emplace(3, 'x'));
+    std::string out;
+    assert(q.try_pop(out) && out == "moved");
+    assert(q.try_pop(out) && out == "kept");
+    assert(q.try_pop(out) && out == "xxx");
+    std::cout << "PASS: std::string push / emplace / pop" << std::endl;
+
+    // 每个元素持有 token 的一份引用 析构后只剩 token 自己
+    auto token = std::make_shared<int>(0);
+    {
+        SpscRing<std::shared_ptr<int>> t(16);
+        for (int i = 0; i < 10; ++i)
+            t.try_push(token);
+        std::shared_ptr<int> sink;
+        for (int i = 0; i < 4; ++i)
+            t.try_pop(sink);
+        assert(token.use_count() == 1 + 6 + 1);
+    }
+    assert(token.use_count() == 1);
+    std::cout << "PASS: Remaining elements destroyed" << std::endl;
+}
+
+// =========================================================
+// 3. 生产者 / 消费者两个线程
+// =========================================================
+void test_two_threads() {
+    std::cout << "\n=== 3. Testing Producer / Consumer Threads ===" << std::endl;
+    const std::uint64_t n = 1000000;
+
+    for (bool batched : {false, true}) {
+        SpscRing<std::uint64_t> q(1024);
+        std::thread producer([&]() {
+            std::uint64_t next = 0;
+            std::uint64_t buf[64];
+            while (next < n) {
+                if (batched) {
+                    std::uint64_t k = n - next < 64 ? n - next : 64;
+                    for (std::uint64_t i = 0; i < k; ++i)
+                        buf[i] = next + i;
+                    next += q.push_n(buf, k);
+                }
+                else if (q.try_push(next))
+                    ++next;
+            }
+        });
+
+        std::uint64_t expect = 0;
+        std::uint64_t buf[64];
+        while (expect < n) {
+            std::size_t k = batched ? q.pop_n(buf, 64) : (q.try_pop(buf[0]) ? 1 : 0);
+            for (std::size_t i = 0; i < k; ++i)
+                assert(buf[i] == expect++);
+        }
+        producer.join();
+        assert(q.empty_approx());
+        std::cout << "PASS: " << n << " items in order" << (batched ? " (batched)" : "") << std::endl;
+    }
+}
+
+int main() {
+    try {
+        test_basic();
+        test_non_trivial();
+        test_two_threads();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
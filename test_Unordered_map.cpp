@@ -0,0 +1,845 @@
+#include "Unordered_map/Unordered_map.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// =========================================================
+// 辅助工具
+// =========================================================
+
+// 所有 key 哈希到同一个值 强制走最长的探测序列
+struct BadHash
+{
+    size_t operator()(int) const { return 42; }
+};
+
+// 与 std::unordered_map 逐项对比
+template<typename Map, typename Ref>
+void check_map(const Map& m, const Ref& ref, const std::string& msg) {
+    if (m.size() != ref.size()) {
+        std::cerr << "FAIL: " << msg << " - Size mismatch! Expected " << ref.size() << ", got " << m.size() << std::endl;
+        exit(1);
+    }
+    for (const auto& kv : ref) {
+        auto it = m.find(kv.first);
+        if (it == m.end() || it->second != kv.second) {
+            std::cerr << "FAIL: " << msg << " - Content mismatch at key " << kv.first << std::endl;
+            exit(1);
+        }
+    }
+    size_t n = 0;
+    for (auto it = m.begin(); it != m.end(); ++it)
+        ++n;
+    if (n != ref.size()) {
+        std::cerr << "FAIL: " << msg << " - Iteration visited " << n << " elements" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASS: " << msg << std::endl;
+}
+
+// =========================================================
+// 1. 基础插入/查找
+// =========================================================
+void test_basic() {
+    std::cout << "\n=== 1. Testing Insert / Find ===" << std::endl;
+
+    Unordered_map<int, int> m;
+    assert(m.empty());
+    assert(m.find(1) == m.end());
+    assert(m.begin() == m.end());
+    std::cout << "PASS: Empty map" << std::endl;
+
+    auto res = m.insert({1, 10});
+    assert(res.second && res.first->second == 10);
+    res = m.insert({1, 20});
+    assert(!res.second && res.first->second == 10); // 已存在不覆盖
+    std::cout << "PASS: Insert duplicate" << std::endl;
+
+    m[2] = 20;
+    m[3];
+    assert(m.at(2) == 20);
+    assert(m[3] == 0);
+    assert(m.count(3) == 1 && m.count(4) == 0);
+    assert(m.contains(1) && !m.contains(5));
+    std::cout << "PASS: operator[] / at / count / contains" << std::endl;
+
+    bool thrown = false;
+    try { m.at(100); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+    std::cout << "PASS: at() throws on missing key" << std::endl;
+
+    auto e = m.emplace(7, 70);
+    assert(e.second && m[7] == 70);
+    std::cout << "PASS: emplace" << std::endl;
+}
+
+// =========================================================
+// 2. 大量数据 + 扩容 与 std::unordered_map 对比
+// =========================================================
+void test_growth() {
+    std::cout << "\n=== 2. Testing Growth ===" << std::endl;
+
+    Unordered_map<int, int> m;
+    std::unordered_map<int, int> ref;
+    for (int i = 0; i < 100000; ++i) {
+        m[i * 7] = i;
+        ref[i * 7] = i;
+    }
+    check_map(m, ref, "100k inserts with rehash");
+    assert(m.load_factor() <= m.max_load_factor());
+
+    Unordered_map<int, int> r;
+    r.reserve(1000);
+    size_t cap = r.bucket_count();
+    for (int i = 0; i < 1000; ++i)
+        r[i] = i;
+    assert(r.bucket_count() == cap);
+    std::cout << "PASS: reserve avoids rehash" << std::endl;
+}
+
+// =========================================================
+// 3. 删除 (墓碑复用)
+// =========================================================
+void test_erase() {
+    std::cout << "\n=== 3. Testing Erase ===" << std::endl;
+
+    Unordered_map<int, int> m;
+    std::unordered_map<int, int> ref;
+    for (int i = 0; i < 5000; ++i) {
+        m[i] = i;
+        ref[i] = i;
+    }
+    for (int i = 0; i < 5000; i += 3) {
+        assert(m.erase(i) == 1);
+        ref.erase(i);
+    }
+    assert(m.erase(-1) == 0);
+    check_map(m, ref, "Erase by key");
+
+    // 反复插入删除 容量不应无限增长
+    size_t cap = m.bucket_count();
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 0; i < 1000; ++i)
+            m[100000 + i] = i;
+        for (int i = 0; i < 1000; ++i)
+            m.erase(100000 + i);
+    }
+    check_map(m, ref, "Insert/erase churn");
+    assert(m.bucket_count() <= cap * 2);
+
+    // 迭代删除
+    for (auto it = m.begin(); it != m.end();) {
+        if (it->first % 2 == 0)
+            it = m.erase(it);
+        else
+            ++it;
+    }
+    for (auto it = ref.begin(); it != ref.end();) {
+        if (it->first % 2 == 0)
+            it = ref.erase(it);
+        else
+            ++it;
+    }
+    check_map(m, ref, "Erase while iterating");
+
+    m.clear();
+    assert(m.empty() && m.begin() == m.end());
+    std::cout << "PASS: clear" << std::endl;
+}
+
+// =========================================================
+// 4. 冲突 + 复杂类型
+// =========================================================
+void test_collision_and_string() {
+    std::cout << "\n=== 4. Testing Collisions / std::string ===" << std::endl;
+
+    Unordered_map<int, int, BadHash> bad;
+    std::unordered_map<int, int> ref;
+    for (int i = 0; i < 500; ++i) {
+        bad[i] = -i;
+        ref[i] = -i;
+    }
+    for (int i = 0; i < 500; i += 2) {
+        bad.erase(i);
+        ref.erase(i);
+    }
+    check_map(bad, ref, "All keys colliding");
+
+    Unordered_map<std::string, std::string> s;
+    std::unordered_map<std::string, std::string> sref;
+    for (int i = 0; i < 2000; ++i) {
+        std::string k = "key_" + std::to_string(i);
+        s[k] = std::string(i % 40, 'x');
+        sref[k] = std::string(i % 40, 'x');
+    }
+    check_map(s, sref, "String keys / values");
+}
+
+// =========================================================
+// 5. 拷贝 / 移动
+// =========================================================
+void test_copy_move() {
+    std::cout << "\n=== 5. Testing Copy / Move ===" << std::endl;
+
+    Unordered_map<std::string, int> a = {{"a", 1}, {"b", 2}, {"c", 3}};
+    std::unordered_map<std::string, int> ref = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+    Unordered_map<std::string, int> b(a);
+    check_map(b, ref, "Copy Constructor");
+
+    Unordered_map<std::string, int> c(std::move(b));
+    check_map(c, ref, "Move Constructor");
+    assert(b.empty());
+
+    Unordered_map<std::string, int> d;
+    d = a;
+    check_map(d, ref, "Copy Assignment");
+    d = std::move(c);
+    check_map(d, ref, "Move Assignment");
+
+    a.rehash(1024);
+    assert(a.bucket_count() >= 1024);
+    check_map(a, ref, "rehash");
+}
+
+// =========================================================
+// 6. 渐进式 rehash
+// =========================================================
+void test_incremental_rehash() {
+    std::cout << "\n=== 6. Testing Incremental Rehash ===" << std::endl;
+
+    Unordered_map<int, std::string> m;
+    std::unordered_map<int, std::string> ref;
+    m.set_incremental_rehash(true);
+    assert(m.incremental_rehash());
+
+    // 插入到扩容点 之后旧表仍在 查找/迭代要覆盖两张表
+    bool saw_rehashing = false;
+    for (int i = 0; i < 5000; ++i) {
+        m[i] = std::to_string(i);
+        ref[i] = std::to_string(i);
+        if (m.rehashing() && !saw_rehashing) {
+            saw_rehashing = true;
+            check_map(m, ref, "Lookup / iterate while rehashing");
+        }
+    }
+    assert(saw_rehashing);
+    check_map(m, ref, "Incremental inserts");
+
+    // 搬运中途: 删除旧表中的元素 / 覆盖旧表中的元素 / 边遍历边删除
+    while (!m.rehashing()) {
+        int k = static_cast<int>(ref.size()) + 100000;
+        m[k] = "x";
+        ref[k] = "x";
+    }
+    for (int i = 0; i < 5000; i += 3) {
+        assert(m.erase(i) == 1);
+        ref.erase(i);
+    }
+    for (int i = 1; i < 5000; i += 3) {
+        m.insert({i, "dup"});
+        m[i] += "!";
+        ref[i] += "!";
+    }
+    assert(m.at(1) == "1!");
+    check_map(m, ref, "Erase / assign across both tables");
+
+    size_t removed = 0;
+    for (auto it = m.begin(); it != m.end();) {
+        if (it->first % 2 == 0) {
+            ref.erase(it->first);
+            it = m.erase(it);
+            ++removed;
+        }
+        else
+            ++it;
+    }
+    assert(removed > 0);
+    check_map(m, ref, "Erase while iterating during rehash");
+
+    // 搬运中途 key 已存在的插入 / 赋值不搬运 之前拿到的引用仍然有效
+    Unordered_map<int, int> hits;
+    hits.set_incremental_rehash(true);
+    int n = 0;
+    while (!hits.rehashing()) {
+        hits[n] = n;
+        ++n;
+    }
+    std::vector<int*> refs;
+    for (int i = 0; i < n; ++i)
+        refs.push_back(&hits.find(i)->second);
+    for (int i = 0; i < n; ++i) {
+        hits[i] += 1;
+        assert(!hits.insert({i, -1}).second && !hits.try_emplace(i, -1).second);
+        assert(!hits.emplace(i, -1).second);
+        auto res = hits.insert_or_assign(i, *refs[i] + 1);
+        assert(!res.second && &res.first->second == refs[i]);
+    }
+    assert(hits.rehashing());
+    for (int i = 0; i < n; ++i)
+        assert(&hits.find(i)->second == refs[i] && *refs[i] == i + 2);
+    std::cout << "PASS: Hits during rehash keep references valid" << std::endl;
+
+    // 只删不插也能搬完旧表 / 边遍历边删空旧表时释放旧表
+    int erased = 0;
+    for (; erased < n && hits.rehashing(); erased += 2)
+        assert(hits.erase(erased) == 1);
+    assert(!hits.rehashing() && erased < n);
+    for (int i = 0; i < n; ++i)
+        assert(hits.contains(i) == (i % 2 == 1 || i >= erased));
+    hits.clear();
+    n = 0;
+    while (!hits.rehashing())
+        hits[n++] = 0;
+    for (auto it = hits.begin(); it != hits.end();)
+        it = hits.erase(it);
+    assert(hits.empty() && !hits.rehashing() && hits.begin() == hits.end());
+    hits[1] = 1;
+    assert(hits.size() == 1 && hits.at(1) == 1);
+    std::cout << "PASS: Erase-only workloads finish migration" << std::endl;
+
+    // 拷贝 / 移动 / 关闭开关时一次搬完
+    Unordered_map<int, std::string> copy(m);
+    check_map(copy, ref, "Copy during rehash");
+    Unordered_map<int, std::string> moved(std::move(copy));
+    check_map(moved, ref, "Move during rehash");
+    m.set_incremental_rehash(false);
+    assert(!m.rehashing());
+    check_map(m, ref, "Disable finishes migration");
+
+    // 一直插入 每次插入的搬运量有上限 最终旧表释放
+    Unordered_map<int, int> big;
+    big.set_incremental_rehash(true);
+    for (int i = 0; i < 200000; ++i)
+        big[i] = i;
+    for (int i = 0; i < 200000; i += 997)
+        assert(big.at(i) == i);
+    big.clear();
+    assert(big.empty() && !big.rehashing() && big.begin() == big.end());
+    std::cout << "PASS: Large incremental map / clear" << std::endl;
+}
+
+// =========================================================
+// 7. 批量查找
+// =========================================================
+void test_batch_lookup() {
+    std::cout << "\n=== 7. Testing Batched Lookup ===" << std::endl;
+
+    Unordered_map<int, int> m;
+    std::vector<int> keys;
+    for (int i = 0; i < 100; ++i)
+        keys.push_back(i * 3);                  // 一半命中 (偶数) 一半未命中
+    bool found[100];
+    Unordered_map<int, int>::iterator its[100];
+
+    m.contains_batch(keys.data(), keys.size(), found);
+    assert(std::count(found, found + 100, true) == 0);
+    std::cout << "PASS: contains_batch on empty map" << std::endl;
+
+    for (int i = 0; i < 300; i += 2)
+        m[i] = -i;
+    m.find_batch(keys.data(), keys.size(), its);
+    m.contains_batch(keys.data(), keys.size(), found);
+    for (size_t k = 0; k < keys.size(); ++k) {
+        bool hit = keys[k] % 2 == 0;
+        assert(found[k] == hit);
+        assert((its[k] != m.end()) == hit);
+        assert(!hit || its[k]->second == -keys[k]);
+    }
+    const Unordered_map<int, int>& cm = m;
+    Unordered_map<int, int>::const_iterator cits[100];
+    cm.find_batch(keys.data(), 37, cits);
+    for (size_t k = 0; k < 37; ++k)
+        assert(cits[k] == cm.find(keys[k]));
+    std::cout << "PASS: find_batch / contains_batch match find" << std::endl;
+
+    // 渐进式 rehash 期间旧表中的 key 也能找到
+    Unordered_map<int, int> inc;
+    inc.set_incremental_rehash(true);
+    int n = 0;
+    while (!inc.rehashing() || n < 20) {
+        inc[n] = n;
+        ++n;
+    }
+    std::vector<int> all;
+    for (int i = 0; i < n + 10; ++i)
+        all.push_back(i);
+    std::unique_ptr<bool[]> hits(new bool[all.size()]);
+    inc.contains_batch(all.data(), all.size(), hits.get());
+    for (size_t k = 0; k < all.size(); ++k)
+        assert(hits[k] == (all[k] < n));
+    std::cout << "PASS: Batched lookup while rehashing" << std::endl;
+}
+
+// =========================================================
+// 8. 可选的哈希混合
+// =========================================================
+template<typename Mixer>
+void check_mixer(const char* name) {
+    Unordered_map<int, int, std::hash<int>, std::equal_to<int>, Allocator<HashNode<int, int>>, Mixer> m;
+    for (int i = 0; i < 5000; ++i)
+        m[i * 64] = i;                          // 低位全为 0 的 key
+    for (int i = 0; i < 5000; ++i)
+        assert(m.at(i * 64) == i);
+    assert(!m.contains(1) && m.erase(64) == 1 && m.size() == 4999);
+
+    auto copy = m;
+    assert(copy.size() == 4999 && copy.at(128) == 2);
+    std::cout << "PASS: " << name << std::endl;
+}
+
+void test_mixers() {
+    std::cout << "\n=== 8. Testing Hash Mixers ===" << std::endl;
+
+    check_mixer<HashMixFibonacci>("HashMixFibonacci");
+    check_mixer<HashMixMurmur>("HashMixMurmur");
+    check_mixer<HashMixIdentity>("HashMixIdentity");
+
+    static_assert(std::is_same<Unordered_map<int, int>::mixer_type, HashMixFibonacci>::value, "default mixer");
+    // 混合后相邻的 key 落到不同位置
+    HashMixFibonacci fib;
+    assert(fib(1) != fib(2) && (fib(1) >> 7) != (fib(2) >> 7));
+    assert(HashMixIdentity()(12345) == 12345);
+
+    Unordered_map<std::string, int, std::hash<std::string>, std::equal_to<std::string>,
+                  Allocator<HashNode<std::string, int>>, HashMixIdentity> s;
+    for (int i = 0; i < 1000; ++i)
+        s["key_" + std::to_string(i)] = i;
+    assert(s.size() == 1000 && s.at("key_999") == 999);
+    std::cout << "PASS: std::string keys with HashMixIdentity" << std::endl;
+}
+
+// =========================================================
+// 9. 透明查找
+// =========================================================
+// 记录构造次数的 key 用来确认查找时没有构造临时 key
+struct CountedKey {
+    static int made;
+    std::string s;
+    CountedKey(std::string_view v) : s(v) { ++made; }
+    CountedKey(const CountedKey& o) : s(o.s) { ++made; }
+    CountedKey(CountedKey&& o) noexcept : s(std::move(o.s)) {}
+};
+int CountedKey::made = 0;
+
+struct CountedHash {
+    using is_transparent = void;
+    size_t operator()(const CountedKey& k) const { return StringHash()(k.s); }
+    size_t operator()(std::string_view v) const { return StringHash()(v); }
+};
+
+struct CountedEqual {
+    using is_transparent = void;
+    bool operator()(const CountedKey& a, const CountedKey& b) const { return a.s == b.s; }
+    bool operator()(const CountedKey& a, std::string_view b) const { return a.s == b; }
+};
+
+void test_transparent_lookup() {
+    std::cout << "\n=== 9. Testing Transparent Lookup ===" << std::endl;
+
+    Unordered_map<std::string, int, StringHash, std::equal_to<>> m;
+    for (int i = 0; i < 200; ++i)
+        m["key_" + std::to_string(i)] = i;
+    std::string buffer = "GET key_42 key_199 key_200";
+    std::string_view a(buffer.data() + 4, 6), b(buffer.data() + 11, 7), c(buffer.data() + 19, 7);
+    assert(m.find(a) != m.end() && m.find(a)->second == 42);
+    assert(m.contains(b) && m.count(b) == 1);
+    assert(!m.contains(c) && m.count(c) == 0 && m.find(c) == m.end());
+    assert(m.contains("key_7") && m.find(std::string("key_8"))->second == 8);
+    const auto& cm = m;
+    assert(cm.find(a)->second == 42);
+    assert(m.erase(a) == 1 && m.erase(a) == 0 && !m.contains(a) && m.size() == 199);
+    m.erase(m.find(b));
+    m.erase(cm.find("key_198"));
+    assert(m.size() == 197);
+    m["key_199"] = 199;
+    m["key_198"] = 198;
+    std::cout << "PASS: std::string keys looked up by string_view / const char*" << std::endl;
+
+    // 渐进式 rehash 期间旧表里的元素同样能透明查到
+    m.set_incremental_rehash(true);
+    for (int i = 200; i < 1000; ++i)
+        m["key_" + std::to_string(i)] = i;
+    for (int i = 0; i < 1000; ++i) {
+        std::string k = "key_" + std::to_string(i);
+        assert(m.contains(std::string_view(k)) == (i != 42));
+    }
+    std::cout << "PASS: Transparent lookup while rehashing" << std::endl;
+
+    Unordered_map<CountedKey, int, CountedHash, CountedEqual> counted;
+    counted.emplace(std::string_view("alpha"), 1);
+    counted.emplace(std::string_view("beta"), 2);
+    int before = CountedKey::made;
+    assert(counted.find(std::string_view("alpha"))->second == 1);
+    assert(counted.contains(std::string_view("beta")) && !counted.contains(std::string_view("gamma")));
+    assert(counted.count(std::string_view("beta")) == 1);
+    assert(counted.erase(std::string_view("alpha")) == 1 && counted.size() == 1);
+    assert(CountedKey::made == before);
+    std::cout << "PASS: No temporary keys constructed" << std::endl;
+
+    // 非透明的 map 仍然走 const Key& 重载
+    static_assert(!has_is_transparent<std::hash<std::string>>::value, "std::hash is not transparent");
+    Unordered_map<std::string, int> plain;
+    plain["x"] = 1;
+    assert(plain.contains("x") && plain.erase("x") == 1);
+    std::cout << "PASS: Non-transparent map unchanged" << std::endl;
+}
+
+// =========================================================
+// 10. try_emplace / insert_or_assign / 结点句柄 / merge
+// =========================================================
+// 只能移动 记录移动次数
+struct MoveOnly {
+    static int moves;
+    int v;
+    explicit MoveOnly(int x) : v(x) {}
+    MoveOnly(MoveOnly&& o) noexcept : v(o.v) { ++moves; }
+    MoveOnly& operator=(MoveOnly&& o) noexcept { v = o.v; ++moves; return *this; }
+    MoveOnly(const MoveOnly&) = delete;
+};
+int MoveOnly::moves = 0;
+
+// 只持有一个指针 按字节搬运是安全的 特化后容器搬运时不调用移动构造
+struct OwnedInt {
+    static int moves;
+    int* p;
+    explicit OwnedInt(int x) : p(new int(x)) {}
+    OwnedInt(OwnedInt&& o) noexcept : p(o.p) { o.p = nullptr; ++moves; }
+    OwnedInt(const OwnedInt&) = delete;
+    ~OwnedInt() { delete p; }
+};
+int OwnedInt::moves = 0;
+
+template<>
+struct is_trivially_relocatable<OwnedInt> : std::true_type {};
+
+void test_node_handles() {
+    std::cout << "\n=== 10. Testing try_emplace / Node Handles / merge ===" << std::endl;
+
+    Unordered_map<std::string, MoveOnly> m;
+    std::string k = "alpha";
+    auto r = m.try_emplace(std::move(k), 1);
+    assert(r.second && r.first->second.v == 1 && k.empty());
+    std::string k2 = "alpha";
+    r = m.try_emplace(std::move(k2), 2);
+    assert(!r.second && r.first->second.v == 1 && k2 == "alpha");   // 已存在时不移动 key
+    std::cout << "PASS: try_emplace" << std::endl;
+
+    Unordered_map<std::string, std::string> s;
+    assert(s.insert_or_assign("a", "1").second);
+    auto ia = s.insert_or_assign("a", std::string("2"));
+    assert(!ia.second && ia.first->second == "2" && s.size() == 1);
+    std::cout << "PASS: insert_or_assign" << std::endl;
+
+    // 句柄: 取出 改 key 插回
+    for (int i = 0; i < 100; ++i)
+        s["key_" + std::to_string(i)] = std::string(40, 'a' + i % 26);
+    auto nh = s.extract("key_5");
+    assert(nh && nh.key() == "key_5" && nh.mapped() == std::string(40, 'f'));
+    assert(!s.contains("key_5") && s.size() == 100);
+    nh.key() = "renamed";
+    auto ir = s.insert(std::move(nh));
+    assert(ir.inserted && ir.position->first == "renamed" && !ir.node && nh.empty());
+    assert(s.at("renamed") == std::string(40, 'f') && s.size() == 101);
+    assert(s.extract("missing").empty());
+
+    auto dup = s.extract(s.find("key_6"));
+    dup.key() = "key_7";
+    ir = s.insert(std::move(dup));
+    assert(!ir.inserted && ir.node && ir.node.key() == "key_7" && ir.position->first == "key_7");
+    assert(s.insert(decltype(s)::node_handle()).position == s.end());
+    std::cout << "PASS: extract / insert(node_handle)" << std::endl;
+
+    // 句柄在 map 之间转移 值不拷贝
+    Unordered_map<std::string, MoveOnly> other;
+    int moves = MoveOnly::moves;
+    auto h = m.extract("alpha");
+    other.insert(std::move(h));
+    assert(m.empty() && other.at("alpha").v == 1);
+    assert(MoveOnly::moves - moves <= 2);
+    std::cout << "PASS: Move node between maps" << std::endl;
+
+    // 成员都可平凡搬运的 pair 整体可平凡搬运: 扩容 / extract / insert 都按字节搬 不调用移动构造
+    static_assert(is_trivially_relocatable<std::pair<const int, double>>::value, "pair of scalars");
+    static_assert(is_trivially_relocatable<std::pair<const int, OwnedInt>>::value, "pair of relocatable members");
+    static_assert(!is_trivially_relocatable<std::pair<int, std::string>>::value, "std::string member");
+    Unordered_map<int, OwnedInt> owned, owned2;
+    for (int i = 0; i < 1000; ++i)
+        owned.try_emplace(i, i);
+    for (int i = 0; i < 1000; i += 2)
+        owned2.insert(owned.extract(i));
+    assert(OwnedInt::moves == 0);
+    assert(owned.size() == 500 && owned2.size() == 500 && *owned2.at(998).p == 998 && *owned.at(1).p == 1);
+    std::cout << "PASS: Trivially relocatable pairs move by memcpy" << std::endl;
+
+    // merge: 重复的 key 留在源表
+    Unordered_map<int, std::string> a, b;
+    for (int i = 0; i < 1000; ++i)
+        a[i] = "a" + std::to_string(i);
+    b.set_incremental_rehash(true);
+    for (int i = 500; i < 2300; ++i)               // 1800 个 刚越过 2048 槽位的负载上限
+        b[i] = "b" + std::to_string(i);
+    assert(b.rehashing());
+    a.merge(b);
+    assert(a.size() == 2300 && b.size() == 500);
+    for (int i = 0; i < 2300; ++i)
+        assert(a.at(i) == (i < 1000 ? "a" : "b") + std::to_string(i));
+    for (int i = 500; i < 1000; ++i)
+        assert(b.at(i) == "b" + std::to_string(i));
+    size_t left = 0;
+    for (auto& kv : b) {
+        assert(kv.first >= 500 && kv.first < 1000);
+        ++left;
+    }
+    assert(left == 500);
+    a.merge(a);
+    assert(a.size() == 2300);
+
+    // 不同 Mixer 的表之间也能合并
+    Unordered_map<int, std::string, std::hash<int>, std::equal_to<int>,
+                  Allocator<HashNode<int, std::string>>, HashMixMurmur> c;
+    c[5000] = "c";
+    c[0] = "dup";
+    a.merge(std::move(c));
+    assert(a.size() == 2301 && a.at(5000) == "c" && a.at(0) == "a0" && c.size() == 1);
+    std::cout << "PASS: merge" << std::endl;
+}
+
+// =========================================================
+// 11. 二进制快照
+// =========================================================
+void test_snapshot() {
+    std::cout << "\n=== 11. Testing Snapshot ===" << std::endl;
+    const std::string path = "/tmp/yxy_map_snapshot.bin";
+
+    Unordered_map<int, double> m;
+    std::unordered_map<int, double> ref;
+    for (int i = 0; i < 50000; ++i) {
+        m[i * 7] = i * 0.5;
+        ref[i * 7] = i * 0.5;
+    }
+    for (int i = 0; i < 50000; i += 3) {
+        m.erase(i * 7);
+        ref.erase(i * 7);
+    }
+    m.save_snapshot(path);
+    Unordered_map<int, double> loaded;
+    loaded[1] = 1;
+    loaded.load_snapshot(path);
+    // 原样恢复: 槽位数与墓碑都不变
+    assert(loaded.bucket_count() == m.bucket_count());
+    check_map(loaded, ref, "Round trip with tombstones");
+    loaded[-1] = -1;
+    ref[-1] = -1;
+    loaded.erase(7);
+    ref.erase(7);
+    check_map(loaded, ref, "Loaded map stays writable");
+
+    // 空 / 已删除槽位写零: 删掉的值不会留在文件里
+    const std::uint64_t secret = 0x5EC12E7DA7A5EC12ULL;
+    Unordered_map<int, std::uint64_t> s;
+    for (int i = 0; i < 1000; ++i)
+        s[i] = secret;
+    for (int i = 0; i < 1000; ++i)
+        if (i % 10)
+            s.erase(i);
+    s.save_snapshot(path);
+    FILE* f = std::fopen(path.c_str(), "rb");
+    std::vector<unsigned char> bytes;
+    for (int c; (c = std::fgetc(f)) != EOF;)
+        bytes.push_back(static_cast<unsigned char>(c));
+    std::fclose(f);
+    size_t hits = 0;
+    for (size_t i = 0; i + sizeof(secret) <= bytes.size(); i += sizeof(secret))
+        hits += std::memcmp(&bytes[i], &secret, sizeof(secret)) == 0;
+    assert(hits == s.size());
+    std::cout << "PASS: Empty and erased slots written as zeros" << std::endl;
+
+    // 表头中的槽位数超过文件剩余长度: 申请内存之前就拒绝
+    f = std::fopen(path.c_str(), "r+b");
+    std::uint64_t forged = std::uint64_t(1) << 40;
+    std::fseek(f, offsetof(SnapshotHeader, capacity), SEEK_SET);
+    std::fwrite(&forged, sizeof(forged), 1, f);
+    std::fclose(f);
+    std::string what;
+    try { s.load_snapshot(path); } catch (const std::runtime_error& e) { what = e.what(); }
+    assert(what == "snapshot:: unexpected end of file!" && s.size() == 100);
+    std::cout << "PASS: Forged capacity rejected before allocating" << std::endl;
+
+    // 控制字节被改写: 全部标成满槽位 (镜像字节一致 growth_left 仍大于 0) / 非法取值
+    // 控制字节段紧跟在表头之后 按 64 字节对齐
+    const long ctrl_offset = (sizeof(SnapshotHeader) + 63) / 64 * 64;
+    std::vector<char> all_full(s.bucket_count() + 16, 0);
+    s.save_snapshot(path);
+    f = std::fopen(path.c_str(), "r+b");
+    std::fseek(f, ctrl_offset, SEEK_SET);
+    std::fwrite(all_full.data(), 1, all_full.size(), f);
+    std::fclose(f);
+    what.clear();
+    try { s.load_snapshot(path); } catch (const std::runtime_error& e) { what = e.what(); }
+    assert(what == "snapshot:: element counts do not match control bytes!" && s.size() == 100);
+    s.save_snapshot(path);
+    f = std::fopen(path.c_str(), "r+b");
+    for (long at : {ctrl_offset + 3, ctrl_offset + long(s.bucket_count()) + 3}) {
+        std::fseek(f, at, SEEK_SET);
+        std::fputc(0xF0, f);
+    }
+    std::fclose(f);
+    what.clear();
+    try { s.load_snapshot(path); } catch (const std::runtime_error& e) { what = e.what(); }
+    assert(what == "snapshot:: corrupted control bytes!" && s.size() == 100);
+    std::cout << "PASS: Corrupted control bytes rejected" << std::endl;
+
+    // 渐进式 rehash 中途保存 新旧两张表都恢复
+    Unordered_map<int, int> inc;
+    inc.set_incremental_rehash(true);
+    std::unordered_map<int, int> iref;
+    for (int i = 0; i < 1800; ++i) {
+        inc[i] = -i;
+        iref[i] = -i;
+    }
+    assert(inc.rehashing());
+    inc.save_snapshot(path);
+    Unordered_map<int, int> inc2;
+    inc2.load_snapshot(path);
+    assert(inc2.rehashing() && inc2.incremental_rehash());
+    check_map(inc2, iref, "Snapshot taken mid-rehash");
+    for (int i = 1800; i < 5000; ++i) {
+        inc2[i] = -i;
+        iref[i] = -i;
+    }
+    check_map(inc2, iref, "Migration continues after load");
+
+    Unordered_map<int, int> empty;
+    empty.save_snapshot(path);
+    inc2.load_snapshot(path);
+    assert(inc2.empty() && inc2.find(3) == inc2.end());
+    std::cout << "PASS: Empty map" << std::endl;
+
+    // 哈希函数不同: 抽查发现 原表不变
+    m.save_snapshot(path);
+    Unordered_map<int, double, std::hash<int>, std::equal_to<int>, Allocator<HashNode<int, double>>, HashMixMurmur> other;
+    other[5] = 5;
+    bool thrown = false;
+    try { other.load_snapshot(path); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown && other.size() == 1 && other.at(5) == 5);
+    // 元素类型不同
+    Unordered_map<int, float> wrong;
+    thrown = false;
+    try { wrong.load_snapshot(path); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+    std::cout << "PASS: Hash / layout mismatch rejected" << std::endl;
+    std::remove(path.c_str());
+}
+
+// =========================================================
+// 12. 扩容时抛异常
+// =========================================================
+
+// 再成功调用 calls_left 次后 下一次抛异常 (-1 表示不抛)
+static int calls_left = -1;
+
+static void countdown() {
+    if (calls_left == 0)
+        throw std::runtime_error("countdown");
+    if (calls_left > 0)
+        --calls_left;
+}
+
+struct ThrowingHash
+{
+    template<typename K>
+    size_t operator()(const K& key) const { countdown(); return std::hash<K>()(key); }
+};
+
+// 只能拷贝 (没有移动构造) 扩容时走拷贝
+struct CopyOnly
+{
+    std::string value;
+    CopyOnly(const std::string& v = "") : value(v) {}
+    CopyOnly(const CopyOnly& other) : value(other.value) { countdown(); }
+    CopyOnly& operator=(const CopyOnly&) = default;
+};
+
+template<typename Map, typename MakeKey>
+void check_resize_throw(Map& m, MakeKey make_key, const char* msg) {
+    for (int i = 0; i < 100; ++i)
+        m[make_key(i)] = make_key(i);
+    size_t capacity = m.bucket_count();
+    calls_left = 50;
+    bool thrown = false;
+    try { m.reserve(10000); } catch (const std::runtime_error&) { thrown = true; }
+    calls_left = -1;
+    assert(thrown && m.size() == 100 && m.bucket_count() == capacity);
+    for (int i = 0; i < 100; ++i)
+        assert(m.at(make_key(i)) == make_key(i));
+    size_t n = 0;
+    for (auto it = m.begin(); it != m.end(); ++it)
+        ++n;
+    assert(n == 100);
+    m.reserve(10000);
+    assert(m.size() == 100 && m.at(make_key(99)) == make_key(99));
+    std::cout << "PASS: " << msg << std::endl;
+}
+
+void test_resize_exception_safety() {
+    std::cout << "\n=== 12. Testing Exceptions During Resize ===" << std::endl;
+
+    Unordered_map<int, int, ThrowingHash> ints;
+    check_resize_throw(ints, [](int i) { return i; }, "Hash throws (trivially relocatable)");
+
+    Unordered_map<std::string, std::string, ThrowingHash> strings;
+    check_resize_throw(strings, [](int i) { return "key_" + std::to_string(i); }, "Hash throws (std::string)");
+
+    Unordered_map<int, CopyOnly> copies;
+    for (int i = 0; i < 100; ++i)
+        copies.emplace(i, CopyOnly(std::to_string(i)));
+    calls_left = 50;
+    bool thrown = false;
+    try { copies.reserve(10000); } catch (const std::runtime_error&) { thrown = true; }
+    calls_left = -1;
+    assert(thrown && copies.size() == 100);
+    for (int i = 0; i < 100; ++i)
+        assert(copies.at(i).value == std::to_string(i));
+    std::cout << "PASS: Copy throws (copy-only value)" << std::endl;
+}
+
+int main() {
+    try {
+        test_basic();
+        test_growth();
+        test_erase();
+        test_collision_and_string();
+        test_copy_move();
+        test_incremental_rehash();
+        test_batch_lookup();
+        test_mixers();
+        test_transparent_lookup();
+        test_node_handles();
+        test_snapshot();
+        test_resize_exception_safety();
+
+        std::cout << "\n===============================" << std::endl;
+        std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
+        std::cout << "===============================" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\n!!! EXCEPTION CAUGHT: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...) {
+        std::cerr << "\n!!! UNKNOWN EXCEPTION CAUGHT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
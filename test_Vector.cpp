@@ -4,6 +4,13 @@
 #include <string>
 #include <vector> 
 #include <initializer_list>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <unistd.h>
 
 // =========================================================
 // 辅助工具
@@ -177,6 +184,298 @@ void test_iterators() {
     std::cout << "PASS: Iterator Loop" << std::endl;
 }
 
+// =========================================================
+// 6. 平凡搬运测试 (memcpy/memmove 路径)
+// =========================================================
+struct Point {
+    int x, y;
+    bool operator!=(const Point& o) const { return x != o.x || y != o.y; }
+};
+
+void test_relocation() {
+    std::cout << "\n=== 6. Testing Trivial Relocation ===" << std::endl;
+    static_assert(is_trivially_relocatable<Point>::value, "POD should be trivially relocatable");
+    static_assert(!is_trivially_relocatable<std::string>::value, "std::string is not trivially copyable");
+
+    Vector<Point> v;
+    for (int i = 0; i < 1000; ++i)
+        v.push_back({i, -i});
+    v.insert(v.begin() + 500, Point{7, 7});
+    v.erase(v.begin());
+    v.erase(v.begin() + 10, v.begin() + 20);
+    assert(v.size() == 990);
+    assert(v[0].x == 1 && v[9].x == 10 && v[10].x == 21);
+    assert(v[489].x == 7 && v[490].x == 500);
+    std::cout << "PASS: POD insert / erase / regrow" << std::endl;
+
+    // 插入容器内元素的引用 (扩容 / 不扩容 两种路径)
+    Vector<std::string> vs = {"a", "b", "c"};
+    vs.insert(vs.begin(), vs[2]);
+    check_vec(vs, {std::string("c"), std::string("a"), std::string("b"), std::string("c")}, "Insert self-reference (realloc)");
+    vs.insert(vs.begin() + 1, vs[3]);
+    check_vec(vs, {std::string("c"), std::string("c"), std::string("a"), std::string("b"), std::string("c")}, "Insert self-reference (in place)");
+
+    Vector<int> vi = {1, 2, 3};
+    vi.reserve(8);
+    vi.emplace(vi.begin() + 1, vi[2]);
+    check_vec(vi, {1, 3, 2, 3}, "Emplace self-reference (memmove)");
+}
+
+// =========================================================
+// 7. 大块内存扩容 (mmap / mremap 路径)
+// =========================================================
+void test_large_growth() {
+    std::cout << "\n=== 7. Testing Large Block Growth ===" << std::endl;
+
+    Allocator<double> a;
+    size_t n = Allocator<double>::mmap_threshold / sizeof(double);
+    double* p = a.allocate(n);
+    for (size_t i = 0; i < n; ++i)
+        p[i] = static_cast<double>(i);
+    double* q = a.reallocate(p, n, n * 4);
+    if (q) {
+        for (size_t i = 0; i < n; ++i)
+            assert(q[i] == static_cast<double>(i));
+        a.deallocate(q, n * 4);
+    }
+    else
+        a.deallocate(p, n);
+    std::cout << "PASS: Allocator::reallocate keeps contents" << std::endl;
+
+    Vector<double> v;
+    for (size_t i = 0; i < 4 * n; ++i)
+        v.push_back(static_cast<double>(i));
+    for (size_t i = 0; i < v.size(); ++i)
+        assert(v[i] == static_cast<double>(i));
+    // 自引用的尾插在扩容时也要正确
+    Vector<double> w(n, 1.5);
+    w.push_back(w[0]);
+    assert(w.back() == 1.5);
+    std::cout << "PASS: Large vector regrow" << std::endl;
+}
+
+// =========================================================
+// 8. 扩容策略
+// =========================================================
+template<typename Policy>
+std::vector<size_t> capacities_after_pushes(int n) {
+    Vector<int, Allocator<int>, Policy> v;
+    std::vector<size_t> caps;
+    for (int i = 0; i < n; ++i) {
+        v.push_back(i);
+        if (caps.empty() || caps.back() != v.capacity())
+            caps.push_back(v.capacity());
+    }
+    for (int i = 0; i < n; ++i)
+        assert(v[i] == i);
+    return caps;
+}
+
+void test_growth_policy() {
+    std::cout << "\n=== 8. Testing Growth Policy ===" << std::endl;
+
+    assert((capacities_after_pushes<GrowDouble>(10) == std::vector<size_t>{1, 2, 4, 8, 16}));
+    std::cout << "PASS: GrowDouble" << std::endl;
+
+    assert((capacities_after_pushes<GrowOneAndHalf>(10) == std::vector<size_t>{1, 2, 3, 4, 6, 9, 13}));
+    std::cout << "PASS: GrowOneAndHalf" << std::endl;
+
+    assert((capacities_after_pushes<GrowFixedStep<4>>(10) == std::vector<size_t>{4, 8, 12}));
+    std::cout << "PASS: GrowFixedStep" << std::endl;
+
+    // 超过阈值后容量字节数为整页
+    size_t cap = GrowPageAligned<>::next_capacity(10000, 10001, sizeof(double));
+    assert(cap >= 20000 && cap * sizeof(double) % 4096 == 0);
+    assert(GrowPageAligned<>::next_capacity(4, 5, sizeof(double)) == 8);
+    std::cout << "PASS: GrowPageAligned" << std::endl;
+
+    // 分配器按页返回的整块都计入容量
+    Vector<char> big;
+    big.reserve(Allocator<char>::mmap_threshold + 1);
+    assert(big.capacity() % 4096 == 0);
+    std::cout << "PASS: allocate_at_least fills end_of_storage" << std::endl;
+}
+
+// =========================================================
+// 9. 区间插入 / 追加 / 赋值
+// =========================================================
+void test_range_ops() {
+    std::cout << "\n=== 9. Testing Range Insert / Append / Assign ===" << std::endl;
+
+    // 其他容器 (双向迭代器) 范围构造
+    std::list<int> l = {1, 2, 3};
+    Vector<int> v(l.begin(), l.end());
+    check_vec(v, {1, 2, 3}, "Range constructor from std::list");
+    Vector<int> fill(3, 7);
+    check_vec(fill, {7, 7, 7}, "Fill constructor still preferred for (n, value)");
+
+    // 扩容插入: 只分配一次 容量刚好按策略计算
+    std::vector<int> src = {10, 20, 30, 40};
+    auto it = v.insert(v.begin() + 1, src.begin(), src.end());
+    assert(*it == 10);
+    assert(v.capacity() == 7);
+    check_vec(v, {1, 10, 20, 30, 40, 2, 3}, "Range insert with reallocation");
+
+    // 原地插入 (memmove 路径)
+    v.reserve(20);
+    int arr[] = {-1, -2};
+    v.insert(v.begin(), arr, arr + 2);
+    check_vec(v, {-1, -2, 1, 10, 20, 30, 40, 2, 3}, "Range insert in place (pointers)");
+    v.insert(v.end(), {8, 9});
+    check_vec(v, {-1, -2, 1, 10, 20, 30, 40, 2, 3, 8, 9}, "Insert initializer_list at end");
+
+    // 单遍输入迭代器
+    std::istringstream in("4 5 6");
+    Vector<int> w = {1, 9};
+    w.insert(w.begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    check_vec(w, {1, 4, 5, 6, 9}, "Range insert from input iterator");
+
+    // 非平凡类型原地插入
+    Vector<std::string> vs = {"a", "d"};
+    vs.reserve(10);
+    std::list<std::string> mid = {"b", "c"};
+    vs.insert(vs.begin() + 1, mid.begin(), mid.end());
+    check_vec(vs, {std::string("a"), std::string("b"), std::string("c"), std::string("d")}, "Range insert std::string in place");
+
+    // 追加
+    Vector<int> a;
+    a.append_range(src);
+    a.append(l.begin(), l.end());
+    check_vec(a, {10, 20, 30, 40, 1, 2, 3}, "append / append_range");
+
+    // 赋值
+    a.assign({5, 6});
+    check_vec(a, {5, 6}, "assign initializer_list (shrinks)");
+    a.assign(10, a[0]);
+    check_vec(a, {5, 5, 5, 5, 5, 5, 5, 5, 5, 5}, "assign(n, self-reference)");
+    std::istringstream in2("1 2 3");
+    a.assign(std::istream_iterator<int>(in2), std::istream_iterator<int>());
+    check_vec(a, {1, 2, 3}, "assign from input iterator");
+    vs.assign(mid.begin(), mid.end());
+    check_vec(vs, {std::string("b"), std::string("c")}, "assign std::string");
+}
+
+// =========================================================
+// 10. resize / clear / shrink_to_fit / 默认初始化追加
+// =========================================================
+void test_resize() {
+    std::cout << "\n=== 10. Testing Resize / Clear / Shrink ===" << std::endl;
+
+    Vector<int> v = {1, 2, 3};
+    v.resize(5);
+    check_vec(v, {1, 2, 3, 0, 0}, "resize grows with value-init");
+    v.resize(2);
+    check_vec(v, {1, 2}, "resize shrinks");
+    v.resize(4, v[0]);
+    check_vec(v, {1, 2, 1, 1}, "resize(n, self-reference)");
+
+    size_t cap = v.capacity();
+    v.clear();
+    assert(v.empty() && v.capacity() == cap);
+    std::cout << "PASS: clear keeps capacity" << std::endl;
+
+    // 默认初始化: 平凡类型不写内存 随后由调用者填充
+    Vector<char> buf;
+    buf.resize_default_init(16);
+    assert(buf.size() == 16);
+    for (size_t i = 0; i < buf.size(); ++i)
+        buf[i] = static_cast<char>('a' + i);
+    char* tail = buf.append_default_init(4);
+    assert(tail == buf.data() + 16 && buf.size() == 20);
+    for (int i = 0; i < 4; ++i)
+        tail[i] = 'z';
+    assert(buf[15] == 'p' && buf[19] == 'z');
+    buf.resize_default_init(3);
+    assert(buf.size() == 3 && buf[2] == 'c');
+    std::cout << "PASS: resize_default_init / append_default_init" << std::endl;
+
+    // 非平凡类型仍然调用默认构造
+    Vector<std::string> vs = {"x"};
+    vs.resize_default_init(3);
+    check_vec(vs, {std::string("x"), std::string(""), std::string("")}, "resize_default_init std::string");
+
+    vs.reserve(100);
+    vs.shrink_to_fit();
+    assert(vs.capacity() == 3);
+    check_vec(vs, {std::string("x"), std::string(""), std::string("")}, "shrink_to_fit keeps elements");
+    vs.clear();
+    vs.shrink_to_fit();
+    assert(vs.capacity() == 0 && vs.data() == nullptr);
+    vs.push_back("again");
+    check_vec(vs, {std::string("again")}, "push_back after shrinking to zero");
+}
+
+// =========================================================
+// 11. 二进制快照
+// =========================================================
+void test_snapshot() {
+    std::cout << "\n=== 11. Testing Snapshot ===" << std::endl;
+    const std::string path = "/tmp/yxy_vector_snapshot.bin";
+
+    Vector<int> v;
+    for (int i = 0; i < 100000; ++i)
+        v.push_back(i * 3);
+    v.save_snapshot(path);
+    Vector<int> w = {7, 8};
+    w.load_snapshot(path);
+    assert(w.size() == v.size() && w.capacity() == v.size());
+    for (size_t i = 0; i < v.size(); ++i)
+        assert(w[i] == v[i]);
+    std::cout << "PASS: save / load round trip" << std::endl;
+
+    Vector<double> empty;
+    empty.save_snapshot(path);
+    Vector<double> d = {1.5};
+    d.load_snapshot(path);
+    assert(d.empty());
+    std::cout << "PASS: Empty vector" << std::endl;
+
+    // 元素类型不符 / 文件不完整: 抛异常且原内容不变
+    bool thrown = false;
+    try { w.load_snapshot(path); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown && w.size() == 100000);
+    v.save_snapshot(path);
+    FILE* f = std::fopen(path.c_str(), "r+b");
+    std::fseek(f, 0, SEEK_END);
+    long full = std::ftell(f);
+    std::fclose(f);
+    assert(truncate(path.c_str(), full - 4) == 0);
+    thrown = false;
+    Vector<int> t = {1, 2, 3};
+    try { t.load_snapshot(path); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+    check_vec(t, {1, 2, 3}, "Failed load leaves vector unchanged");
+
+    // 表头中的个数超过文件剩余长度: 申请内存之前就拒绝
+    v.save_snapshot(path);
+    f = std::fopen(path.c_str(), "r+b");
+    std::uint64_t forged = std::uint64_t(1) << 40;
+    std::fseek(f, offsetof(SnapshotHeader, count), SEEK_SET);
+    std::fwrite(&forged, sizeof(forged), 1, f);
+    std::fclose(f);
+    std::string what;
+    try { t.load_snapshot(path); } catch (const std::runtime_error& e) { what = e.what(); }
+    assert(what == "snapshot:: unexpected end of file!");
+    check_vec(t, {1, 2, 3}, "Forged element count rejected before allocating");
+
+    // 同一个流中依次保存多个容器
+    FILE* out = std::fopen(path.c_str(), "wb");
+    Vector<char> a = {'x', 'y', 'z'};
+    a.save_snapshot(out);
+    v.save_snapshot(out);
+    std::fclose(out);
+    FILE* in = std::fopen(path.c_str(), "rb");
+    Vector<char> a2;
+    Vector<int> v2;
+    a2.load_snapshot(in);
+    v2.load_snapshot(in);
+    std::fclose(in);
+    check_vec(a2, {'x', 'y', 'z'}, "Multiple snapshots in one stream (first)");
+    assert(v2.size() == v.size() && v2.back() == v.back());
+    std::cout << "PASS: Multiple snapshots in one stream (second)" << std::endl;
+    std::remove(path.c_str());
+}
+
 int main() {
     try {
         test_constructors();
@@ -184,6 +483,12 @@ int main() {
         test_erase();
         test_complex_type();
         test_iterators();
+        test_relocation();
+        test_large_growth();
+        test_growth_policy();
+        test_range_ops();
+        test_resize();
+        test_snapshot();
         
         std::cout << "\n===============================" << std::endl;
         std::cout << " ALL TESTS PASSED SUCCESSFULLY " << std::endl;
@@ -0,0 +1,277 @@
+#ifndef YXY__STL__THREAD_CACHE_ALLOCATOR_H
+#define YXY__STL__THREAD_CACHE_ALLOCATOR_H
+
+#include<new>
+#include<cstddef>
+#include<limits>
+#include<mutex>
+#include<utility>
+
+/*
+--- 线程缓存分配器 (前端: 每线程缓存 后端: 全局中心仓库)
+--- 请求按 16 字节粒度归入大小类 超过 max_block 直接走 ::operator new
+--- 每个线程每个大小类持有一个 "弹匣" (空闲链表) 分配/释放都不加锁
+--- 弹匣空了从中心仓库整批取一组块 攒太多时整批还回去 锁只在批量交换时出现
+--- 线程退出时缓存中的块全部还给中心仓库
+--- 中心仓库的 slab 在进程生命周期内不归还系统
+*/
+class ThreadCacheResource
+{
+public:
+    static constexpr std::size_t granularity = alignof(std::max_align_t);
+    static constexpr std::size_t max_block = 1024;
+    static constexpr std::size_t class_count = max_block / granularity;
+    static constexpr std::size_t slab_bytes = 256 * 1024;
+
+    static bool fits(std::size_t bytes, std::size_t align)
+    { return bytes != 0 && bytes <= max_block && align <= granularity; }
+
+    static void* allocate(std::size_t bytes)
+    {
+        ThreadCache& cache = local_cache();
+        Magazine& mag = cache.magazines[class_of(bytes)];
+        if(mag.head == nullptr)
+            depot().fetch(class_of(bytes), mag);
+        Block* b = mag.head;
+        mag.head = b->next;
+        --mag.count;
+        return b;
+    }
+
+    static void deallocate(void* p, std::size_t bytes)
+    {
+        std::size_t c = class_of(bytes);
+        ThreadCache& cache = local_cache();
+        Magazine& mag = cache.magazines[c];
+        Block* b = static_cast<Block*>(p);
+        b->next = mag.head;
+        mag.head = b;
+        // 超过两批时把一批还给中心仓库 避免单个线程囤积
+        if(++mag.count > 2 * batch_size(c))
+            depot().give_back(c, mag, batch_size(c));
+        else if(!cache.alive)
+            depot().drain(c, mag);
+    }
+
+private:
+    // 空闲块 next 串起同一批 next_batch 只在每批第一个块上使用
+    struct Block
+    {
+        Block* next;
+        Block* next_batch;
+    };
+    static_assert(sizeof(Block) <= granularity, "block too small for free list links");
+
+    struct Magazine
+    {
+        Block* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    static std::size_t class_of(std::size_t bytes)
+    { return (bytes + granularity - 1) / granularity - 1; }
+
+    static std::size_t block_size(std::size_t c)
+    { return (c + 1) * granularity; }
+
+    // 每批块数: 小块多拿 大块少拿 每批约 8 KiB
+    static std::size_t batch_size(std::size_t c)
+    {
+        std::size_t n = 8192 / block_size(c);
+        return n < 8 ? 8 : (n > 128 ? 128 : n);
+    }
+
+    // 中心仓库 每个大小类一把锁 保存若干整批空闲块
+    class Depot
+    {
+    public:
+        // 取一整批放入弹匣 (弹匣此时为空)
+        void fetch(std::size_t c, Magazine& mag)
+        {
+            std::lock_guard<std::mutex> lock(lists[c].mutex);
+            if(lists[c].batches == nullptr)
+                carve(c);
+            Block* batch = lists[c].batches;
+            lists[c].batches = batch->next_batch;
+            mag.head = batch;
+            mag.count = batch_size(c);
+        }
+
+        // 从弹匣中取出 n 个块作为一批还回
+        void give_back(std::size_t c, Magazine& mag, std::size_t n)
+        {
+            Block* first = mag.head;
+            Block* last = first;
+            for(std::size_t i = 1;i<n;++i)
+                last = last->next;
+            mag.head = last->next;
+            mag.count -= n;
+            last->next = nullptr;
+
+            std::lock_guard<std::mutex> lock(lists[c].mutex);
+            first->next_batch = lists[c].batches;
+            lists[c].batches = first;
+        }
+
+        // 线程退出 弹匣中的块全部还回
+        // 整批的直接登记 不足一批的先攒在 partial 中 攒满一批再登记
+        void drain(std::size_t c, Magazine& mag)
+        {
+            const std::size_t n = batch_size(c);
+            while(mag.count >= n)
+                give_back(c, mag, n);
+            if(mag.count == 0)
+                return;
+
+            std::lock_guard<std::mutex> lock(lists[c].mutex);
+            ClassList& list = lists[c];
+            while(mag.head)
+            {
+                Block* b = mag.head;
+                mag.head = b->next;
+                b->next = list.partial;
+                list.partial = b;
+                if(++list.partial_count == n)
+                {
+                    list.partial->next_batch = list.batches;
+                    list.batches = list.partial;
+                    list.partial = nullptr;
+                    list.partial_count = 0;
+                }
+            }
+            mag.count = 0;
+        }
+
+    private:
+        struct alignas(64) ClassList
+        {
+            std::mutex mutex;
+            Block* batches = nullptr;
+            Block* partial = nullptr;
+            std::size_t partial_count = 0;
+        };
+        ClassList lists[class_count];
+
+        // 申请一个 slab 切成若干整批挂入仓库 (调用时已持锁)
+        void carve(std::size_t c)
+        {
+            const std::size_t size = block_size(c);
+            const std::size_t n = batch_size(c);
+            const std::size_t batches = slab_bytes / (size * n) ? slab_bytes / (size * n) : 1;
+            char* mem = static_cast<char*>(::operator new(batches * n * size));
+
+            for(std::size_t k = 0;k<batches;++k)
+            {
+                char* base = mem + k * n * size;
+                for(std::size_t i = 0;i<n;++i)
+                {
+                    Block* b = reinterpret_cast<Block*>(base + i * size);
+                    b->next = i + 1 < n ? reinterpret_cast<Block*>(base + (i + 1) * size) : nullptr;
+                }
+                Block* head = reinterpret_cast<Block*>(base);
+                head->next_batch = lists[c].batches;
+                lists[c].batches = head;
+            }
+        }
+    };
+
+    struct ThreadCache
+    {
+        Magazine magazines[class_count];
+        // 析构之后 (线程退出阶段其他 thread_local 对象仍可能释放内存) 不再缓存
+        bool alive = true;
+
+        ~ThreadCache()
+        {
+            for(std::size_t c = 0;c<class_count;++c)
+                depot().drain(c, magazines[c]);
+            alive = false;
+        }
+    };
+
+    // 仓库故意不析构: 其他线程/静态对象析构时可能仍在归还内存
+    static Depot& depot()
+    {
+        static Depot* instance = new Depot();
+        return *instance;
+    }
+
+    static ThreadCache& local_cache()
+    {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+};
+
+// 线程缓存分配器 无状态 任意线程分配的内存可以在任意线程释放
+template<typename T>
+class ThreadCacheAllocator
+{
+public:
+    // --- STL 契约的类型定义 ---
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<class U>
+    struct rebind
+    {
+        using other = ThreadCacheAllocator<U>;
+    };
+
+public:
+    // --- 构造及析构 ---
+    ThreadCacheAllocator() = default;
+    ThreadCacheAllocator(const ThreadCacheAllocator&) = default;
+    template<class U>
+    ThreadCacheAllocator(const ThreadCacheAllocator<U>&) noexcept {}
+    ~ThreadCacheAllocator() = default;
+
+    pointer allocate(size_type n)
+    {
+        if(n == 0)
+            return nullptr;
+        if(n > max_size())
+            throw std::bad_alloc();
+        size_type bytes = n * sizeof(value_type);
+        if(ThreadCacheResource::fits(bytes, alignof(value_type)))
+            return static_cast<pointer>(ThreadCacheResource::allocate(bytes));
+        return static_cast<pointer>(::operator new(bytes));
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        if(p == nullptr)
+            return;
+        size_type bytes = n * sizeof(value_type);
+        if(ThreadCacheResource::fits(bytes, alignof(value_type)))
+            ThreadCacheResource::deallocate(p, bytes);
+        else
+            ::operator delete(p);
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+    template<typename U>
+    void destroy(U* p)
+    {
+        p->~U();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    friend bool operator==(const ThreadCacheAllocator&, const ThreadCacheAllocator&) { return true; }
+    friend bool operator!=(const ThreadCacheAllocator&, const ThreadCacheAllocator&) { return false; }
+};
+
+#endif // YXY__STL__THREAD_CACHE_ALLOCATOR_H
@@ -0,0 +1,267 @@
+#ifndef YXY__STL__THREAD_POOL_H
+#define YXY__STL__THREAD_POOL_H
+
+#include<atomic>
+#include<condition_variable>
+#include<cstddef>
+#include<deque>
+#include<exception>
+#include<functional>
+#include<memory>
+#include<mutex>
+#include<thread>
+#include<utility>
+#include<vector>
+
+/*
+--- 工作窃取线程池
+--- 每个工作线程一个双端队列: 自己从尾部压入/取出 (后进先出 缓存热) 空闲的线程从别人头部窃取
+--- 池外线程提交的任务进入公共注入队列
+--- ThreadPool(n) 表示 n 路并行: 创建 n-1 个工作线程 调用 TaskGroup::wait 的线程作为第 n 路
+--- wait 不阻塞而是帮忙执行任务 任务里嵌套 fork/wait 也不会死锁
+--- 队列用互斥锁保护 任务粒度 (grain) 远大于一次加锁开销时这不是瓶颈
+*/
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(std::size_t threads = default_thread_count())
+    : queues(threads > 1 ? threads - 1 : 0)
+    {
+        workers.reserve(queues.size());
+        for(std::size_t i = 0;i<queues.size();++i)
+            workers.emplace_back([this, i]() { worker_loop(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping.store(true);
+        }
+        sleep_cv.notify_all();
+        for(auto& t : workers)
+            t.join();
+    }
+
+    static std::size_t default_thread_count()
+    {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    // 进程共享的默认线程池 (硬件线程数路并行)
+    static ThreadPool& global()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // 并行路数 (工作线程数 + 1)
+    std::size_t thread_count() const
+    { return queues.size() + 1; }
+
+    // 提交任务 工作线程提交到自己的队列 其他线程提交到注入队列
+    void submit(Task task)
+    {
+        std::size_t self = current_index();
+        if(self != npos)
+        {
+            std::lock_guard<std::mutex> lock(queues[self].mutex);
+            queues[self].tasks.push_back(std::move(task));
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(inject.mutex);
+            inject.tasks.push_back(std::move(task));
+        }
+        // 与 worker_loop 中 sleeping / pending 的顺序配对 保证不会丢失唤醒
+        pending.fetch_add(1);
+        if(sleeping.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            sleep_cv.notify_one();
+        }
+    }
+
+    // 取一个任务在当前线程执行 没有可执行的任务时返回 false
+    bool run_one()
+    {
+        Task task;
+        if(!take(current_index(), task))
+            return false;
+        task();
+        return true;
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct alignas(64) WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<WorkQueue> queues;
+    WorkQueue inject;
+    std::vector<std::thread> workers;
+
+    std::atomic<std::size_t> pending{0};        // 所有队列中的任务数
+    std::atomic<std::size_t> sleeping{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+
+    // 当前线程在本池中的工作线程下标 池外线程为 npos
+    struct WorkerTag
+    {
+        const ThreadPool* pool = nullptr;
+        std::size_t index = 0;
+    };
+    static WorkerTag& worker_tag()
+    {
+        static thread_local WorkerTag tag;
+        return tag;
+    }
+    std::size_t current_index() const
+    {
+        const WorkerTag& tag = worker_tag();
+        return tag.pool == this ? tag.index : npos;
+    }
+
+    static bool pop_back(WorkQueue& q, Task& out)
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if(q.tasks.empty())
+            return false;
+        out = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    static bool pop_front(WorkQueue& q, Task& out)
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if(q.tasks.empty())
+            return false;
+        out = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        return true;
+    }
+
+    // 顺序: 自己的队列尾 -> 注入队列 -> 从 self+1 开始轮流窃取其他队列头
+    bool take(std::size_t self, Task& out)
+    {
+        if(pending.load(std::memory_order_relaxed) == 0)
+            return false;
+        bool found = (self != npos && pop_back(queues[self], out)) || pop_front(inject, out);
+        const std::size_t n = queues.size();
+        for(std::size_t k = 1;!found && k<=n;++k)
+        {
+            std::size_t victim = self == npos ? k - 1 : (self + k) % n;
+            if(victim != self)
+                found = pop_front(queues[victim], out);
+        }
+        if(found)
+            pending.fetch_sub(1);
+        return found;
+    }
+
+    void worker_loop(std::size_t index)
+    {
+        worker_tag() = WorkerTag{this, index};
+        Task task;
+        while(true)
+        {
+            if(take(index, task))
+            {
+                task();
+                task = nullptr;
+                continue;
+            }
+            // 先让出几次 新任务常常紧接着到来 避免频繁睡眠/唤醒
+            bool got = false;
+            for(int spin = 0;spin<64 && !got;++spin)
+            {
+                std::this_thread::yield();
+                got = pending.load(std::memory_order_relaxed) != 0;
+            }
+            if(got)
+                continue;
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleeping.fetch_add(1);
+            sleep_cv.wait(lock, [this]() { return stopping.load() || pending.load() != 0; });
+            sleeping.fetch_sub(1);
+            if(stopping.load() && pending.load() == 0)
+                return;
+        }
+    }
+};
+
+/*
+--- 一组 fork/join 任务: run 派生 wait 等待全部完成
+--- wait 期间当前线程从池中取任务帮忙执行
+--- 任务抛出的第一个异常在 wait 中重新抛出 其余异常被丢弃
+*/
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool& p) : pool(p) {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // 析构前必须 wait 这里兜底等待 但不再抛出异常
+    ~TaskGroup()
+    {
+        while(outstanding.load(std::memory_order_acquire) != 0)
+            if(!pool.run_one())
+                std::this_thread::yield();
+    }
+
+    template<typename F>
+    void run(F&& f)
+    {
+        outstanding.fetch_add(1, std::memory_order_relaxed);
+        pool.submit([this, fn = std::forward<F>(f)]() mutable
+        {
+            try
+            {
+                fn();
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if(!error)
+                    error = std::current_exception();
+            }
+            outstanding.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void wait()
+    {
+        while(outstanding.load(std::memory_order_acquire) != 0)
+            if(!pool.run_one())
+                std::this_thread::yield();
+        if(error)
+        {
+            std::exception_ptr e = std::move(error);
+            error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    ThreadPool& pool;
+    std::atomic<std::size_t> outstanding{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+};
+
+#endif // YXY__STL__THREAD_POOL_H